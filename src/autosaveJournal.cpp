@@ -0,0 +1,176 @@
+/*==================================== autosaveJournal.cpp ===================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Autosave Journal)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the autosave journal (see autosaveJournal.h).
+*/
+#include "autosaveJournal.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    AutosaveRecord makeRecord(AutosaveOp op, int arg, int a = 0, int b = 0, int c = 0)
+    {
+        AutosaveRecord r{};
+        r.op = (std::uint8_t)op;
+        r.arg = (std::uint8_t)arg;
+        r.a = (std::int16_t)a;
+        r.b = (std::int16_t)b;
+        r.c = (std::int16_t)c;
+        r.checksum = saveChecksum(&r, offsetof(AutosaveRecord, checksum));
+        return r;
+    }
+}
+
+std::string autosaveJournalPath(const std::string& savePath)
+{
+    return std::filesystem::path(savePath).replace_extension(AUTOSAVE_EXT).string();
+}
+
+bool diffSaveData(const SaveData& before, const SaveData& after, std::vector<AutosaveRecord>& records)
+{
+    const std::size_t start = records.size();
+
+    if (before.currentSceneIndex != after.currentSceneIndex || before.activeEncounterID != after.activeEncounterID ||
+        before.savedPlayerSceneIndex != after.savedPlayerSceneIndex)
+        records.push_back(makeRecord(AutosaveOp::Scene, 0, after.currentSceneIndex, after.activeEncounterID, after.savedPlayerSceneIndex));
+
+    for (std::size_t id = 1; id < ITEM_COUNT; ++id)
+        if (((after.collectedItems & ~before.collectedItems) >> id) & 1)
+            records.push_back(makeRecord(AutosaveOp::ItemCollected, (int)id));
+
+    for (int id = 0; id < SAVE_MAX_ENCOUNTERS; ++id)
+    {
+        bool fought = (after.battlesFought >> id) & 1, won = (after.battlesWon >> id) & 1;
+        if (fought && (!((before.battlesFought >> id) & 1) || won != (((before.battlesWon >> id) & 1) != 0)))
+            records.push_back(makeRecord(AutosaveOp::BattleResult, id, won));
+    }
+
+    if (before.health != after.health || before.maxHealth != after.maxHealth)
+        records.push_back(makeRecord(AutosaveOp::PlayerVitals, 0, after.health, after.maxHealth));
+    if (before.meleeWeapon != after.meleeWeapon || before.rangeWeapon != after.rangeWeapon)
+        records.push_back(makeRecord(AutosaveOp::Weapons, 0, after.meleeWeapon, after.rangeWeapon));
+    if (before.zombiesDefeated != after.zombiesDefeated)
+        records.push_back(makeRecord(AutosaveOp::ZombiesDefeated, after.zombiesDefeated));
+
+    for (int i = 0; i < after.itemCount && i < SAVE_MAX_ITEMS; ++i)
+        if (i >= before.itemCount || std::memcmp(&before.items[i], &after.items[i], sizeof(SaveItem)) != 0)
+            records.push_back(makeRecord(AutosaveOp::InventorySlot, i, after.items[i].id, after.items[i].quantity, after.items[i].healAmount));
+    if (before.itemCount != after.itemCount)
+        records.push_back(makeRecord(AutosaveOp::InventoryCount, after.itemCount));
+
+    if (before.enemyHealth != after.enemyHealth || before.enemyMaxHealth != after.enemyMaxHealth)
+        records.push_back(makeRecord(AutosaveOp::EnemyVitals, 0, after.enemyHealth, after.enemyMaxHealth));
+
+    // anything the records cant say (cleared items/battles, other stats, another character) needs a full save
+    SaveData check = before;
+    for (std::size_t i = start; i < records.size(); ++i) applyAutosaveRecord(check, records[i]);
+    if (std::memcmp(&check, &after, sizeof(SaveData)) != 0)
+    {
+        records.resize(start);
+        return false;
+    }
+    return true;
+}
+
+bool applyAutosaveRecord(SaveData& data, const AutosaveRecord& r)
+{
+    if (saveChecksum(&r, offsetof(AutosaveRecord, checksum)) != r.checksum) return false;
+
+    switch ((AutosaveOp)r.op)
+    {
+        case AutosaveOp::Scene:
+            data.currentSceneIndex = r.a;
+            data.activeEncounterID = r.b;
+            data.savedPlayerSceneIndex = r.c;
+            return true;
+        case AutosaveOp::ItemCollected:
+            if (r.arg == 0 || r.arg >= ITEM_COUNT) return false;
+            data.collectedItems |= 1u << r.arg;
+            return true;
+        case AutosaveOp::BattleResult:
+            if (r.arg >= SAVE_MAX_ENCOUNTERS) return false;
+            data.battlesFought |= 1u << r.arg;
+            if (r.a) data.battlesWon |= 1u << r.arg;
+            else data.battlesWon &= ~(1u << r.arg);
+            return true;
+        case AutosaveOp::PlayerVitals:
+            data.health = (std::int8_t)r.a;
+            data.maxHealth = (std::int8_t)r.b;
+            return true;
+        case AutosaveOp::Weapons:
+            data.meleeWeapon = (std::uint8_t)r.a;
+            data.rangeWeapon = (std::uint8_t)r.b;
+            return true;
+        case AutosaveOp::ZombiesDefeated:
+            data.zombiesDefeated = r.arg;
+            return true;
+        case AutosaveOp::InventorySlot:
+            if (r.arg >= SAVE_MAX_ITEMS) return false;
+            data.items[r.arg] = {(std::uint8_t)r.a, (std::uint8_t)r.b, (std::uint8_t)r.c};
+            return true;
+        case AutosaveOp::InventoryCount:
+            if (r.arg > SAVE_MAX_ITEMS) return false;
+            // slots past the count are zeroed so the folded save matches a fresh one byte for byte
+            for (int i = r.arg; i < SAVE_MAX_ITEMS; ++i) data.items[i] = SaveItem{};
+            data.itemCount = r.arg;
+            return true;
+        case AutosaveOp::EnemyVitals:
+            data.enemyHealth = (std::int8_t)r.a;
+            data.enemyMaxHealth = (std::int8_t)r.b;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool resetAutosaveJournal(const std::string& path, std::uint32_t baseChecksum)
+{
+    AutosaveHeader header{};
+    std::memcpy(header.magic, AUTOSAVE_MAGIC, 4);
+    header.version = AUTOSAVE_VERSION;
+    header.recordSize = sizeof(AutosaveRecord);
+    header.baseChecksum = baseChecksum;
+    return writeFileAtomic(path, &header, sizeof(header));
+}
+
+bool appendAutosaveRecords(const std::string& path, const AutosaveRecord* records, std::size_t count)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (!out.is_open()) return false;
+    out.write(reinterpret_cast<const char*>(records), (std::streamsize)(count * sizeof(AutosaveRecord)));
+    return static_cast<bool>(out);
+}
+
+int replayAutosaveJournal(const std::string& path, SaveData& data)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return 0;
+
+    AutosaveHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (in.gcount() != (std::streamsize)sizeof(header) || std::memcmp(header.magic, AUTOSAVE_MAGIC, 4) != 0 ||
+        header.version != AUTOSAVE_VERSION || header.recordSize != sizeof(AutosaveRecord))
+        return 0;
+    if (header.baseChecksum != saveChecksum(&data, sizeof(SaveData))) return 0; // journal of an older save
+
+    // the whole tail in one read, then replay in memory
+    std::vector<AutosaveRecord> records;
+    in.seekg(0, std::ios::end);
+    std::streamoff tail = (std::streamoff)in.tellg() - (std::streamoff)sizeof(header);
+    if (tail <= 0) return 0;
+    records.resize((std::size_t)tail / sizeof(AutosaveRecord)); // a torn last record is cut off here
+    in.seekg(sizeof(header));
+    in.read(reinterpret_cast<char*>(records.data()), (std::streamsize)(records.size() * sizeof(AutosaveRecord)));
+    if (!in) return 0;
+
+    int applied = 0;
+    for (const AutosaveRecord& r : records)
+    {
+        if (!applyAutosaveRecord(data, r)) break; // everything after a bad record is suspect
+        ++applied;
+    }
+    return applied;
+}
@@ -0,0 +1,104 @@
+/*===================================== autosaveJournal.h ====================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Autosave Journal)
+  Primary Author: Edwin Baiden
+  Description: Autosaves are small records appended to a journal next to the binary save,
+               instead of rewriting the whole save every time. Each record is one change (scene,
+               item collected, battle result, player HP, inventory slot, enemy HP, ...), 12 bytes
+               on disk with its own checksum, so a record torn by a crash is just dropped.
+
+               The journal header stores the checksum of the save it applies to. Loading reads the
+               save, then replays the journal on top of it only if that checksum matches (a journal
+               left over from an older save is ignored). Once the journal gets big the SaveService
+               folds it into a fresh save and starts an empty journal (compaction).
+
+               File layout (little endian, packed):
+                    AutosaveHeader | AutosaveRecord[...]
+
+               Header and records are written straight from memory like the save they apply to,
+               so the byte order on disk is the CPU's. saveData.h (included below) refuses to
+               build on a big endian CPU, which is what keeps journals little endian.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "saveData.h" // SaveData, and the little endian build check the journal relies on
+
+//=============== HEADER GUARD ===============
+#ifndef AUTOSAVEJOURNAL_H
+#define AUTOSAVEJOURNAL_H
+
+#define AUTOSAVE_MAGIC "TLLA"          // First 4 bytes of every autosave journal
+#define AUTOSAVE_VERSION 1             // Bump when AutosaveRecord changes
+#define AUTOSAVE_EXT ".journal"        // Journal lives next to the save (savegame.tls -> savegame.journal)
+#define AUTOSAVE_COMPACT_BYTES 4096    // Journal size that triggers folding it into a fresh save
+
+//@brief: What an autosave record changes
+//@version: 1.0
+//@author: Edwin Baiden
+enum class AutosaveOp : std::uint8_t
+{
+    Scene,          // a = currentSceneIndex, b = activeEncounterID, c = savedPlayerSceneIndex
+    ItemCollected,  // arg = ItemID
+    BattleResult,   // arg = encounter ID, a = won
+    PlayerVitals,   // a = health, b = maxHealth
+    Weapons,        // a = meleeWeapon, b = rangeWeapon
+    ZombiesDefeated,// arg = SaveData::zombiesDefeated bits
+    InventorySlot,  // arg = slot, a = ItemID, b = quantity, c = healAmount
+    InventoryCount, // arg = itemCount
+    EnemyVitals,    // a = enemyHealth, b = enemyMaxHealth
+    Count
+};
+
+#pragma pack(push, 1)
+//@brief: One autosave change, 12 bytes on disk
+//@version: 1.0
+//@author: Edwin Baiden
+struct AutosaveRecord
+{
+    std::uint8_t op;          // AutosaveOp
+    std::uint8_t arg;
+    std::int16_t a;
+    std::int16_t b;
+    std::int16_t c;
+    std::uint32_t checksum;   // saveChecksum() of the 8 bytes above
+};
+
+//@brief: Header at the start of every autosave journal
+//@version: 1.0
+//@author: Edwin Baiden
+struct AutosaveHeader
+{
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t recordSize;  // sizeof(AutosaveRecord)
+    std::uint32_t baseChecksum;// saveChecksum() of the SaveData this journal applies to
+};
+#pragma pack(pop)
+
+//@brief: Journal path for a save path (same name, AUTOSAVE_EXT)
+std::string autosaveJournalPath(const std::string& savePath);
+
+//@brief: Builds the records that turn before into after
+//@param records - Records are appended here
+//@return - False if the change cant be written as records (new game, different character...), save the whole thing instead
+bool diffSaveData(const SaveData& before, const SaveData& after, std::vector<AutosaveRecord>& records);
+
+//@brief: Applies one record to a save
+//@return - False if the record is corrupt or unknown (it is not applied)
+bool applyAutosaveRecord(SaveData& data, const AutosaveRecord& record);
+
+//@brief: Starts an empty journal for the save with this checksum (written to a temp file and renamed over the old one)
+bool resetAutosaveJournal(const std::string& path, std::uint32_t baseChecksum);
+
+//@brief: Appends records to the journal (no fsync, a torn record fails its checksum on load)
+bool appendAutosaveRecords(const std::string& path, const AutosaveRecord* records, std::size_t count);
+
+//@brief: Replays the journal on top of data if it was written for it, stops at the first bad record
+//@return - Number of records applied (0 if there is no journal or it belongs to another save)
+int replayAutosaveJournal(const std::string& path, SaveData& data);
+
+#endif // AUTOSAVEJOURNAL_H
@@ -0,0 +1,245 @@
+/*======================================= benchCore.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: Engine Core (Benchmarks)
+  Primary Author: Sebastian Cardona
+  Description: Micro benchmarks for the engine core (dice, damage, combat resolution, combat
+               log, enemy AI, stat table lookup, character creation, entity pool, inventory and save/load). Built
+               and run with "make bench", no window is opened.
+
+               Every benchmark is calibrated so one repetition takes at least BENCH_MIN_REP_NS,
+               then it runs BENCH_WARMUP_REPS untimed repetitions and BENCH_REPETITIONS timed ones.
+               We report the median and p99 of the per-op time across repetitions and the cycles
+               per op from the time stamp counter (x86 only, null elsewhere).
+
+               Results go to a JSON file so runs on different commits can be compared:
+                    ./BenchCore [--out file.json] [--rev <git revision>] [--filter <substring>]
+
+               saveProgress/LoadProgress use a file in the system temp directory (BENCH_SAVE_FILE),
+               the player's own save is never touched. Info log lines are turned off, otherwise
+               CreateCharacter and LoadProgress would mostly time writing to stderr.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BENCH_HAS_TSC 1
+#else
+    #define BENCH_HAS_TSC 0
+#endif
+
+#include "json.hpp"
+#include "characters.h"
+#include "combat.h"
+#include "entityPool.h"
+#include "progressLog.h"
+#include "rng.h"
+
+#define BENCH_WARMUP_REPS 5            // Untimed repetitions before measuring (caches, branch predictors, allocator)
+#define BENCH_REPETITIONS 101          // Timed repetitions (odd so the median is a real sample)
+#define BENCH_MIN_REP_NS 1000000.0     // Calibrate each repetition to at least 1 ms
+#define BENCH_SAVE_FILE "tll_bench_save.tls" // Save/load benchmark file, in the system temp directory
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using json = nlohmann::json;
+
+    //@brief: Stops the compiler from optimizing away a result we never read
+    template <typename T>
+    inline void keep(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline std::uint64_t readCycles()
+    {
+    #if BENCH_HAS_TSC
+        return __rdtsc();
+    #else
+        return 0;
+    #endif
+    }
+
+    struct BenchResult
+    {
+        std::string name;
+        std::size_t opsPerRep = 0;
+        double medianNs = 0.0;
+        double p99Ns = 0.0;
+        double minNs = 0.0;
+        double cyclesPerOp = -1.0; // -1 = no cycle counter
+    };
+
+    //@brief: Runs op() in calibrated batches and collects per-op timings
+    BenchResult runBench(const std::string& name, const std::function<void()>& op)
+    {
+        // find a batch size where one repetition takes long enough to time reliably
+        std::size_t ops = 1;
+        for (;;)
+        {
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < ops; ++i) op();
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            if (ns >= BENCH_MIN_REP_NS || ops >= (1u << 26)) break;
+            ops = ns < BENCH_MIN_REP_NS / 64.0 ? ops * 16 : ops * 2;
+        }
+
+        for (int r = 0; r < BENCH_WARMUP_REPS; ++r)
+            for (std::size_t i = 0; i < ops; ++i) op();
+
+        std::vector<double> nsPerOp;
+        nsPerOp.reserve(BENCH_REPETITIONS);
+        std::uint64_t totalCycles = 0;
+        for (int r = 0; r < BENCH_REPETITIONS; ++r)
+        {
+            std::uint64_t c0 = readCycles();
+            auto start = Clock::now();
+            for (std::size_t i = 0; i < ops; ++i) op();
+            auto end = Clock::now();
+            totalCycles += readCycles() - c0;
+            nsPerOp.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+        }
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+
+        BenchResult res;
+        res.name = name;
+        res.opsPerRep = ops;
+        res.medianNs = nsPerOp[nsPerOp.size() / 2];
+        res.p99Ns = nsPerOp[std::min(nsPerOp.size() - 1, (nsPerOp.size() * 99) / 100)];
+        res.minNs = nsPerOp.front();
+        if (BENCH_HAS_TSC) res.cyclesPerOp = (double)totalCycles / ((double)ops * BENCH_REPETITIONS);
+        return res;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string outPath = "bench_results.json";
+    std::string revision = "unknown";
+    std::string filter;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+        else if (std::strcmp(argv[i], "--rev") == 0 && i + 1 < argc) revision = argv[++i];
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+    }
+    // the output path is relative to where bench was started, the game code moves the cwd to the executable
+    outPath = std::filesystem::absolute(outPath).string();
+
+    seed_rng(12345); // same dice every run so results are comparable
+    platformSetLogLevel(PLATFORM_LOG_WARNING); // CreateCharacter logs every character it makes
+
+    // Same setup the game does: stat table, a player and a zombie
+    StatTable allStats; // built in stats, no file I/O
+    EntityPool pool;
+    Character* entities[2] = {nullptr, nullptr};
+    CreateCharacter(pool, entities, allStats, "Student", "Bench");
+    CreateCharacter(pool, entities, allStats, "Zombie_Standard", "Zombie");
+    if (!entities[0] || !entities[1])
+    {
+        std::cerr << "could not create the benchmark characters\n";
+        return 1;
+    }
+    Character& player = *entities[0];
+    Character& zombie = *entities[1];
+
+    std::vector<std::string> fullLog(50, "Zombie takes 7 damage."); // AddNewLogEntry keeps 50 entries
+    std::vector<std::string> log = fullLog;
+
+    std::map<int, bool> battleWon{{0, true}, {1, false}, {2, false}};
+    ItemSet collectedItems;
+    collectedItems.set((std::size_t)ItemID::HealthPotion).set((std::size_t)ItemID::Key1);
+
+    // the save/load benchmarks get their own file (absolute, saveProgress moves the cwd to the executable)
+    std::error_code tempError;
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path(tempError);
+    if (tempError) tempDir = std::filesystem::absolute(".");
+    const std::string benchSavePath = (tempDir / BENCH_SAVE_FILE).string();
+
+    std::vector<std::pair<std::string, std::function<void()>>> benches = {
+        {"roll_d20", [] { keep(roll_d(20)); }},
+        {"dealMeleeDamage", [&] { zombie.vit.health = zombie.vit.maxHealth; keep(player.dealMeleeDamage(zombie)); }},
+        {"dealRangeDamage", [&] { zombie.vit.health = zombie.vit.maxHealth; keep(player.dealRangeDamage(zombie)); }},
+        {"resolve_melee", [&] { zombie.vit.health = zombie.vit.maxHealth; keep(resolve_melee(player, zombie, false, log)); }},
+        {"resolve_ranged", [&] { zombie.vit.health = zombie.vit.maxHealth; keep(resolve_ranged(player, zombie, false, log)); }},
+        {"AddNewLogEntry_full", [&] { AddNewLogEntry(log, "Zombie takes 7 damage."); }},
+        {"ai_choose", [&] {
+            keep(ai_choose(static_cast<const NonPlayerCharacter&>(zombie), *asPlayer(&player)).type);
+        }},
+        {"StatTable_row", [&] { keep(allStats.row("Zombie_Standard").get(CSVStats::INITIATIVE)); }},
+        {"CreateCharacter", [&] {
+            EntityHandle h = CreateCharacter(pool, nullptr, allStats, "Student", "Bench");
+            keep(h.index);
+            pool.despawn(h);
+        }},
+        {"EntityPool_spawn_despawn", [&] {
+            EntityHandle h = pool.spawn<Zombie>(zombie.att, zombie.def, zombie.cbt, zombie.vit, zombie.statEff);
+            keep(pool.get(h));
+            pool.despawn(h);
+        }},
+        {"inventory_add_remove", [&] {
+            inventory& inv = asPlayer(&player)->inv;
+            inv.additem(HealthPotion(20)); // different heal amount so it gets its own slot
+            keep(inv.removeitem(ItemID::HealthPotion, 1));
+        }},
+        {"saveProgress", [&] { keep(saveProgress(entities, 3, -1, 3, battleWon, collectedItems, benchSavePath)); }},
+        {"LoadProgress", [&] {
+            EntityPool loadPool;
+            Character* ent[2] = {nullptr, nullptr};
+            int scene = 0, encounter = 0, savedScene = 0;
+            std::map<int, bool> won;
+            ItemSet items;
+            keep(LoadProgress(loadPool, ent, allStats, scene, encounter, savedScene, won, items, benchSavePath));
+        }},
+    };
+
+    json out;
+    out["revision"] = revision;
+    out["warmupReps"] = BENCH_WARMUP_REPS;
+    out["repetitions"] = BENCH_REPETITIONS;
+    out["cycleCounter"] = BENCH_HAS_TSC ? "rdtsc" : "none";
+    out["results"] = json::array();
+
+    std::printf("%-24s %12s %12s %12s %10s\n", "benchmark", "median ns", "p99 ns", "cycles/op", "ops/rep");
+    for (auto& [name, op] : benches)
+    {
+        if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+        log = fullLog;
+        BenchResult r = runBench(name, op);
+        std::printf("%-24s %12.1f %12.1f %12.1f %10zu\n", r.name.c_str(), r.medianNs, r.p99Ns, r.cyclesPerOp, r.opsPerRep);
+
+        json j;
+        j["name"] = r.name;
+        j["medianNs"] = r.medianNs;
+        j["p99Ns"] = r.p99Ns;
+        j["minNs"] = r.minNs;
+        j["cyclesPerOp"] = r.cyclesPerOp >= 0.0 ? json(r.cyclesPerOp) : json(nullptr);
+        j["opsPerRep"] = r.opsPerRep;
+        out["results"].push_back(j);
+    }
+
+    // remove the benchmark save (a failed write removes its own temp file)
+    std::error_code ec;
+    std::filesystem::remove(benchSavePath, ec);
+
+    pool.clear();
+
+    std::ofstream outFile(outPath);
+    if (!outFile.is_open())
+    {
+        std::cerr << "could not write " << outPath << "\n";
+        return 1;
+    }
+    outFile << out.dump(4) << "\n";
+    std::cout << "results written to " << outPath << "\n";
+    return 0;
+}
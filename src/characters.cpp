@@ -4,116 +4,134 @@
 */
 
 #include "characters.h"
+#include "entityPool.h"
+#include <cstring>
 
 /**
- * @brief Loads starting character stats from character CSV file to be read by storeAllStatsLines()
- * @return StartingStatFile - string stream to be fed into storeAllStatsLines()
+ * @brief Replaces the compiled in stats with an override CSV (for balancing without rebuilding). The override is
+ *        only used when its header hashes to STATS_SCHEMA_HASH, so a CSV with different columns cant be misread.
+ * @param path - override CSV, same format as Character_Starting_Stats.csv
+ * @return true if the override was loaded, false if there is none or it was rejected (built in stats stay in use)
  */
-std::ifstream* openStartingStatsCSV()
+bool StatTable::loadOverride(const std::string& path)
 {
-    //Using filesystem to get path of the CSV relative to the executable
-    ChangeDirectory(GetApplicationDirectory());
-    std::ifstream* StartingStatFile = new std::ifstream("../dat/Character_Starting_Stats.csv");
-    //std::ifstream* StartingStatFile = new std::ifstream("dat/Character_Starting_Stats.csv"); // In the form: ID,Strength,Dexterity,Constitution,Wisdom,Charisma,Intelligence,Max_Health,Armor,Initiative
-    if (!StartingStatFile->is_open()) 
+    platformEnterAppDirectory();
+    std::ifstream file(path);
+    if (!file.is_open()) return false; // no override, thats the normal case
+
+    std::string line;
+    std::getline(file, line);
+    if (statSchemaHash(line) != STATS_SCHEMA_HASH)
+    {
+        platformLog(PLATFORM_LOG_WARNING, "Ignoring stat override %s: columns dont match the built in stats", path.c_str());
+        return false;
+    }
+
+    std::vector<StatRow> rows;
+    while (std::getline(file, line))
     {
-        std::cerr << "Error: Could not open the character starting stats file." << std::endl;
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // CSV saved on Windows
+        if (line.empty()) continue;
+
+        std::istringstream lineStream(line);
+        std::string cell;
+        StatRow row;
+        std::getline(lineStream, cell, ',');
+        std::strncpy(row.id, cell.c_str(), STAT_ID_MAX - 1);
+        for (int col = 0; col < STAT_COLUMNS && std::getline(lineStream, cell, ','); ++col)
+            row.values[col] = (std::int8_t)std::atoi(cell.c_str());
+        rows.push_back(row);
     }
 
-    return StartingStatFile;
+    std::sort(rows.begin(), rows.end(), [](const StatRow& a, const StatRow& b) { return std::strcmp(a.id, b.id) < 0; });
+    overrideRows = std::move(rows);
+    view = StatView{overrideRows.data(), overrideRows.size()};
+    platformLog(PLATFORM_LOG_INFO, "Loaded %d stat rows from override %s", (int)overrideRows.size(), path.c_str());
+    return true;
 }
 
 /**
- * @brief Stores character starting starts from openStartingStatsCSV()
- * @param StartingStatFile - comes from openStartingStatsCSV(), carries character starting data
- * @return a new pointer
+ * @brief Spawns a character from its starting stats in the entity pool, players go in entities[0] and enemies in entities[1]
+ * @param pool - session entity pool that owns the character
+ * @param entities - the player/enemy array (the character already in that slot is despawned), or nullptr
+ * @param stats - starting stats table
+ * @param ID - character ID in the stats table (also picks the archetype)
+ * @param name - player name (NPCs use their archetype name)
+ * @return handle to the new character
  */
-std::istringstream* storeAllStatLines(std::ifstream* StartingStatFile)
-{
-    if (!StartingStatFile) return nullptr;
-    std::string allLines;
-    std::string line;
-    int count = 1;
+EntityHandle CreateCharacter(EntityPool& pool, Character** entities, const StatTable& stats, const std::string& ID, const std::string& name) {
+    platformLog(PLATFORM_LOG_INFO, "Creating character: %s with ID: %s", name.c_str(), ID.c_str());
+    const StatRow& row = stats.row(ID);
+    if (row.id[0] == '\0') {
+        platformLog(PLATFORM_LOG_ERROR, "No starting stats for ID: %s", ID.c_str());
+    }
+    Attributes CharAttrs = {
+        row.get(CSVStats::STR),
+        row.get(CSVStats::DEX),
+        row.get(CSVStats::CON),
+        row.get(CSVStats::WIS),
+        row.get(CSVStats::CHA),
+        row.get(CSVStats::INT)
+    };
 
-    while (std::getline(*StartingStatFile, line)) 
+    DefenseStats CharDef = {row.get(CSVStats::ARMOR), 0};
+    CombatStats CharCbt = {0, 0, row.get(CSVStats::INITIATIVE)};
+    VitalStats CharVit = {
+        row.get(CSVStats::MAX_HEALTH),
+        row.get(CSVStats::MAX_HEALTH)
+    };
+    StatusEffects CharStatus = {};
+
+    // players go in slot 0, anything that isnt a player archetype is a Zombie in slot 1
+    EntityHandle handle;
+    switch (archetypeFromID(ID))
     {
-        if (count != 1) 
-        {
-            allLines += line + "\n";
-        }
-        count++;
+        case Archetype::Student: handle = pool.spawn<Student>(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus); break;
+        case Archetype::Rat: handle = pool.spawn<Rat>(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus); break;
+        case Archetype::Professor: handle = pool.spawn<Professor>(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus); break;
+        case Archetype::Atilla: handle = pool.spawn<Atilla>(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus); break;
+        default: handle = pool.spawn<Zombie>(CharAttrs, CharDef, CharCbt, CharVit, CharStatus); break;
     }
 
-    StartingStatFile->close();
-    delete StartingStatFile;
-    StartingStatFile = nullptr;
-
-    return new std::istringstream(allLines);
+    if (entities) {
+        Character* spawned = pool.get(handle);
+        int slot = spawned->isPlayer ? 0 : 1;
+        pool.despawn(entities[slot]); // no-op if the slot was empty
+        entities[slot] = spawned;
+    }
+    return handle;
 }
-
 /**
- * @brief 
- * @param allLines - string stream from storeAllStatLines()
- * @param characterID - name of the character ie student
- * @param stat - stat value index
- * @return stoi(cell) - is the value of the desired stat
- * @return -128 - error value
+ * @brief End of round status effect pass for a whole batch of characters. Damage/heal over time is worked out
+ *        from the active bits in one go, then every timed effect loses a round and the expired ones are cleared
+ *        with a single mask (DEFENDING and other duration 0 effects are left alone).
+ * @param chars - characters to tick (usually the player and the enemy)
+ * @param count - number of characters in chars
+ * @param hpChange - optional, receives the HP change of each character (negative = damage), count entries
  */
-std::int8_t getStatForCharacterID(std::istringstream* allLines, std::string characterID, CSVStats stat)
+void tickStatusEffects(Character* const* chars, std::size_t count, int* hpChange)
 {
-    std::string line;
-    std::string currentID;
-    allLines->clear();
-    allLines->seekg(0,std::ios::beg);
-    while (std::getline(*allLines, line)) 
+    for (std::size_t i = 0; i < count; ++i)
     {
-        std::istringstream lineStream(line);
-        std::string cell;
-        std::getline(lineStream, cell, ',');
-        currentID = cell;
+        Character& c = *chars[i];
+        StatusEffects& eff = c.statEff;
+        int before = c.vit.health;
 
-        if (currentID == characterID) 
+        if (eff.active != 0 && c.isAlive())
         {
-            int currentStatIndex = 0;
-            while (std::getline(lineStream, cell, ',')) 
+            int delta = eff.modifier(SE_REGENERATING) - eff.modifier(SE_POISONED) - eff.modifier(SE_BURNING);
+            c.vit.health = (std::int8_t)std::clamp(before + delta, 0, (int)c.vit.maxHealth);
+
+            std::uint8_t expired = 0;
+            for (std::uint8_t bits = eff.active; bits != 0; bits &= (std::uint8_t)(bits - 1))
             {
-                currentStatIndex++;
-                if (currentStatIndex == static_cast<int>(stat)) 
-                {
-                    return stoi(cell);
-                }
+                int id = __builtin_ctz(bits);
+                if (eff.duration[id] != 0 && --eff.duration[id] == 0)
+                    expired |= (std::uint8_t)(1u << id);
             }
+            eff.active &= (std::uint8_t)~expired;
         }
-    }
-    return -128; // Return -128 if character ID or stat not found
-}
 
-void CreateCharacter(Character**& entities, std::istringstream* statlines, std::string ID, std::string name) {
-    TraceLog(LOG_INFO, "Creating character: %s with ID: %s", name.c_str(), ID.c_str());
-    if (!statlines) {
-        TraceLog(LOG_ERROR, "statlines is null!");
-        return;
+        if (hpChange) hpChange[i] = c.vit.health - before;
     }
-    Attributes CharAttrs = {
-        getStatForCharacterID(statlines, ID, CSVStats::STR),
-        getStatForCharacterID(statlines, ID, CSVStats::DEX),
-        getStatForCharacterID(statlines, ID, CSVStats::CON),
-        getStatForCharacterID(statlines, ID, CSVStats::WIS),
-        getStatForCharacterID(statlines, ID, CSVStats::CHA),
-        getStatForCharacterID(statlines, ID, CSVStats::INT)
-    };
-
-    DefenseStats CharDef = {getStatForCharacterID(statlines, ID, CSVStats::ARMOR), 0};
-    CombatStats CharCbt = {0, 0, getStatForCharacterID(statlines, ID, CSVStats::INITIATIVE)};
-    VitalStats CharVit = {
-        getStatForCharacterID(statlines, ID, CSVStats::MAX_HEALTH),
-        getStatForCharacterID(statlines, ID, CSVStats::MAX_HEALTH)
-    };
-    StatusEffects CharStatus = {};
-
-    if (ID == "Student") entities[0] = new Student(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus);
-    else if (ID == "Rat") entities[0] = new Rat(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus);
-    else if (ID == "Professor") entities[0] = new Professor(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus);
-    else if (ID == "Attila") entities[0] = new Atilla(name, CharAttrs, CharDef, CharCbt, CharVit, CharStatus);
-    else entities[1] = new Zombie(CharAttrs, CharDef, CharCbt, CharVit, CharStatus);
-}
\ No newline at end of file
+}
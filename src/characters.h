@@ -18,12 +18,71 @@
 #include <fstream>
 #include <sstream>
 #include <cstdint>
+#include <algorithm>
+#include <string_view>
 #include "rng.h"
-#include "raylib.h"
+#include "itemRegistry.h"
+#include "statSchema.h"
+#include "startingStats.gen.h"
+#include "platform.h"  // logging and the executable directory (the core does not use raylib)
 #ifndef CHARACTERS_H
 #define CHARACTERS_H
 
-enum CSVStats {STR=1, DEX, CON, WIS, CHA, INT, MAX_HEALTH, ARMOR, INITIATIVE};
+#define STATS_OVERRIDE_PATH "../dat/Character_Starting_Stats.override.csv" // optional, relative to the executable
+#define STATS_CSV_RUNTIME_PATH "../dat/Character_Starting_Stats.csv" // read at runtime only by hot reload
+
+static_assert(STATS_SCHEMA_HASH == statSchemaHash(STATS_CSV_HEADER),
+              "Character_Starting_Stats.csv columns dont match CSVStats (update statSchema.h)");
+
+inline constexpr StatRow MISSING_STAT_ROW{}; // every stat is STAT_MISSING
+
+// Read only view over sorted stat rows. Everything is constexpr so lookups with an ID known at
+// compile time fold to a constant, e.g. BUILTIN_STATS.row("Student").get(MAX_HEALTH).
+struct StatView
+{
+    const StatRow* rows = nullptr;
+    std::size_t count = 0;
+
+    constexpr const StatRow* find(std::string_view id) const // binary search, nullptr if the ID is not there
+    {
+        std::size_t lo = 0, hi = count;
+        while (lo < hi)
+        {
+            std::size_t mid = (lo + hi) / 2;
+            int cmp = std::string_view(rows[mid].id).compare(id);
+            if (cmp == 0) return &rows[mid];
+            if (cmp < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return nullptr;
+    }
+
+    constexpr const StatRow& row(std::string_view id) const // Row for the ID, or MISSING_STAT_ROW
+    {
+        const StatRow* r = find(id);
+        return r ? *r : MISSING_STAT_ROW;
+    }
+};
+
+// Stats generated from the CSV at build time (startingStats.gen.h)
+inline constexpr StatView BUILTIN_STATS{GENERATED_STAT_ROWS, STATS_ROW_COUNT};
+
+// Starting stats the game uses. Starts out pointing at the compiled in table (no file I/O, no
+// allocation); loadOverride() can swap in rows from an override CSV with the same columns.
+class StatTable
+{
+    public:
+        bool loadOverride(const std::string& path); // Use the override CSV if it exists and its schema hash matches
+        const StatRow* find(std::string_view id) const { return view.find(id); }
+        const StatRow& row(std::string_view id) const { return view.row(id); }
+        std::size_t size() const { return view.count; }
+        bool isOverridden() const { return !overrideRows.empty(); }
+        void useBuiltin() { overrideRows.clear(); view = BUILTIN_STATS; } // Drop any override and go back to the compiled in rows
+
+    private:
+        StatView view = BUILTIN_STATS;
+        std::vector<StatRow> overrideRows; // sorted by id, only used when an override is loaded
+};
 
 // For stats contained in the Character_Starting_Stats.csv file, do not initialize
 // Structure to hold character attributes
@@ -64,28 +123,75 @@ struct VitalStats {
     std::int8_t maxHealth = 0;
 };
 
+#define DEFEND_ARMOR_BONUS 5 // Armor added while the DEFENDING status is active
+
+// Every status effect a character can have. The value is the bit index in StatusEffects::active,
+// debuffs come first so the status panel lists them in the same order as before.
+enum StatusEffectId : std::uint8_t {SE_POISONED = 0, SE_BURNING, SE_WEAKENED, SE_SLOWED,
+                                    SE_STRENGTHENED, SE_REGENERATING, SE_FAST, SE_DEFENDING, SE_COUNT};
+
 // Structure to hold character status effects
+// One bit per active effect plus how many turns it has left and how strong it is. Base stats are never
+// changed by an effect, Character::getArmor()/meleeBonus()/rangeBonus() add the modifiers when they are read.
+//    - POISONED / BURNING: lose magnitude HP at the end of every round
+//    - REGENERATING: gain magnitude HP at the end of every round
+//    - WEAKENED / STRENGTHENED: -/+ magnitude to melee and ranged attack bonus
+//    - SLOWED / FAST: -/+ magnitude armor (easier / harder to hit)
+//    - DEFENDING: +DEFEND_ARMOR_BONUS armor until endDefense() (duration 0 = no time limit)
 struct StatusEffects 
 {
-    bool isPoisoned = false;
-    bool isBurning = false;
-    bool isWeakened = false;
-    bool isStrengthened = false;
-    bool isRegenerating = false;
-    bool isSlowed = false;
-    bool isFast = false;
-    bool defending = false;
+    std::uint8_t active = 0;                 // bit (1 << StatusEffectId) is set while the effect is on
+    std::uint8_t duration[SE_COUNT] = {};    // rounds left, 0 means it lasts until cleared
+    std::int8_t magnitude[SE_COUNT] = {};    // damage/heal per round or stat modifier
+
+    bool has(StatusEffectId id) const { return (active >> id) & 1u; }
+
+    // Turns an effect on (re-applying refreshes it, keeping the longer duration and the stronger magnitude)
+    void apply(StatusEffectId id, std::uint8_t turns, std::int8_t amount)
+    {
+        if (has(id))
+        {
+            duration[id] = (duration[id] == 0 || turns == 0) ? 0 : std::max(duration[id], turns);
+            magnitude[id] = std::max(magnitude[id], amount);
+        }
+        else
+        {
+            duration[id] = turns;
+            magnitude[id] = amount;
+        }
+        active |= (std::uint8_t)(1u << id);
+    }
+
+    void clear(StatusEffectId id)
+    {
+        active &= (std::uint8_t)~(1u << id);
+        duration[id] = 0;
+        magnitude[id] = 0;
+    }
+
+    // Modifier from an effect, 0 when it is not active (branch free so it is cheap to call on every read)
+    int modifier(StatusEffectId id) const { return has(id) * magnitude[id]; }
+};
+
+// Structure holding the dice rolled for one attack (used by the combat journal to replay fights)
+struct AttackRoll
+{
+    std::uint8_t hitRoll = 0;    // d20 roll (0 if no attack happened)
+    std::uint8_t damageRoll = 0; // damage die roll (0 on a miss)
+    bool hit = false;
 };
 
-// Data Structure to hold character inventories, WIP
+// Data Structure to hold character inventories, WIP (name and description come from the item registry)
 struct Item
 {
-    std::string name;
-    std::string description;
+    ItemID id = ItemID::None;
     std::uint8_t quantity = 1;
     std::uint8_t healAmount = 0;
     bool singleuse = false; 
     bool consumed = false;
+
+    const char* name() const { return itemInfo(id).name; }
+    const char* description() const { return itemInfo(id).description; }
 };
 
 //Consumable based items
@@ -102,15 +208,14 @@ struct HealthPotion: Consumable
 {
     HealthPotion(int amount = 15)
     {
-        name = "Health Potion";
-        description = "A strange liquid, restores 15HP";
+        id = ItemID::HealthPotion;
         healAmount = amount;
         quantity = 1;
     }
 };
 
-//Inventory class for storing the different items in a vector, currently only health potions are implemented.
-//Also allows for easier inventory management with add/remove item functions
+//Inventory class for storing the different items. Its a small flat map: one entry per (item ID, heal amount)
+//kept sorted, so lookups are a binary search over a few bytes instead of string compares.
 class inventory
 {
     public: 
@@ -122,50 +227,113 @@ class inventory
         //setting player items when loading game
         void setItems(const std::vector<Item>& newItems)
         {
-            items = newItems;
+            items.clear();
+            for (const Item& item : newItems) additem(item);
         }
     
         void additem(const Item& item)
         {
-            for(auto& it : items)
+            auto it = std::lower_bound(items.begin(), items.end(), item, entryBefore);
+            if (it != items.end() && it->id == item.id && it->healAmount == item.healAmount)
             {
-                if(it.name == item.name && it.healAmount == item.healAmount) 
-                {
-                it.quantity += item.quantity;
+                it->quantity += item.quantity;
                 return;
-                }
             }
-            items.push_back(item);
+            items.insert(it, item);
         }
 
-        bool removeitem(const std::string& name, int qty = 1)
+        // removes qty of the first entry with this ID
+        bool removeitem(ItemID id, int qty = 1)
         {
-            for (auto it = items.begin(); it != items.end(); ++it) 
-            {
-                if (it->name == name) 
-                {
-                    if (it->quantity < qty)
-                        return false;  
+            std::size_t i = firstOf(id);
+            if (i == items.size() || items[i].quantity < qty)
+                return false; // item not found (or not enough of it)
 
-                    it->quantity -= qty;
+            items[i].quantity -= qty;
 
-                    if (it->quantity <= 0)
-                        items.erase(it);
+            if (items[i].quantity <= 0)
+                items.erase(items.begin() + i);
 
-                    return true;        
-                }
-            }
-            return false; // item not found
+            return true;
+        }
+
+        int count(ItemID id) const // total quantity over every heal amount
+        {
+            int total = 0;
+            for (std::size_t i = firstOf(id); i < items.size() && items[i].id == id; ++i) total += items[i].quantity;
+            return total;
         }
+
         const std::vector<Item>& getItems() const
         {
             return items;
         }
     private:
+        static bool entryBefore(const Item& a, const Item& b)
+        {
+            return a.id != b.id ? a.id < b.id : a.healAmount < b.healAmount;
+        }
+        std::size_t firstOf(ItemID id) const // index of the first entry with this ID, items.size() if there is none
+        {
+            auto it = std::lower_bound(items.begin(), items.end(), id, [](const Item& a, ItemID b) { return a.id < b; });
+            return (it != items.end() && it->id == id) ? (std::size_t)(it - items.begin()) : items.size();
+        }
         std::vector<Item> items;
 
 };
 
+// Every kind of character the game can create. The order matches ARCHETYPES below.
+enum class Archetype : std::uint8_t {Student, Rat, Professor, Atilla, Zombie, Count};
+
+// Everything that differs between the character classes, known at compile time.
+// Stats still come from Character_Starting_Stats.csv (looked up by csvID).
+struct ArchetypeInfo
+{
+    const char* csvID;           // row ID in the stats CSV (also the ID CreateCharacter takes)
+    const char* className;       // PlayerCharacter::characterClass / NPC type shown in the log
+    bool player;
+    std::uint8_t meleeWeapon;
+    std::uint8_t rangeWeapon;
+    std::uint8_t startingPotions; // health potions in the inventory at creation
+    const char* selectSprite;    // character select portrait (nullptr for NPCs)
+    const char* combatSprite;    // sprite used in combat (nullptr = chosen by the encounter)
+    StatusEffectId rangeEffect;  // put on the target by a ranged hit (SE_COUNT = none)
+    std::uint8_t rangeEffectTurns;
+    std::int8_t rangeEffectAmount;
+};
+
+inline constexpr ArchetypeInfo ARCHETYPES[(int)Archetype::Count] = {
+    // Student: ruler and trashcan lid / textbooks
+    {"Student",   "Student",   true,  2, 2, 1, "../assets/images/characters/pc/Student-Fighter/rotations/south.png",
+                                              "../assets/images/characters/pc/Student-Fighter/rotations/north-west.png",
+                                              SE_COUNT, 0, 0},
+    // Rat: Italian Stiletto & Bite / Water Gun filled with Hudson River Water[Deals poison damage]: 2 HP a round for 3 rounds
+    {"Rat",       "Rat",       true,  3, 1, 0, "../assets/images/characters/pc/Rat-Assassin/rotations/south.png",
+                                              "../assets/images/characters/pc/Rat-Assassin/rotations/north-west.png",
+                                              SE_POISONED, 3, 2},
+    // Professor: Taser, Poison Needle / fireball spell(molotov cocktail in a handle of fireball), 200 Watt Laser
+    // (the fireball sets the target burning: 3 HP a round for 2 rounds)
+    {"Professor", "Professor", true,  3, 4, 0, "../assets/images/characters/pc/Professor-Mage/rotations/south.png",
+                                              "../assets/images/characters/pc/Professor-Mage/rotations/north-west.png",
+                                              SE_BURNING, 2, 3},
+    // Atilla: Feathers of Fury(fists) / Rubber Duckies
+    {"Attila",    "Atilla",    true,  1, 2, 0, "../assets/images/characters/pc/Attila-Brawler/rotations/south.png",
+                                              "../assets/images/characters/pc/Attila-Brawler/rotations/north-west.png",
+                                              SE_COUNT, 0, 0},
+    // Zombie: default enemy, ranged value may not be used
+    {"Zombie",    "Zombie",    false, 3, 2, 0, nullptr, nullptr, SE_COUNT, 0, 0},
+};
+
+constexpr const ArchetypeInfo& archetypeInfo(Archetype a) { return ARCHETYPES[(int)a]; }
+
+// Looks up the archetype for a CSV ID, anything unknown is a Zombie (same fallback CreateCharacter always had)
+inline Archetype archetypeFromID(const std::string& id)
+{
+    for (int i = 0; i < (int)Archetype::Count; ++i)
+        if (id == ARCHETYPES[i].csvID) return (Archetype)i;
+    return Archetype::Zombie;
+}
+
 /**
  * @author: Edwin Baiden
  * @brief: Base class for all characters in the game (including players and NPCs), containing common attributes and methods including health management and status effects.
@@ -176,6 +344,8 @@ class Character
     public:
         // Initial attributes for all characters
         bool isPlayer; // true if player, false if NPC
+        Archetype archetype = Archetype::Zombie; // which row of ARCHETYPES this character was built from
+        std::string name; // player name or NPC type (what getName() returns)
         Attributes att;
         DefenseStats def;
         CombatStats cbt;
@@ -186,10 +356,12 @@ class Character
         
         
         // Constructor to initialize all attributes
-        Character(bool player, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : isPlayer(player), att(attributes), def(defense), cbt(combat), vit(vital), statEff(statusEffects) {}
+        Character(bool player, const std::string& displayName, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
+            : isPlayer(player), name(displayName), att(attributes), def(defense), cbt(combat), vit(vital), statEff(statusEffects) {}
 
-        virtual ~Character() = default; // Virtual destructor for proper cleanup of derived classes
+        // Virtual destructor for proper cleanup of derived classes (entities are deleted through Character*).
+        // Nothing else is virtual so combat and UI reads are plain member loads.
+        virtual ~Character() = default;
 
         /**
          * @brief: Returns true if the character's health is above zero, indicating they are alive.
@@ -213,43 +385,87 @@ class Character
             }
         }
 
+        /**
+         * @brief: Armor with status effect modifiers (defending, slowed, fast) added on top of the base armor.
+         * @return: int - the armor attacks have to beat.
+         */
+        int getArmor() const
+        {
+            return def.armor + statEff.has(SE_DEFENDING) * DEFEND_ARMOR_BONUS
+                   + statEff.modifier(SE_FAST) - statEff.modifier(SE_SLOWED);
+        }
+
+        /**
+         * @brief: Melee attack bonus (best of DEX/STR + weapon) with strengthened/weakened applied.
+         * @return: std::uint8_t - bonus added to the d20 and the d6 damage roll.
+         */
+        std::uint8_t meleeBonus() const
+        {
+            int bonus = std::max(att.dexterity, att.strength) + wep.meleeWeapon
+                        + statEff.modifier(SE_STRENGTHENED) - statEff.modifier(SE_WEAKENED);
+            return (std::uint8_t)std::max(0, bonus);
+        }
+
+        /**
+         * @brief: Ranged attack bonus (best of DEX/WIS + weapon) with strengthened/weakened applied.
+         * @return: std::uint8_t - bonus added to the d20 and the d4 damage roll.
+         */
+        std::uint8_t rangeBonus() const
+        {
+            int bonus = std::max(att.dexterity, att.wisdom) + wep.rangeWeapon
+                        + statEff.modifier(SE_STRENGTHENED) - statEff.modifier(SE_WEAKENED);
+            return (std::uint8_t)std::max(0, bonus);
+        }
+
         /**
          * @author: Andrew
          * @brief: calculates and applies melee damage
          * @param enemy - target that will take damage
+         * @return: the dice that were rolled (for the combat journal)
          */
-        void dealMeleeDamage (Character& enemy)
+        AttackRoll dealMeleeDamage (Character& enemy)
         {
-            this->cbt.meleeDamage = std::max(this->att.dexterity,this->att.strength) + this->wep.meleeWeapon;
-            if (enemy.def.armor < roll_d(20) + this->cbt.meleeDamage)
+            AttackRoll rolls;
+            this->cbt.meleeDamage = meleeBonus();
+            rolls.hitRoll = roll_d(20);
+            if (enemy.getArmor() < rolls.hitRoll + this->cbt.meleeDamage)
             {
-                enemy.takeDamage(roll_d(6) + this->cbt.meleeDamage);
+                rolls.hit = true;
+                rolls.damageRoll = roll_d(6);
+                enemy.takeDamage(rolls.damageRoll + this->cbt.meleeDamage);
             }
+            return rolls;
         }
 
         /**
          * @author: Andrew
-         * @brief: calculates and applies range damage
+         * @brief: calculates and applies range damage, a hit also puts the archetype's rangeEffect (poison, burn) on the target
          * @param enemy - target that will take damage
+         * @return: the dice that were rolled (for the combat journal)
          */
-        void dealRangeDamage (Character& enemy)
+        AttackRoll dealRangeDamage (Character& enemy)
         {
-            this->cbt.rangeDamage = std::max(this->att.dexterity,this->att.wisdom) + this->wep.rangeWeapon;
-            if (enemy.def.armor < roll_d(20) + this->cbt.rangeDamage)
+            AttackRoll rolls;
+            this->cbt.rangeDamage = rangeBonus();
+            rolls.hitRoll = roll_d(20);
+            if (enemy.getArmor() < rolls.hitRoll + this->cbt.rangeDamage)
             {
-                enemy.takeDamage(roll_d(4) + this->cbt.rangeDamage);
+                rolls.hit = true;
+                rolls.damageRoll = roll_d(4);
+                enemy.takeDamage(rolls.damageRoll + this->cbt.rangeDamage);
+                const ArchetypeInfo& info = archetypeInfo(archetype);
+                if (info.rangeEffect != SE_COUNT) enemy.statEff.apply(info.rangeEffect, info.rangeEffectTurns, info.rangeEffectAmount);
             }
+            return rolls;
         }
 
         /**
          * @author: Andrew
-         * @brief: adds defense bonus
+         * @brief: adds defense bonus (DEFENDING status, armor bonus is added by getArmor())
          */
         void startDefense() 
         {
-            statEff.defending = true;
-            this->def.armor += 5;
-           
+            statEff.apply(SE_DEFENDING, 0, DEFEND_ARMOR_BONUS);
         }
 
         /**
@@ -258,14 +474,15 @@ class Character
          */
         void endDefense() 
         {
-            if(statEff.defending) { this->def.armor -= 5; }
-            statEff.defending = false;
+            statEff.clear(SE_DEFENDING);
         }
 
+        bool isDefending() const { return statEff.has(SE_DEFENDING); }
+
         
         
         
-        virtual const std::string& getName() const = 0; // Pure virtual function to get character name must be implemented by derived classes
+        const std::string& getName() const { return name; } // Player name for players, NPC type for NPCs
 };
 
 /**
@@ -277,18 +494,14 @@ class PlayerCharacter : public Character
 {
     // Player-specific attributes
     public:
-        std::string name;
         std::string characterClass; // e.g., Student, Rat, Professor, Atilla
-        bool key1 = false;
-        bool key2 = false;
         bool zombie1Defeated = false;
         bool zombie2Defeated = false;
         bool zombie3Defeated = false;
-        const std::string& getName() const override { return name; } // Override to return player character's name
 
         // Constructor to initialize player character attributes
         PlayerCharacter(const std::string& playerName, const std::string& charClass, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : Character(true, attributes, defense, combat, vital, statusEffects), name(playerName), characterClass(charClass) {}
+            : Character(true, playerName, attributes, defense, combat, vital, statusEffects), characterClass(charClass) {}
 
         // Heal the character and ensure health doesn't exceed maxHealth
         //@brief: Increases the character's health by the specified amount, up to their maximum health.
@@ -320,96 +533,67 @@ class NonPlayerCharacter : public Character
 {
     // NPC-specific attributes
     public:
-        std::string npcType; // e.g., Zombie, Civilian, Security
-        const std::string& getName() const override { return npcType; } // Override to return NPC type as name
-        // Constructor to initialize NPC attributes
+        // Constructor to initialize NPC attributes (type is the name shown in combat, e.g., Zombie, Civilian, Security)
         NonPlayerCharacter(const std::string& type, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : Character(false, attributes, defense, combat, vital, statusEffects), npcType(type) {}
+            : Character(false, type, attributes, defense, combat, vital, statusEffects) {}
 
 
         virtual ~NonPlayerCharacter() = default; // Virtual destructor
 };
 
-// Specific player character classes inheriting from PlayerCharacter
-class Student : public PlayerCharacter
+// Specific player character classes. They only differ by their ARCHETYPES row, so one template
+// stamps them out with the weapons and starting items baked in as compile time constants.
+template <Archetype A>
+class PlayerArchetype : public PlayerCharacter
 {
+    static_assert(archetypeInfo(A).player, "PlayerArchetype needs a player archetype");
     public:
-        Student(const std::string& playerName, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : PlayerCharacter(playerName, "Student", attributes, defense, combat, vital, statusEffects)
+        static constexpr const ArchetypeInfo& info = ARCHETYPES[(int)A];
 
+        PlayerArchetype(const std::string& playerName, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
+            : PlayerCharacter(playerName, info.className, attributes, defense, combat, vital, statusEffects)
         {
-            // Default attributes for Student character
-            wep.meleeWeapon = 2; // ruler
-            wep.rangeWeapon = 2; // textbooks
-            HealthPotion Hpotion; //Adding potion to inventory for student for testing
-            //Damageboost Dpotion
-            inv.additem(Hpotion);
-        };
+            archetype = A;
+            wep.meleeWeapon = info.meleeWeapon;
+            wep.rangeWeapon = info.rangeWeapon;
+            for (int i = 0; i < info.startingPotions; ++i) inv.additem(HealthPotion());
+        }
 };
 
-class Rat : public PlayerCharacter 
-{
-    public:
-        Rat(const std::string& playerName, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : PlayerCharacter(playerName, "Rat", attributes, defense, combat, vital, statusEffects)
-
-        {
-            // Default attributes for Rat character
-            wep.meleeWeapon = 3; // Italian Stiletto & Bite
-            wep.rangeWeapon = 1; // Water Gun filled with Hudson River Water[Deals poison damage]
-        };
-};
+using Student = PlayerArchetype<Archetype::Student>;
+using Rat = PlayerArchetype<Archetype::Rat>;
+using Professor = PlayerArchetype<Archetype::Professor>;
+using Atilla = PlayerArchetype<Archetype::Atilla>;
 
-class Professor : public PlayerCharacter 
+// Enemy classes, same idea as PlayerArchetype (the NPC type shown in the log is the archetype's class name)
+template <Archetype A>
+class NpcArchetype : public NonPlayerCharacter
 {
+    static_assert(!archetypeInfo(A).player, "NpcArchetype needs an NPC archetype");
     public:
-        Professor(const std::string& playerName, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : PlayerCharacter(playerName, "Professor", attributes, defense, combat, vital, statusEffects)
+        static constexpr const ArchetypeInfo& info = ARCHETYPES[(int)A];
 
+        NpcArchetype(Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
+            : NonPlayerCharacter(info.className, attributes, defense, combat, vital, statusEffects)
         {
-            // Default attributes for Professor character
-            wep.meleeWeapon = 3; // Taser, Poison Needle
-            wep.rangeWeapon = 4; // fireball spell(molotov cocktail in a handle of fireball), 200 Watt Laser
-        };
-};
-
-class Atilla : public PlayerCharacter 
-{
-    public:
-        Atilla(const std::string& playerName, Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : PlayerCharacter(playerName, "Atilla", attributes, defense, combat, vital, statusEffects)
-
-        {
-            // Default attributes for Atilla character
-            wep.meleeWeapon = 1; // Feathers of Fury(fists)
-            wep.rangeWeapon = 2; // Rubber Duckies
-        };
+            archetype = A;
+            wep.meleeWeapon = info.meleeWeapon;
+            wep.rangeWeapon = info.rangeWeapon;
+        }
 };
 
 // Class for default zombie type
-class Zombie : public NonPlayerCharacter
-{
-    public:
-        Zombie(Attributes attributes, DefenseStats defense, CombatStats combat, VitalStats vital, StatusEffects statusEffects)
-            : NonPlayerCharacter("Zombie", attributes, defense, combat, vital, statusEffects)
-        {
-            wep.meleeWeapon = 3;
-            wep.rangeWeapon = 2; // default value, may not be used
-            
-        };
-};
-
-std::ifstream* openStartingStatsCSV();
-std::istringstream* storeAllStatLines(std::ifstream* statsFile);
-std::int8_t getStatForCharacterID(std::istringstream* allStats, std::string characterID, CSVStats stat);
-void CreateCharacter(Character**& entities, std::istringstream* allStats, std::string ID, std::string name);
-
-struct charCard 
-{
-    Rectangle defaultRow;
-    Rectangle currentAnimationPos;
-    Rectangle targetAnimationPos;
-    Texture2D texture;
-};
+using Zombie = NpcArchetype<Archetype::Zombie>;
+
+// Checked downcast without RTTI: players are always PlayerCharacters (isPlayer is set by the constructor)
+inline PlayerCharacter* asPlayer(Character* c) { return (c && c->isPlayer) ? static_cast<PlayerCharacter*>(c) : nullptr; }
+inline const PlayerCharacter* asPlayer(const Character* c) { return (c && c->isPlayer) ? static_cast<const PlayerCharacter*>(c) : nullptr; }
+
+class EntityPool;
+struct EntityHandle;
+// Spawns the character for ID in the pool and puts it in its combat slot (player 0, enemy 1) of
+// entities (may be nullptr), despawning whoever had that slot before
+EntityHandle CreateCharacter(EntityPool& pool, Character** entities, const StatTable& stats, const std::string& ID, const std::string& name);
+void tickStatusEffects(Character* const* chars, std::size_t count, int* hpChange);
 
 #endif // CHARACTERS_H
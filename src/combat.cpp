@@ -8,6 +8,7 @@
 */
 
 #include "combat.h"
+#include "combatAI.h"
 
 //@brief: Get the name of a character
 //@param c - The character whose name is to be retrieved
@@ -37,15 +38,17 @@ int clampi(int v, int lo, int hi)
 //@param defender - The character receiving the attack
 //@param defenderIsDefending - Boolean indicating if the defender is in a defending state
 //@param log - A stringstream to log the combat events
+//@param rolls - Optional, receives the dice that were rolled (for the combat journal)
 //@version: 1.0
 //@return: True if damage was dealt, false otherwise
 //@author: Sebastian Cardona
-bool resolve_melee(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log)
+bool resolve_melee(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log, AttackRoll* rolls)
 {
     std::int8_t beforeHP = defender.vit.health;
 
     //if (defenderIsDefending) defender.startDefense();
-    attacker.dealMeleeDamage(defender);
+    AttackRoll dice = attacker.dealMeleeDamage(defender);
+    if (rolls) *rolls = dice;
     //defender.endDefense();
 
     std::int8_t delta = std::max(0, beforeHP - defender.vit.health);
@@ -59,10 +62,11 @@ bool resolve_melee(Character& attacker, Character& defender, bool defenderIsDefe
 //@param defender - The character receiving the attack
 //@param defenderIsDefending - Boolean indicating if the defender is in a defending state
 //@param log - A stringstream to log the combat events
+//@param rolls - Optional, receives the dice that were rolled (for the combat journal)
 //@version: 1.0
 //@return: True if damage was dealt, false otherwise
 //@author: Sebastian Cardona
-bool resolve_ranged(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log) 
+bool resolve_ranged(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log, AttackRoll* rolls) 
 {
     std::int8_t beforeHP   = defender.vit.health;
     //int originalAR = defender.def.armor;
@@ -72,13 +76,20 @@ bool resolve_ranged(Character& attacker, Character& defender, bool defenderIsDef
     //    defender.startDefense();
     
 
-    attacker.dealRangeDamage(defender);
+    AttackRoll dice = attacker.dealRangeDamage(defender);
+    if (rolls) *rolls = dice;
     //defender.def.armor = originalAR;
     //defender.endDefense();
 
     std::int8_t delta = std::max(0, beforeHP - defender.vit.health);
     if (delta > 0) AddNewLogEntry(log, nameOf(defender) + " takes " + std::to_string(delta) + " damage."); 
     else AddNewLogEntry(log, nameOf(attacker) + " misses.");
+
+    // the attacker's ranged weapon might carry an effect (dealRangeDamage put it on the defender)
+    static const char* const EFFECT_TAKEN[SE_COUNT] = {" is poisoned!", " is burning!", " is weakened!", " is slowed!",
+                                                       " is strengthened!", " is regenerating!", " is fast!", " is defending!"};
+    const StatusEffectId effect = archetypeInfo(attacker.archetype).rangeEffect;
+    if (dice.hit && effect != SE_COUNT) AddNewLogEntry(log, nameOf(defender) + EFFECT_TAKEN[effect]);
     return delta > 0;
 }
 
@@ -104,8 +115,8 @@ void resolve_inventory(Student& player, std::vector<std::string>& log)
     {
         const auto& it = items[i];
         std::cout << (i + 1) << ") "
-                  << it.name << " x" << it.quantity
-                  << " - " << it.description << "\n";
+                  << it.name() << " x" << it.quantity
+                  << " - " << it.description() << "\n";
     }
     std::cout << "0) Cancel\n";
     std::cout << "> ";
@@ -140,10 +151,10 @@ void resolve_inventory(Student& player, std::vector<std::string>& log)
         player.heal(selected.healAmount);
         int healed = player.vit.health - before;
 
-        AddNewLogEntry(log, nameOf(player) + " uses " + selected.name + " and heals " + std::to_string(healed) + " HP. " + 
+        AddNewLogEntry(log, nameOf(player) + " uses " + selected.name() + " and heals " + std::to_string(healed) + " HP. " + 
         "HP " + std::to_string(player.vit.health)  + "/" + std::to_string(player.vit.maxHealth)  + "\n");
         // remove 1 from inventory
-        player.inv.removeitem(selected.name, 1);
+        player.inv.removeitem(selected.id, 1);
     }
     else
     {
@@ -152,17 +163,16 @@ void resolve_inventory(Student& player, std::vector<std::string>& log)
 }
 
 
-//@brief: AI function to choose an action for a non-player character during combat
+//@brief: AI function to choose an action for a non-player character during combat. Runs the
+//        expectimax search from combatAI.cpp on the calling thread to a fixed depth. The game
+//        itself uses EnemyPlanner so the search runs while the enemy action delay counts down.
 //@param self - The NPC character making the decision
 //@param foe - The player character being targeted
-//@version: 1.0
+//@version: 2.0
 //@author: Sebastian Cardona
-Action ai_choose(const NonPlayerCharacter& /*self*/, const PlayerCharacter& /*foe*/) 
+Action ai_choose(const NonPlayerCharacter& self, const PlayerCharacter& foe) 
 {
-    int roll = roll_d(4);           
-    if (roll == 1) return {ActionType::Defend, "Defend"};
-    else
-        return {ActionType::Attack, "Attack"};
+    return searchToDepth(snapshotCombat(self, foe), AI_SYNC_SEARCH_DEPTH); // fixed depth, same answer under any load
 }
 
 Action player_choose() 
@@ -6,6 +6,7 @@
 
 */
 #include "characters.h"
+#include "combatJournal.h"
 #include <sstream>
 #include <string>
 #include <sstream>
@@ -13,6 +14,9 @@
 #include <random>
 #include <vector>
 
+//=============== HEADER GUARD ===============
+#ifndef COMBAT_H
+#define COMBAT_H
 
 //@brief: Enum representing different action types during combat
 //@version: 1.0
@@ -52,14 +56,18 @@ struct CombatHandler
 
     bool showAttackMenu = false;
     bool showItemMenu = false;
+
+    CombatJournal journal; // Binary record of every action in this fight (flushed when the fight ends)
 };
 
 //Function prototypes
 const std::string& nameOf(const Character& c);
 int clampi(int v, int lo, int hi);
-bool resolve_melee(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log);
-bool resolve_ranged(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log);
+bool resolve_melee(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log, AttackRoll* rolls = nullptr);
+bool resolve_ranged(Character& attacker, Character& defender, bool defenderIsDefending, std::vector<std::string>& log, AttackRoll* rolls = nullptr);
 void resolve_inventory(Student& player, std::vector<std::string>& log);
 Action ai_choose(const NonPlayerCharacter& /*self*/, const PlayerCharacter& /*foe*/);
 void AddNewLogEntry(std::vector<std::string>& log, const std::string& entry);
 void runCombat(Student& player, NonPlayerCharacter& enemy); 
+
+#endif // COMBAT_H
@@ -0,0 +1,271 @@
+/*====================================== combatAI.cpp ========================================
+  Project: TTRPG Game ?
+  Subsystem: Combat Engine (Enemy AI)
+  Primary Author: Sebastian Cardona
+  Description: Expectimax search for enemy turns. Enemy nodes take the max over its actions,
+               player nodes take the min (we assume the player plays well), and every attack
+               is a chance node that averages over the exact d20 hit chance and every face of
+               the damage die. Depth is increased one ply at a time until the time budget runs
+               out, and only fully searched depths are allowed to change the answer.
+*/
+
+#include "combatAI.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Action indices used inside the search (Heal is only ever offered to the player side)
+    enum SearchAction : int { AI_MELEE = 0, AI_RANGED, AI_DEFEND, AI_HEAL, AI_ACTION_COUNT };
+
+    constexpr double WIN_SCORE = 1000.0;       // Score for a won fight (scaled by how soon it happens)
+    constexpr std::uint32_t CLOCK_CHECK_MASK = 4095; // Look at the clock every 4096 nodes
+
+    struct SearchContext
+    {
+        Clock::time_point deadline;
+        const std::atomic<bool>* stop = nullptr;
+        bool timed = true; // false = fixed depth search, the clock is never read
+        std::uint32_t nodes = 0;
+        bool aborted = false;
+    };
+
+    //@brief: Chance that d20 + bonus beats the armor, same test as Character::dealMeleeDamage
+    double hitChance(int bonus, int armor)
+    {
+        int needAbove = armor - bonus; // hit when the d20 roll is greater than this
+        int hits = 20 - std::max(0, needAbove);
+        return std::max(0, std::min(20, hits)) / 20.0;
+    }
+
+    //@brief: Static evaluation, positive means the fight is going well for the enemy
+    double evaluate(const CombatantSnapshot& self, const CombatantSnapshot& foe)
+    {
+        return (double)self.health / std::max<int>(1, self.maxHealth) - (double)foe.health / std::max<int>(1, foe.maxHealth);
+    }
+
+    bool outOfTime(SearchContext& ctx)
+    {
+        if (ctx.aborted || !ctx.timed) return ctx.aborted;
+        if ((++ctx.nodes & CLOCK_CHECK_MASK) == 0)
+        {
+            if (Clock::now() >= ctx.deadline || (ctx.stop && ctx.stop->load(std::memory_order_relaxed)))
+                ctx.aborted = true;
+        }
+        return ctx.aborted;
+    }
+
+    double search(CombatantSnapshot self, CombatantSnapshot foe, bool enemyToMove, int depth, SearchContext& ctx);
+
+    //@brief: Chance node for an attack, averages the miss branch and every face of the damage die
+    double attackNode(const CombatantSnapshot& self, const CombatantSnapshot& foe, bool enemyAttacks, int die, int bonus, int depth, SearchContext& ctx)
+    {
+        const CombatantSnapshot& target = enemyAttacks ? foe : self;
+        double p = hitChance(bonus, target.armor + (target.defending ? AI_DEFEND_BONUS : 0));
+
+        double value = 0.0;
+        if (p < 1.0) value += (1.0 - p) * search(self, foe, !enemyAttacks, depth - 1, ctx);
+        if (p > 0.0)
+        {
+            double hitValue = 0.0;
+            for (int face = 1; face <= die; ++face)
+            {
+                CombatantSnapshot s = self, f = foe;
+                CombatantSnapshot& hurt = enemyAttacks ? f : s;
+                hurt.health = (std::int16_t)std::max(0, hurt.health - (face + bonus));
+                hitValue += search(s, f, !enemyAttacks, depth - 1, ctx);
+            }
+            value += p * hitValue / die;
+        }
+        return value;
+    }
+
+    //@brief: Value of taking one specific action, the actor's defend bonus ends when it acts
+    double actionValue(CombatantSnapshot self, CombatantSnapshot foe, bool enemyToMove, int action, int depth, SearchContext& ctx)
+    {
+        CombatantSnapshot& actor = enemyToMove ? self : foe;
+        actor.defending = false;
+        switch (action)
+        {
+            case AI_MELEE:  return attackNode(self, foe, enemyToMove, 6, actor.meleeBonus, depth, ctx);
+            case AI_RANGED: return attackNode(self, foe, enemyToMove, 4, actor.rangeBonus, depth, ctx);
+            case AI_DEFEND:
+                actor.defending = true;
+                return search(self, foe, !enemyToMove, depth - 1, ctx);
+            case AI_HEAL:
+            default:
+                actor.health = (std::int16_t)std::min<int>(actor.maxHealth, actor.health + actor.healAmount);
+                actor.potions--;
+                return search(self, foe, !enemyToMove, depth - 1, ctx);
+        }
+    }
+
+    bool canHeal(const CombatantSnapshot& c)
+    {
+        return c.potions > 0 && c.healAmount > 0 && c.health < c.maxHealth;
+    }
+
+    double search(CombatantSnapshot self, CombatantSnapshot foe, bool enemyToMove, int depth, SearchContext& ctx)
+    {
+        if (foe.health <= 0) return WIN_SCORE + depth;     // sooner wins score higher
+        if (self.health <= 0) return -WIN_SCORE - depth;   // sooner losses score lower
+        if (depth == 0 || outOfTime(ctx)) return evaluate(self, foe);
+
+        int actionCount = (!enemyToMove && canHeal(foe)) ? AI_ACTION_COUNT : AI_HEAL;
+        double best = enemyToMove ? -1e9 : 1e9;
+        for (int a = 0; a < actionCount; ++a)
+        {
+            double v = actionValue(self, foe, enemyToMove, a, depth, ctx);
+            best = enemyToMove ? std::max(best, v) : std::min(best, v);
+        }
+        return best;
+    }
+
+    Action toAction(int action)
+    {
+        switch (action)
+        {
+            case AI_RANGED: return {ActionType::UseRange, "UseRange"};
+            case AI_DEFEND: return {ActionType::Defend, "Defend"};
+            case AI_MELEE:
+            default:        return {ActionType::Attack, "Attack"};
+        }
+    }
+
+    //@brief: Iterative deepening up to maxDepth, only fully searched depths change the answer
+    int deepen(const CombatSnapshot& snapshot, int maxDepth, SearchContext& ctx, std::atomic<int>* bestSoFar, int* depthReached)
+    {
+        int bestAction = AI_MELEE;
+        int completedDepth = 0;
+        for (int depth = 1; depth <= std::min(maxDepth, AI_MAX_SEARCH_DEPTH); ++depth)
+        {
+            int depthBest = AI_MELEE;
+            double depthBestValue = -1e9;
+            for (int a = 0; a < AI_HEAL; ++a)
+            {
+                double v = actionValue(snapshot.self, snapshot.foe, true, a, depth, ctx);
+                if (ctx.aborted) break;
+                if (v > depthBestValue) { depthBestValue = v; depthBest = a; }
+            }
+            if (ctx.aborted) break; // half searched depths are not trusted
+
+            bestAction = depthBest;
+            completedDepth = depth;
+            if (bestSoFar) bestSoFar->store(bestAction, std::memory_order_release);
+            if (depthBestValue >= WIN_SCORE) break; // forced win found, deeper search wont change it
+        }
+
+        if (depthReached) *depthReached = completedDepth;
+        return bestAction;
+    }
+}
+
+//@brief: Copies the combat relevant stats of two characters into a snapshot
+//@param self - The character choosing an action
+//@param foe - The character it is fighting
+//@return: A CombatSnapshot the search can use without touching the characters again
+//@version: 1.0
+//@author: Sebastian Cardona
+CombatSnapshot snapshotCombat(const Character& self, const Character& foe)
+{
+    auto copy = [](const Character& c)
+    {
+        CombatantSnapshot s;
+        s.health = c.vit.health;
+        s.maxHealth = std::max<std::int16_t>(1, c.vit.maxHealth);
+        s.defending = c.isDefending();
+        s.armor = (std::int8_t)(c.getArmor() - (s.defending ? AI_DEFEND_BONUS : 0)); // the search adds the defend bonus itself
+        s.meleeBonus = (std::int8_t)c.meleeBonus();
+        s.rangeBonus = (std::int8_t)c.rangeBonus();
+        if (c.isPlayer)
+        {
+            for (const auto& item : static_cast<const PlayerCharacter&>(c).inv.getItems())
+            {
+                if (item.healAmount == 0) continue;
+                s.potions = (std::uint8_t)std::min(255, s.potions + item.quantity);
+                s.healAmount = std::max(s.healAmount, item.healAmount);
+            }
+        }
+        return s;
+    };
+    return {copy(self), copy(foe)};
+}
+
+//@brief: Runs an iterative deepening expectimax search and returns the best action found in time
+//@param snapshot - State of the fight to search from
+//@param budgetMs - Hard time limit in milliseconds
+//@param stop - Optional flag another thread can raise to end the search early
+//@param bestSoFar - Optional atomic updated after every completed depth (action index)
+//@param depthReached - Optional out param holding the deepest fully searched depth
+//@return: The chosen Action (Attack if not even depth 1 finished)
+//@version: 1.0
+//@author: Sebastian Cardona
+Action searchBestAction(const CombatSnapshot& snapshot, int budgetMs, const std::atomic<bool>* stop,
+    std::atomic<int>* bestSoFar, int* depthReached)
+{
+    SearchContext ctx;
+    ctx.deadline = Clock::now() + std::chrono::milliseconds(std::max(0, budgetMs));
+    ctx.stop = stop;
+    return toAction(deepen(snapshot, AI_MAX_SEARCH_DEPTH, ctx, bestSoFar, depthReached));
+}
+
+//@brief: Runs the same search without a clock, every ply up to depth (stops sooner only on a forced win)
+//@param snapshot - State of the fight to search from
+//@param depth - Plies to search (capped at AI_MAX_SEARCH_DEPTH)
+//@param depthReached - Optional out param holding the deepest fully searched depth
+//@return: The chosen Action, only depends on the snapshot and depth
+//@version: 1.0
+//@author: Sebastian Cardona
+Action searchToDepth(const CombatSnapshot& snapshot, int depth, int* depthReached)
+{
+    SearchContext ctx;
+    ctx.timed = false;
+    return toAction(deepen(snapshot, depth, ctx, nullptr, depthReached));
+}
+
+//@brief: Stops and joins the worker if it is still running
+//@version: 1.0
+//@author: Sebastian Cardona
+EnemyPlanner::~EnemyPlanner()
+{
+    cancel();
+}
+
+//@brief: Starts searching the given snapshot on the worker thread
+//@param snapshot - Fight state at the start of the enemy turn
+//@param budgetMs - Hard time limit, should not be longer than the enemy action delay
+//@version: 1.0
+//@author: Sebastian Cardona
+void EnemyPlanner::begin(const CombatSnapshot& snapshot, int budgetMs)
+{
+    cancel(); // never run two searches at once
+    stopRequested.store(false);
+    bestAction.store(AI_MELEE);
+    depthReached = 0;
+    started = true;
+    worker = std::thread([this, snapshot, budgetMs]()
+    {
+        searchBestAction(snapshot, budgetMs, &stopRequested, &bestAction, &depthReached);
+    });
+}
+
+//@brief: Stops the search and returns the best action from the deepest finished ply
+//@return: Chosen enemy action
+//@version: 1.0
+//@author: Sebastian Cardona
+Action EnemyPlanner::collect()
+{
+    stopRequested.store(true);
+    if (worker.joinable()) worker.join();
+    started = false;
+    return toAction(bestAction.load(std::memory_order_acquire));
+}
+
+//@brief: Stops the search without using its result (fight ended, state changed under it)
+//@version: 1.0
+//@author: Sebastian Cardona
+void EnemyPlanner::cancel()
+{
+    stopRequested.store(true);
+    if (worker.joinable()) worker.join();
+    started = false;
+}
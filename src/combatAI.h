@@ -0,0 +1,125 @@
+/*======================================== combatAI.h ========================================
+  Project: TTRPG Game ?
+  Subsystem: Combat Engine (Enemy AI)
+  Primary Author: Sebastian Cardona
+  Description: Declares the search based enemy AI. Instead of rolling a die to pick an action,
+               the enemy runs a depth limited expectimax search over the same dice the combat
+               engine uses (d20 to hit, d6 melee damage, d4 ranged damage) and picks the action
+               with the best expected outcome. The player is modeled as an adversary (min node).
+
+               The search works on a CombatSnapshot (plain data copied out of the two Characters)
+               so it never touches live game state and can safely run on a background thread.
+
+                    Types:
+                        - CombatantSnapshot / CombatSnapshot: plain copies of the numbers the search needs.
+
+                        - EnemyPlanner: owns a worker thread that deepens the search while the
+                          enemyActionDelay counts down and hands back the best-so-far action.
+
+                    Functions:
+                        - CombatSnapshot snapshotCombat(const Character& self, const Character& foe):
+                          Copies the combat relevant stats out of two characters.
+
+                        - Action searchBestAction(const CombatSnapshot& snapshot, int budgetMs, ...):
+                          Iterative deepening expectimax bounded by a hard millisecond budget (the game's planner,
+                          the answer depends on how fast the machine is right now).
+
+                        - Action searchToDepth(const CombatSnapshot& snapshot, int depth, ...):
+                          The same search to a fixed depth, no clock. Same snapshot = same action on any machine
+                          under any load, for the blocking callers (console engine, headless sessions, benchmarks).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+//======================= PROJECT INCLUDES =======================
+#include "characters.h"
+#include "combat.h"
+
+//=============== HEADER GUARD ===============
+#ifndef COMBATAI_H
+#define COMBATAI_H
+
+#define AI_THINK_BUDGET_MS 400  // Hard cap on how long the background planner may think per enemy turn
+#define AI_SYNC_SEARCH_DEPTH 4  // Fixed depth of the blocking ai_choose() path (console engine, tools, sessions), ~1 ms
+#define AI_MAX_SEARCH_DEPTH 12  // Iterative deepening never goes past this many plies
+#define AI_DEFEND_BONUS DEFEND_ARMOR_BONUS // Armor bonus granted by Character::startDefense()
+
+//@brief: Plain copy of one combatant's numbers used by the AI search (no pointers, safe to hand to a thread)
+//@version: 1.0
+//@author: Sebastian Cardona
+struct CombatantSnapshot
+{
+    std::int16_t health = 0;
+    std::int16_t maxHealth = 1;
+    std::int8_t armor = 0;        // Armor WITHOUT the defend bonus (other status modifiers included)
+    std::int8_t meleeBonus = 0;   // Character::meleeBonus()
+    std::int8_t rangeBonus = 0;   // Character::rangeBonus()
+    std::uint8_t potions = 0;     // Healing items available (players only)
+    std::uint8_t healAmount = 0;  // HP restored per healing item
+    bool defending = false;
+};
+
+//@brief: Snapshot of both sides of a fight, taken from the enemy's point of view
+//@version: 1.0
+//@author: Sebastian Cardona
+struct CombatSnapshot
+{
+    CombatantSnapshot self; // The NPC that is choosing an action
+    CombatantSnapshot foe;  // The player it is fighting
+};
+
+//@brief: Copies the combat relevant stats of two characters into a snapshot
+//@param self - The character choosing an action
+//@param foe - The character it is fighting
+//@return: A CombatSnapshot the search can use without touching the characters again
+CombatSnapshot snapshotCombat(const Character& self, const Character& foe);
+
+//@brief: Runs an iterative deepening expectimax search and returns the best action found in time
+//@param snapshot - State of the fight to search from
+//@param budgetMs - Hard time limit in milliseconds
+//@param stop - Optional flag another thread can raise to end the search early
+//@param bestSoFar - Optional atomic updated after every completed depth (action index)
+//@param depthReached - Optional out param holding the deepest fully searched depth
+//@return: The chosen Action (Attack if not even depth 1 finished)
+Action searchBestAction(const CombatSnapshot& snapshot, int budgetMs, const std::atomic<bool>* stop = nullptr,
+    std::atomic<int>* bestSoFar = nullptr, int* depthReached = nullptr);
+
+//@brief: Runs the same search without a clock, every ply up to depth (stops sooner only on a forced win)
+//@param snapshot - State of the fight to search from
+//@param depth - Plies to search (capped at AI_MAX_SEARCH_DEPTH)
+//@param depthReached - Optional out param holding the deepest fully searched depth
+//@return: The chosen Action, only depends on the snapshot and depth
+Action searchToDepth(const CombatSnapshot& snapshot, int depth, int* depthReached = nullptr);
+
+//@brief: Runs searchBestAction on a worker thread so the enemy thinks while its action delay counts down.
+//        begin() at the start of the enemy turn, collect() when the delay ends. collect() raises the
+//        stop flag and joins, and the worker checks that flag every few thousand nodes so it never
+//        holds up the frame.
+//@version: 1.0
+//@author: Sebastian Cardona
+class EnemyPlanner
+{
+public:
+    EnemyPlanner() = default;
+    ~EnemyPlanner();
+    EnemyPlanner(const EnemyPlanner&) = delete;
+    EnemyPlanner& operator=(const EnemyPlanner&) = delete;
+
+    void begin(const CombatSnapshot& snapshot, int budgetMs); // Start thinking about this snapshot
+    Action collect();                                         // Stop thinking and return the best-so-far action
+    void cancel();                                            // Stop thinking and throw the result away
+    [[nodiscard]] bool isThinking() const { return started; } // True between begin() and collect()/cancel()
+    [[nodiscard]] int lastDepth() const { return depthReached; } // Deepest ply finished last turn (debugging)
+
+private:
+    std::thread worker;
+    std::atomic<bool> stopRequested{false};
+    std::atomic<int> bestAction{0};
+    int depthReached = 0;
+    bool started = false;
+};
+
+#endif // COMBATAI_H
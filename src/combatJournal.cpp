@@ -0,0 +1,146 @@
+/*==================================== combatJournal.cpp =====================================
+  Project: TTRPG Game ?
+  Subsystem: Combat Engine (Journal)
+  Primary Author: Sebastian Cardona
+  Description: Implements the binary combat journal declared in combatJournal.h. Recording
+               copies 9 bytes into a preallocated array; the only I/O happens in flush() once
+               the fight is over.
+*/
+
+#include "combatJournal.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    //@brief: Copies the starting stats of a character into the journal header
+    void fillCombatant(JournalCombatant& out, const Character& c)
+    {
+        std::memset(&out, 0, sizeof(out));
+        std::strncpy(out.id, c.getName().c_str(), sizeof(out.id) - 1);
+        out.archetype = (std::uint8_t)c.archetype;
+        out.attributes[0] = c.att.strength;
+        out.attributes[1] = c.att.dexterity;
+        out.attributes[2] = c.att.constitution;
+        out.attributes[3] = c.att.wisdom;
+        out.attributes[4] = c.att.charisma;
+        out.attributes[5] = c.att.intelligence;
+        out.armor = c.def.armor; // base armor, status modifiers are applied on read
+        out.initiative = c.cbt.initiative;
+        out.health = c.vit.health;
+        out.maxHealth = c.vit.maxHealth;
+        out.meleeWeapon = c.wep.meleeWeapon;
+        out.rangeWeapon = c.wep.rangeWeapon;
+        out.effectsActive = c.statEff.active;
+        std::memcpy(out.effectDuration, c.statEff.duration, sizeof(out.effectDuration));
+        std::memcpy(out.effectMagnitude, c.statEff.magnitude, sizeof(out.effectMagnitude));
+    }
+}
+
+//@brief: Resets the journal and records the seed and starting stats of a new fight
+//@param seed - Seed that was passed to seed_rng() for this fight
+//@param player - Player character at the start of the fight
+//@param enemy - Enemy character at the start of the fight
+//@version: 1.0
+//@author: Sebastian Cardona
+void CombatJournal::begin(std::uint32_t seed, const Character& player, const Character& enemy)
+{
+    std::memcpy(head.magic, JOURNAL_MAGIC, sizeof(head.magic));
+    head.version = JOURNAL_VERSION;
+    head.eventCount = 0;
+    head.seed = seed;
+    head.overflowed = 0;
+    fillCombatant(head.combatants[JOURNAL_PLAYER], player);
+    fillCombatant(head.combatants[JOURNAL_ENEMY], enemy);
+}
+
+//@brief: Appends one event to the preallocated buffer. If the buffer is full the event is dropped
+//        and the header is flagged so the replay tool knows the journal is incomplete.
+//@param action - What the actor did
+//@param actor - JOURNAL_PLAYER or JOURNAL_ENEMY
+//@param rolls - Dice rolled for the action (damageRoll holds HP healed for UseItem)
+//@param hpBefore - HP of the affected character before the action
+//@param hpAfter - HP of the affected character after the action
+//@param playerDefending - Player defend state when the action started
+//@param enemyDefending - Enemy defend state when the action started
+//@version: 1.0
+//@author: Sebastian Cardona
+void CombatJournal::record(JournalAction action, std::uint8_t actor, const AttackRoll& rolls, std::int8_t hpBefore,
+    std::int8_t hpAfter, bool playerDefending, bool enemyDefending) noexcept
+{
+    if (head.eventCount >= JOURNAL_CAPACITY)
+    {
+        head.overflowed = 1;
+        return;
+    }
+    CombatEvent& e = buffer[head.eventCount];
+    e.turn = head.eventCount;
+    e.actor = actor;
+    e.action = static_cast<std::uint8_t>(action);
+    e.d20 = rolls.hitRoll;
+    e.damageRoll = rolls.damageRoll;
+    e.hpBefore = hpBefore;
+    e.hpAfter = hpAfter;
+    e.flags = (playerDefending ? JOURNAL_FLAG_PLAYER_DEFENDING : 0) |
+              (enemyDefending ? JOURNAL_FLAG_ENEMY_DEFENDING : 0) |
+              (rolls.hit ? JOURNAL_FLAG_HIT : 0);
+    head.eventCount++;
+}
+
+//@brief: Drops every event after the first count (an undone turn). The RNG is put back to the same
+//        point by the caller, so the journal still replays from its seed.
+//@param count - Events to keep
+//@version: 1.0
+//@author: Sebastian Cardona
+void CombatJournal::truncate(std::uint16_t count) noexcept
+{
+    if (count >= head.eventCount) return;
+    head.eventCount = count;
+    head.overflowed = 0; // whatever got dropped came after count
+}
+
+//@brief: Writes the journal next to the save data (JOURNAL_DIR/combat_<seed>.tlj)
+//@return: True if the file was written
+//@version: 1.0
+//@author: Sebastian Cardona
+bool CombatJournal::flush() const
+{
+    platformEnterAppDirectory(); // relative paths are from the executable (MacOS is picky)
+    std::error_code ec;
+    std::filesystem::create_directories(JOURNAL_DIR, ec);
+    if (ec) return false;
+    return writeTo(std::string(JOURNAL_DIR) + "/combat_" + std::to_string(head.seed) + ".tlj");
+}
+
+//@brief: Writes the header and the recorded events to a file
+//@param path - File to write
+//@return: True if the file was written
+//@version: 1.0
+//@author: Sebastian Cardona
+bool CombatJournal::writeTo(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(buffer.data()), sizeof(CombatEvent) * head.eventCount);
+    return out.good();
+}
+
+//@brief: Loads a journal file written by CombatJournal::flush()
+//@param path - File to read
+//@param header - Filled with the file header
+//@param events - Filled with the events (cleared first)
+//@return: True if the file exists, has the right magic and version and is not truncated
+//@version: 1.0
+//@author: Sebastian Cardona
+bool readCombatJournal(const std::string& path, JournalHeader& header, std::vector<CombatEvent>& events)
+{
+    events.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 || header.version != JOURNAL_VERSION) return false;
+
+    events.resize(header.eventCount);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(events.data()), sizeof(CombatEvent) * header.eventCount));
+}
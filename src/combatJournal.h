@@ -0,0 +1,137 @@
+/*===================================== combatJournal.h ======================================
+  Project: TTRPG Game ?
+  Subsystem: Combat Engine (Journal)
+  Primary Author: Sebastian Cardona
+  Description: Declares the binary combat journal. Every fight records one fixed size event
+               per action (turn, actor, action, d20 roll, damage roll, HP before and after and
+               who was defending) into a buffer that lives inside the CombatHandler, so recording
+               never allocates. The buffer is written to dat/usrData/journals/ when the fight ends.
+
+               The journal header stores the RNG seed of the fight and both combatants' starting
+               stats and status effects, which is everything the replay tool (replayJournal.cpp)
+               needs to re-run the fight against the engine and check that it comes out the same.
+               Every end of a round is two StatusTick events (player, then enemy) even when no HP
+               changed, so the replay runs the tick at the same points and effect durations run
+               out on the same turns.
+
+               File layout (little endian, packed):
+                    JournalHeader | CombatEvent[eventCount]
+
+               The header and the events are written straight from memory, so the byte order on
+               disk is the CPU's. Like the binary save (saveData.h) the build refuses big endian
+               CPUs, which keeps every journal little endian and readable on any machine that
+               builds the replay tool.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "characters.h"
+
+//=============== HEADER GUARD ===============
+#ifndef COMBATJOURNAL_H
+#define COMBATJOURNAL_H
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    #error "The combat journal is written straight from memory and assumes a little endian CPU"
+#endif
+
+#define JOURNAL_MAGIC "TLLJ"         // First 4 bytes of every journal file
+#define JOURNAL_VERSION 3            // Bump when CombatEvent or JournalHeader changes
+#define JOURNAL_CAPACITY 512         // Events per fight (fights are short, extra events are dropped and flagged)
+#define JOURNAL_DIR "../dat/usrData/journals" // Where journals get flushed (relative to the executable)
+
+#define JOURNAL_PLAYER 0             // CombatEvent::actor value for the player
+#define JOURNAL_ENEMY 1              // CombatEvent::actor value for the enemy
+
+#define JOURNAL_FLAG_PLAYER_DEFENDING 0x01 // CombatEvent::flags, player was defending when the action started
+#define JOURNAL_FLAG_ENEMY_DEFENDING  0x02 // CombatEvent::flags, enemy was defending when the action started
+#define JOURNAL_FLAG_HIT              0x04 // CombatEvent::flags, the attack landed
+
+//@brief: What happened in a journal event
+//@version: 1.0
+//@author: Sebastian Cardona
+enum class JournalAction : std::uint8_t { Melee, Ranged, Defend, UseItem, StatusTick };
+
+#pragma pack(push, 1)
+//@brief: One combat action, 9 bytes on disk
+//@version: 1.0
+//@author: Sebastian Cardona
+struct CombatEvent
+{
+    std::uint16_t turn;       // 0 based action counter
+    std::uint8_t actor;       // JOURNAL_PLAYER or JOURNAL_ENEMY
+    std::uint8_t action;      // JournalAction
+    std::uint8_t d20;         // to hit roll (0 when no attack)
+    std::uint8_t damageRoll;  // damage die roll, or HP healed for UseItem
+    std::int8_t hpBefore;     // HP of the affected character before the action (target for attacks, actor otherwise)
+    std::int8_t hpAfter;      // HP of the affected character after the action
+    std::uint8_t flags;       // JOURNAL_FLAG_* bits
+};
+
+//@brief: Starting stats of one combatant, enough to rebuild it without the stats CSV
+//@version: 1.0
+//@author: Sebastian Cardona
+struct JournalCombatant
+{
+    char id[16];              // character class / npc type (name shown in the log)
+    std::uint8_t archetype;   // Archetype (what the class's weapons do on a hit, e.g. the Rat's poison)
+    std::int8_t attributes[6];// STR, DEX, CON, WIS, CHA, INT
+    std::int8_t armor;
+    std::int8_t initiative;
+    std::int8_t health;
+    std::int8_t maxHealth;
+    std::uint8_t meleeWeapon;
+    std::uint8_t rangeWeapon;
+    std::uint8_t effectsActive;               // StatusEffects::active (defending is SE_DEFENDING)
+    std::uint8_t effectDuration[SE_COUNT];    // StatusEffects::duration
+    std::int8_t effectMagnitude[SE_COUNT];    // StatusEffects::magnitude
+};
+
+//@brief: Header at the start of every journal file
+//@version: 1.0
+//@author: Sebastian Cardona
+struct JournalHeader
+{
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t eventCount;
+    std::uint32_t seed;       // value passed to seed_rng() when the fight started
+    std::uint8_t overflowed;  // 1 if events were dropped because the buffer was full
+    JournalCombatant combatants[2]; // [JOURNAL_PLAYER], [JOURNAL_ENEMY]
+};
+#pragma pack(pop)
+
+//@brief: Fixed capacity, allocation free journal of one fight
+//@version: 1.0
+//@author: Sebastian Cardona
+class CombatJournal
+{
+public:
+    void begin(std::uint32_t seed, const Character& player, const Character& enemy); // Reset and store the fight's starting state
+    void record(JournalAction action, std::uint8_t actor, const AttackRoll& rolls, std::int8_t hpBefore,
+        std::int8_t hpAfter, bool playerDefending, bool enemyDefending) noexcept; // Append one event (never allocates)
+    void truncate(std::uint16_t count) noexcept;             // Keep only the first count events (undo)
+    bool flush() const;                                      // Write to JOURNAL_DIR/combat_<seed>.tlj
+    bool writeTo(const std::string& path) const;             // Write to a specific file
+
+    [[nodiscard]] const JournalHeader& header() const { return head; }
+    [[nodiscard]] const CombatEvent* events() const { return buffer.data(); }
+    [[nodiscard]] std::uint16_t size() const { return head.eventCount; }
+
+private:
+    JournalHeader head{};
+    std::array<CombatEvent, JOURNAL_CAPACITY> buffer{};
+};
+
+//@brief: Loads a journal file written by CombatJournal::flush()
+//@param path - File to read
+//@param header - Filled with the file header
+//@param events - Filled with the events (cleared first)
+//@return: True if the file exists, has the right magic and version and is not truncated
+bool readCombatJournal(const std::string& path, JournalHeader& header, std::vector<CombatEvent>& events);
+
+#endif // COMBATJOURNAL_H
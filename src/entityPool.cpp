@@ -0,0 +1,95 @@
+/*===================================== entityPool.cpp =======================================
+  Project: TTRPG Game ?
+  Subsystem: Characters (Entity Pool)
+  Primary Author: Andrew
+  Description: Implementation of the EntityPool (see entityPool.h). The arena chunks are raw
+               aligned blocks, characters are placement constructed into them and destroyed
+               through Character's virtual destructor.
+*/
+#include "entityPool.h"
+
+EntityPool::EntityPool(std::size_t initialSlots)
+{
+    reserve(initialSlots);
+}
+
+EntityPool::~EntityPool()
+{
+    clear();
+    for (unsigned char* chunk : chunks)
+        ::operator delete(chunk, std::align_val_t(ENTITY_SLOT_ALIGN));
+}
+
+void EntityPool::addChunk()
+{
+    unsigned char* chunk = static_cast<unsigned char*>(::operator new(ENTITY_CHUNK_SLOTS * ENTITY_SLOT_SIZE, std::align_val_t(ENTITY_SLOT_ALIGN)));
+    chunks.push_back(chunk);
+
+    std::uint32_t first = (std::uint32_t)slots.size();
+    slots.resize(slots.size() + ENTITY_CHUNK_SLOTS);
+    freeSlots.reserve(slots.size()); // the free list can never be longer than this, so push_back never allocates
+    for (std::uint32_t i = ENTITY_CHUNK_SLOTS; i > 0; --i)
+        freeSlots.push_back(first + i - 1); // pushed backwards so the lowest index is handed out first
+}
+
+void EntityPool::reserve(std::size_t slotCount)
+{
+    while (slots.size() < slotCount) addChunk();
+}
+
+std::uint32_t EntityPool::acquireSlot()
+{
+    if (freeSlots.empty())
+    {
+        platformLog(PLATFORM_LOG_INFO, "Entity pool full at %zu slots, adding a chunk", slots.size());
+        addChunk();
+    }
+    std::uint32_t index = freeSlots.back();
+    freeSlots.pop_back();
+    return index;
+}
+
+void EntityPool::despawn(EntityHandle handle)
+{
+    Character* c = get(handle);
+    if (!c) return;
+    c->~Character();
+    slots[handle.index].alive = false;
+    slots[handle.index].object = nullptr;
+    slots[handle.index].generation++; // every handle to the old character is stale now
+    freeSlots.push_back(handle.index);
+    liveCount--;
+}
+
+void EntityPool::despawn(const Character* c)
+{
+    despawn(handleOf(c));
+}
+
+void EntityPool::clear()
+{
+    for (std::uint32_t i = 0; i < (std::uint32_t)slots.size(); ++i)
+        if (slots[i].alive) despawn(EntityHandle{i, slots[i].generation});
+}
+
+Character* EntityPool::get(EntityHandle handle) const
+{
+    if (handle.index >= slots.size()) return nullptr;
+    const Slot& slot = slots[handle.index];
+    if (!slot.alive || slot.generation != handle.generation) return nullptr;
+    return slot.object;
+}
+
+EntityHandle EntityPool::handleOf(const Character* c) const
+{
+    if (!c) return EntityHandle{};
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(c);
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
+    {
+        if (p < chunks[chunk] || p >= chunks[chunk] + ENTITY_CHUNK_SLOTS * ENTITY_SLOT_SIZE) continue;
+        std::uint32_t index = (std::uint32_t)(chunk * ENTITY_CHUNK_SLOTS + (p - chunks[chunk]) / ENTITY_SLOT_SIZE);
+        if (!slots[index].alive || slots[index].object != c) return EntityHandle{}; // not the character in that slot
+        return EntityHandle{index, slots[index].generation};
+    }
+    return EntityHandle{};
+}
@@ -0,0 +1,120 @@
+/*====================================== entityPool.h ========================================
+  Project: TTRPG Game ?
+  Subsystem: Characters (Entity Pool)
+  Primary Author: Andrew
+  Description: Declares the EntityPool that owns every Character in a play session. Characters
+               are constructed in place inside fixed size slots carved out of arena chunks, so
+               spawning and despawning an enemy is a free list pop/push and never calls the
+               allocator (the chunks themselves are only allocated when the pool grows past its
+               high water mark, and are kept until the pool is destroyed).
+
+               Slots are handed out as EntityHandles (slot index + generation). Despawning bumps
+               the slot's generation, so a handle kept after its character is gone resolves to
+               nullptr instead of a dangling pointer or whatever got spawned in that slot next.
+               Slot addresses never move, so a Character* stays valid until its own despawn.
+
+               clear() ends the session (new game / load) and destroys everything in one go.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "characters.h"
+
+//=============== HEADER GUARD ===============
+#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+#define ENTITY_CHUNK_SLOTS 16            // Slots per arena chunk (the pool grows one chunk at a time)
+#define ENTITY_INVALID_INDEX 0xFFFFFFFFu // EntityHandle::index of a handle that points at nothing
+
+// Every archetype has to fit in one slot
+inline constexpr std::size_t ENTITY_SLOT_SIZE = std::max({sizeof(Student), sizeof(Rat), sizeof(Professor), sizeof(Atilla), sizeof(Zombie)});
+inline constexpr std::size_t ENTITY_SLOT_ALIGN = std::max({alignof(Student), alignof(Rat), alignof(Professor), alignof(Atilla), alignof(Zombie)});
+
+// Stable reference to a pooled character. Stale handles (character despawned) resolve to nullptr.
+struct EntityHandle
+{
+    std::uint32_t index = ENTITY_INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool valid() const { return index != ENTITY_INVALID_INDEX; }
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @author: Andrew
+ * @brief: Owns the characters of a play session in arena backed slots addressed by generational handles.
+ * @version: 1.0
+ */
+class EntityPool
+{
+    public:
+        explicit EntityPool(std::size_t initialSlots = ENTITY_CHUNK_SLOTS);
+        ~EntityPool();
+        EntityPool(const EntityPool&) = delete;
+        EntityPool& operator=(const EntityPool&) = delete;
+
+        //@brief: Constructs a T (Student, Zombie, ...) in a free slot
+        //@return - Handle to the new character
+        template <typename T, typename... Args>
+        EntityHandle spawn(Args&&... args)
+        {
+            static_assert(std::is_base_of<Character, T>::value, "EntityPool only holds Characters");
+            static_assert(sizeof(T) <= ENTITY_SLOT_SIZE && alignof(T) <= ENTITY_SLOT_ALIGN, "add the new class to ENTITY_SLOT_SIZE");
+            std::uint32_t index = acquireSlot();
+            try
+            {
+                // the Character* placement new gives back, the base is not always at the start of a T
+                slots[index].object = new (slotAddress(index)) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                freeSlots.push_back(index); // constructor threw, nothing lives in the slot
+                throw;
+            }
+            slots[index].alive = true;
+            liveCount++;
+            return EntityHandle{index, slots[index].generation};
+        }
+
+        void despawn(EntityHandle handle);       // Destroys the character, stale handles are ignored
+        void despawn(const Character* c);        // Same, for a pointer that came from this pool
+        void clear();                            // Destroys every live character (end of session)
+        void reserve(std::size_t slotCount);     // Grows the arena up front so spawns up to slotCount never allocate
+
+        Character* get(EntityHandle handle) const;          // nullptr if the handle is stale or invalid
+        EntityHandle handleOf(const Character* c) const;    // Handle for a pooled character (invalid if not ours)
+
+        std::size_t live() const { return liveCount; }
+        std::size_t capacity() const { return slots.size(); }
+
+    private:
+        struct Slot
+        {
+            std::uint32_t generation = 1; // starts at 1 so a default EntityHandle never matches
+            bool alive = false;
+            Character* object = nullptr;  // the character in the slot (not always the slot's address)
+        };
+
+        std::uint32_t acquireSlot();
+        void addChunk();
+        void* slotAddress(std::uint32_t index) const
+        {
+            return chunks[index / ENTITY_CHUNK_SLOTS] + (index % ENTITY_CHUNK_SLOTS) * ENTITY_SLOT_SIZE;
+        }
+
+        std::vector<unsigned char*> chunks;  // arena, ENTITY_CHUNK_SLOTS slots each, never moved
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots; // free indices, LIFO so the slot just freed is reused first
+        std::size_t liveCount = 0;
+};
+
+#endif // ENTITYPOOL_H
@@ -0,0 +1,104 @@
+/*===================================== fileWatcher.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: Engine Core (Hot Reload)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the FileWatcher (see fileWatcher.h). Linux only for now, the
+               inotify fd is non blocking and the thread poll()s it with a short timeout so
+               stop() never waits long.
+*/
+#include "fileWatcher.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #define FILEWATCH_SUPPORTED 1
+#else
+    #define FILEWATCH_SUPPORTED 0
+#endif
+
+bool FileWatcher::start(const std::string& dir, const std::vector<std::string>& subdirs)
+{
+    if (running.load()) return true;
+#if FILEWATCH_SUPPORTED
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) return false;
+
+    // editors either rewrite the file (CLOSE_WRITE) or write a temp file and rename it over (MOVED_TO)
+    const std::uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+    watches.clear();
+    const int top = inotify_add_watch(inotifyFd, dir.c_str(), mask);
+    if (top < 0)
+    {
+        close(inotifyFd);
+        inotifyFd = -1;
+        return false;
+    }
+    watches.emplace_back(top, "");
+    for (const std::string& sub : subdirs)
+    {
+        const int wd = inotify_add_watch(inotifyFd, (dir + "/" + sub).c_str(), mask);
+        if (wd >= 0) watches.emplace_back(wd, sub + "/");
+    }
+    running = true;
+    worker = std::thread(&FileWatcher::run, this);
+    return true;
+#else
+    (void)dir;
+    (void)subdirs;
+    return false;
+#endif
+}
+
+void FileWatcher::stop()
+{
+    if (!running.exchange(false)) return;
+    if (worker.joinable()) worker.join();
+#if FILEWATCH_SUPPORTED
+    close(inotifyFd);
+#endif
+    inotifyFd = -1;
+}
+
+std::vector<std::string> FileWatcher::takeChanges()
+{
+    std::vector<std::string> changes;
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    changes.swap(pending);
+    return changes;
+}
+
+void FileWatcher::run()
+{
+#if FILEWATCH_SUPPORTED
+    // big enough for a burst of events, inotify never splits an event across reads
+    alignas(inotify_event) char buffer[4096];
+    while (running.load())
+    {
+        pollfd pfd{inotifyFd, POLLIN, 0};
+        if (poll(&pfd, 1, WATCH_POLL_MS) <= 0) continue;
+
+        ssize_t len;
+        while ((len = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            for (char* p = buffer; p < buffer + len; )
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                auto watch = std::find_if(watches.begin(), watches.end(), [event](const auto& w) { return w.first == event->wd; });
+                if (event->len > 0 && watch != watches.end())
+                {
+                    std::string name = watch->second + event->name;
+                    // one save can fire several events, only report the file once per frame
+                    if (std::find(pending.begin(), pending.end(), name) == pending.end())
+                        pending.push_back(name);
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,66 @@
+/*====================================== fileWatcher.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Engine Core (Hot Reload)
+  Primary Author: Edwin Baiden
+  Description: Watches a directory (dat/) and the subdirectories it is told about (dat/scenes/)
+               on a background thread so data files can be edited while the game is running. On
+               Linux the thread blocks on inotify and queues the name of every file that was
+               written, created, moved in or deleted, relative to the watched directory
+               ("Character_Starting_Stats.csv", "scenes/building1.json"). The game drains the
+               queue once per frame at a safe point (takeChanges()) and reloads only the files
+               that changed. Deeper directories are not watched.
+
+               Everywhere else start() just returns false and takeChanges() stays empty, so the
+               game behaves like it did before (restart to pick up data changes).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//=============== HEADER GUARD ===============
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#define WATCH_POLL_MS 100 // How often the watcher thread checks if it should stop
+
+/**
+ * @author: Edwin Baiden
+ * @brief: Background directory watcher, the main thread picks up changed file names with takeChanges().
+ * @version: 1.0
+ */
+class FileWatcher
+{
+    public:
+        FileWatcher() = default;
+        ~FileWatcher() { stop(); }
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        //@brief: Starts watching dir and its subdirectories subdirs (names relative to dir, not recursive) on a background thread
+        //@return - false if watching is not supported here or dir cant be watched (a subdirectory that cant is skipped)
+        bool start(const std::string& dir, const std::vector<std::string>& subdirs = {});
+
+        //@brief: Stops and joins the watcher thread (safe to call more than once)
+        void stop();
+
+        //@brief: Names (relative to the watched directory) of the files that changed since the last call, each name once
+        std::vector<std::string> takeChanges();
+
+        bool isRunning() const { return running.load(); }
+
+    private:
+        void run();
+
+        std::thread worker;
+        std::atomic<bool> running{false};
+        std::mutex pendingMutex;
+        std::vector<std::string> pending; // guarded by pendingMutex
+        int inotifyFd = -1;
+        std::vector<std::pair<int, std::string>> watches; // inotify watch -> name prefix ("" for dir, "scenes/" ...)
+};
+
+#endif // FILEWATCHER_H
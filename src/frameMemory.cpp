@@ -0,0 +1,159 @@
+/*======================================= frameMemory.cpp ====================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Frame Memory)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the frame arena, the frame bookkeeping and, in TLL_TRACK_ALLOCS
+               builds, the counting global operator new (see frameMemory.h).
+*/
+#include "frameMemory.h"
+
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "platform.h"
+
+namespace {
+    // operator new calls of this thread (plain ints, touching them never allocates)
+    thread_local std::uint64_t threadAllocCount = 0;
+    thread_local std::uint64_t threadAllocBytes = 0;
+
+    FrameArena arena;
+    AllocCounters frameStart;   // main thread counters at frameBegin()
+    bool busyFrame = true;      // the first frames are loading anyway
+    int quietFrames = 0;
+}
+
+#if ALLOC_TRACKING
+//======================= COUNTING OPERATOR NEW =======================
+// Replaces the plain and nothrow forms (the aligned ones keep the library's own new/delete pair).
+// malloc/free underneath, so the deletes below are the matching pair.
+
+static void* CountedAllocate(std::size_t size)
+{
+    ++threadAllocCount;
+    threadAllocBytes += size;
+    if (size == 0) size = 1;
+    for (;;)
+    {
+        if (void* p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* p = CountedAllocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* p = CountedAllocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+#endif
+
+//======================= FRAME ARENA =======================
+
+char* FrameArena::allocate(std::size_t bytes)
+{
+    if (bytes > FRAME_ARENA_BYTES - top)
+    {
+        if (!overflowed) platformLog(PLATFORM_LOG_WARNING, "Frame arena full (%d bytes), text is cut short", FRAME_ARENA_BYTES);
+        overflowed = true;
+        return nullptr;
+    }
+    char* out = buffer + top;
+    top += bytes;
+    if (top > highWater) highWater = top;
+    return out;
+}
+
+const char* FrameArena::format(const char* fmt, ...)
+{
+    const std::size_t room = FRAME_ARENA_BYTES - top;
+    if (room == 0)
+    {
+        allocate(1); // full, this only warns
+        return "";
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    const int length = std::vsnprintf(buffer + top, room, fmt, args); // written in place, kept if it fits
+    va_end(args);
+    if (length < 0) return "";
+
+    if (char* out = allocate((std::size_t)length + 1)) return out;
+    // did not fit: keep the part vsnprintf managed to write (it always ends the text), the arena is full now
+    char* out = buffer + top;
+    top = highWater = FRAME_ARENA_BYTES;
+    return out;
+}
+
+const char* FrameArena::upper(const char* text)
+{
+    const std::size_t length = std::strlen(text);
+    char* out = allocate(length + 1);
+    if (!out) return "";
+    for (std::size_t i = 0; i < length; ++i) out[i] = (char)std::toupper((unsigned char)text[i]);
+    out[length] = '\0';
+    return out;
+}
+
+void FrameArena::reset()
+{
+    top = 0;
+    overflowed = false;
+}
+
+//======================= FRAME BOOKKEEPING =======================
+
+FrameArena& frameArena()
+{
+    return arena;
+}
+
+AllocCounters allocThreadCounters()
+{
+    return {threadAllocCount, threadAllocBytes};
+}
+
+void frameBegin()
+{
+    arena.reset();
+    frameStart = allocThreadCounters();
+}
+
+void frameMarkBusy()
+{
+    busyFrame = true;
+}
+
+FrameReport frameEnd()
+{
+    FrameReport report;
+    const AllocCounters now = allocThreadCounters();
+    report.allocs = {now.count - frameStart.count, now.bytes - frameStart.bytes};
+
+    quietFrames = busyFrame ? 0 : quietFrames + 1;
+    report.steady = quietFrames > ALLOC_SETTLE_FRAMES;
+    busyFrame = false;
+    return report;
+}
@@ -0,0 +1,110 @@
+/*======================================== frameMemory.h =====================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Frame Memory)
+  Primary Author: Edwin Baiden
+  Description: Memory of one frame. Looking at a room or at the player's turn of a fight should
+               not touch the heap at all: nothing changes, the same things get drawn again.
+
+               FrameArena: bump allocator for the text a frame draws (hover text, "Player: <name>",
+               item labels...). Strings live in a fixed buffer until the next frame starts, the
+               whole arena is emptied at once by frameBegin(). Unlike TextFormat (4 rotating
+               buffers) a frame can keep as many as fit in FRAME_ARENA_BYTES.
+
+               Allocation tracking (build with "make TRACK_ALLOCS=1", defines TLL_TRACK_ALLOCS):
+               the global operator new counts every allocation per thread, so the main thread's
+               count per frame can be checked. A frame is steady once nothing happened for
+               ALLOC_SETTLE_FRAMES frames (no input, no state change, no save finishing... the
+               screen manager marks those with frameMarkBusy()), a steady exploration or combat
+               frame that allocates is reported ("make TRACK_ALLOCS=strict" stops the game on the
+               first one). "make alloc-check" plays a room and a player turn in a hidden window
+               and fails if a steady frame allocated (ScreenManager::runAllocationCheck).
+               Only operator new is counted, raylib's own malloc calls are not (its per frame
+               buffers are allocated once).
+
+               Main thread only, except the allocation counters (every thread keeps its own).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <cstdint>
+
+//=============== HEADER GUARD ===============
+#ifndef FRAMEMEMORY_H
+#define FRAMEMEMORY_H
+
+#define FRAME_ARENA_BYTES (16 * 1024) // Text one frame can draw (a busy combat frame uses ~1 KB)
+#define ALLOC_SETTLE_FRAMES 30        // Quiet frames before frames count as steady (one-off work can finish a frame or two late)
+
+#ifdef TLL_TRACK_ALLOCS
+    #define ALLOC_TRACKING 1
+#else
+    #define ALLOC_TRACKING 0
+#endif
+
+/**
+ * @author: Edwin Baiden
+ * @brief: Bump allocator for the strings of one frame, emptied by frameBegin()
+ * @version: 1.0
+ */
+class FrameArena
+{
+    public:
+        //@brief: printf style text that stays valid until the next frame (cut short if the arena is full)
+        const char* format(const char* fmt, ...)
+#if defined(__GNUC__) || defined(__clang__)
+            __attribute__((format(printf, 2, 3)))
+#endif
+            ;
+
+        //@brief: Uppercase copy of text, valid until the next frame
+        const char* upper(const char* text);
+
+        //@brief: Forgets every string (start of a frame)
+        void reset();
+
+        std::size_t used() const { return top; }
+        std::size_t peak() const { return highWater; } // most a frame has used so far
+
+    private:
+        char buffer[FRAME_ARENA_BYTES];
+        std::size_t top = 0;
+        std::size_t highWater = 0;
+        bool overflowed = false; // warned once per frame that ran out
+
+        //@brief: Room for bytes more (nullptr if the arena is full)
+        char* allocate(std::size_t bytes);
+};
+
+//@author: Edwin Baiden
+//@brief: operator new calls and bytes (of one thread, or of one frame)
+//@version: 1.0
+struct AllocCounters
+{
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+//@author: Edwin Baiden
+//@brief: What frameEnd() found
+//@version: 1.0
+struct FrameReport
+{
+    AllocCounters allocs;   // main thread allocations since frameBegin() (zeros without TLL_TRACK_ALLOCS)
+    bool steady = false;    // nothing happened this frame nor in the ALLOC_SETTLE_FRAMES before it
+};
+
+//@brief: The arena of the frame being drawn
+FrameArena& frameArena();
+
+//@brief: operator new calls the calling thread made so far (zeros without TLL_TRACK_ALLOCS)
+AllocCounters allocThreadCounters();
+
+//@brief: Start of a frame: the arena is emptied and the allocation count starts over
+void frameBegin();
+
+//@brief: Something happened this frame (input, a state change, a save finishing...), it and the next ALLOC_SETTLE_FRAMES are not steady
+void frameMarkBusy();
+
+//@brief: End of a frame: its allocations and whether it was steady
+FrameReport frameEnd();
+
+#endif // FRAMEMEMORY_H
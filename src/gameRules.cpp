@@ -0,0 +1,159 @@
+/*====================================== gameRules.cpp =======================================
+  Project: TTRPG Game ?
+  Subsystem: Game Rules
+  Primary Author: Edwin Baiden
+  Description: Implementation of the rules the game and the headless sessions share (see gameRules.h).
+*/
+#include "gameRules.h"
+
+#include <cstdlib>
+#include <string>
+
+bool roomStartsFight(const GameScene& room, const std::map<int,bool>& battleWon)
+{
+    if (!room.hasEncounter) return false;
+    auto battle = battleWon.find(room.encounterID);
+    return battle == battleWon.end() || !battle->second;
+}
+
+EncounterEnemy encounterEnemy(const GameScene* room, int encounterID)
+{
+    // encounter 0 = professor zombie, 1 = sorority zombie, 2 (or anything else) = frat bro zombie
+    EncounterEnemy enemy;
+    enemy.name = encounterID == 0 ? "Professor" : encounterID == 1 ? "Sorority" : "Frat Bro";
+    enemy.statID = room && room->hasEncounter && room->encounterID == encounterID && room->enemyStatID[0]
+        ? room->enemyStatID : ENCOUNTER_DEFAULT_ENEMY;
+    return enemy;
+}
+
+void pickUpItem(Character& player, ItemID item, ItemSet& collectedItems)
+{
+    collectedItems.set((std::size_t)item);
+    if (item == ItemID::HealthPotion)
+    {
+        if (PlayerCharacter* p = asPlayer(&player)) p->inv.additem(HealthPotion());
+    }
+    if (item == ItemID::BaseballBat)
+    {
+        // baseball bat boosts your weapon stats (every class keeps its weapons in Character::wep)
+        player.wep.meleeWeapon += 2;
+        player.wep.rangeWeapon += 1;
+    }
+}
+
+void recordVictory(int encounterID, Character& player, std::map<int,bool>& battleWon)
+{
+    battleWon[encounterID] = true;
+    PlayerCharacter* p = asPlayer(&player);
+    if (!p) return;
+    if (encounterID == 0) p->zombie1Defeated = true;
+    if (encounterID == 1) p->zombie2Defeated = true;
+    if (encounterID == 2) p->zombie3Defeated = true;
+}
+
+FightOutcome fightOutcome(std::vector<std::string>& log, Character* const* entities)
+{
+    if (!entities[0]->isAlive())
+    {
+        AddNewLogEntry(log, "You died.");
+        return FightOutcome::PlayerDied;
+    }
+    if (!entities[1]->isAlive())
+    {
+        AddNewLogEntry(log, "You have defeated " + entities[1]->getName() + "!");
+        return FightOutcome::EnemyDefeated;
+    }
+    return FightOutcome::Going;
+}
+
+bool playerAttack(CombatHandler& fight, Character* const* entities, bool ranged)
+{
+    fight.playerIsDefending = false;
+    entities[0]->endDefense();
+
+    AttackRoll rolls;
+    const std::int8_t enemyHPBefore = entities[1]->vit.health;
+    const bool hit = ranged ? resolve_ranged(*entities[0], *entities[1], fight.enemyIsDefending, fight.log, &rolls)
+                            : resolve_melee(*entities[0], *entities[1], fight.enemyIsDefending, fight.log, &rolls);
+    fight.journal.record(ranged ? JournalAction::Ranged : JournalAction::Melee, JOURNAL_PLAYER, rolls, enemyHPBefore,
+                         entities[1]->vit.health, entities[0]->isDefending(), entities[1]->isDefending());
+    fight.playerTurn = false;
+    return hit;
+}
+
+void playerDefend(CombatHandler& fight, Character* const* entities)
+{
+    fight.playerIsDefending = true;
+    fight.journal.record(JournalAction::Defend, JOURNAL_PLAYER, AttackRoll{}, entities[0]->vit.health, entities[0]->vit.health,
+                         entities[0]->isDefending(), entities[1]->isDefending());
+    entities[0]->startDefense(); // activate defense buff
+    AddNewLogEntry(fight.log, entities[0]->getName() + " is defending!");
+    fight.playerTurn = false;
+}
+
+void playerUseItem(CombatHandler& fight, Character* const* entities, Item item)
+{
+    PlayerCharacter* player = asPlayer(entities[0]);
+    fight.playerIsDefending = false;
+    player->endDefense();
+
+    const int beforeHeal = player->vit.health;
+    player->heal(item.healAmount);
+    fight.journal.record(JournalAction::UseItem, JOURNAL_PLAYER, AttackRoll{0, (std::uint8_t)(player->vit.health - beforeHeal), false},
+                         (std::int8_t)beforeHeal, player->vit.health, player->isDefending(), entities[1]->isDefending());
+    AddNewLogEntry(fight.log, player->getName() + " used " + item.name() + " and healed " +
+                   std::to_string(player->vit.health - beforeHeal) + " HP!");
+    player->inv.removeitem(item.id, 1); // use up the item (item is a copy, the bag can move its entries)
+    fight.playerTurn = false;
+}
+
+FightOutcome enemyTurn(CombatHandler& fight, Character* const* entities, const Action& action, bool* playerHit)
+{
+    if (playerHit) *playerHit = false;
+
+    // end enemy defense if they were defending last turn
+    if (fight.enemyIsDefending) entities[1]->endDefense();
+    fight.enemyIsDefending = false;
+
+    if (action.type == ActionType::Attack || action.type == ActionType::UseRange)
+    {
+        // enemy attacks (melee or ranged)
+        AttackRoll rolls;
+        const std::int8_t playerHPBefore = entities[0]->vit.health;
+        const bool hit = action.type == ActionType::Attack
+            ? resolve_melee(*entities[1], *entities[0], fight.playerIsDefending, fight.log, &rolls)
+            : resolve_ranged(*entities[1], *entities[0], fight.playerIsDefending, fight.log, &rolls);
+        fight.journal.record(action.type == ActionType::Attack ? JournalAction::Melee : JournalAction::Ranged,
+                             JOURNAL_ENEMY, rolls, playerHPBefore, entities[0]->vit.health,
+                             entities[0]->isDefending(), entities[1]->isDefending());
+        if (playerHit) *playerHit = hit;
+        const FightOutcome outcome = fightOutcome(fight.log, entities);
+        if (outcome != FightOutcome::Going) return outcome;
+    }
+    else if (action.type == ActionType::Defend)
+    {
+        fight.enemyIsDefending = true;
+        fight.journal.record(JournalAction::Defend, JOURNAL_ENEMY, AttackRoll{}, entities[1]->vit.health, entities[1]->vit.health,
+                             entities[0]->isDefending(), entities[1]->isDefending());
+        entities[1]->startDefense();
+        AddNewLogEntry(fight.log, entities[1]->getName() + " is defending!");
+    }
+
+    // end of the round: poison/burn/regen and effect timers for both sides in one pass
+    int hpChange[2];
+    const std::int8_t hpBeforeTick[2] = {entities[0]->vit.health, entities[1]->vit.health};
+    tickStatusEffects(entities, 2, hpChange);
+    for (int i = 0; i < 2; ++i)
+    {
+        // journaled every round, also without an HP change: the replay re-runs the tick at each of these (combatJournal.h)
+        fight.journal.record(JournalAction::StatusTick, i == 0 ? JOURNAL_PLAYER : JOURNAL_ENEMY, AttackRoll{},
+                             hpBeforeTick[i], entities[i]->vit.health, entities[0]->isDefending(), entities[1]->isDefending());
+        if (hpChange[i] == 0) continue;
+        AddNewLogEntry(fight.log, entities[i]->getName() + (hpChange[i] < 0 ? " loses " : " recovers ") +
+                       std::to_string(std::abs(hpChange[i])) + " HP from status effects.");
+    }
+
+    const FightOutcome outcome = fightOutcome(fight.log, entities);
+    if (outcome == FightOutcome::Going) fight.playerTurn = true; // back to player turn
+    return outcome;
+}
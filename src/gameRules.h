@@ -0,0 +1,85 @@
+/*======================================== gameRules.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Game Rules
+  Primary Author: Edwin Baiden
+  Description: The rules of a run that the game (GameManager, screenManager.cpp) and the
+               headless sessions (GameSession, gameSession.cpp) both play by: which rooms start a
+               fight, who an encounter spawns, what picking an item up does, the player's and the
+               enemy's turns (dice, journal records, log lines, the status tick at the end of the
+               round) and what winning a fight changes. Everything here works on the state it is
+               handed, the callers keep their own (file statics in the game, members in a session)
+               and only add what is theirs: sounds, flashes and delays on screen, the reply text
+               and the session state in a session.
+
+               Like sceneGraph.cpp this needs raylib.h for the scene types only, nothing of raylib
+               is called, so the server links it without a window.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstdint>
+#include <map>
+
+//======================= PROJECT INCLUDES =======================
+#include "characters.h"
+#include "combat.h"
+#include "itemRegistry.h"
+#include "sceneGraph.h"
+
+//=============== HEADER GUARD ===============
+#ifndef GAMERULES_H
+#define GAMERULES_H
+
+#define ENCOUNTER_DEFAULT_ENEMY "Zombie_Standard" // Enemy stats of an encounter whose room names none
+
+//@author: Edwin Baiden
+//@brief: Who an encounter spawns: the name (and sprite) from the encounter, the stats from the room
+//@version: 1.0
+struct EncounterEnemy
+{
+    const char* name;
+    const char* statID; // CSV ID of the starting stats
+};
+
+//@author: Edwin Baiden
+//@brief: Where a fight stands after an action (Going until one side is down)
+//@version: 1.0
+enum class FightOutcome : std::uint8_t { Going, PlayerDied, EnemyDefeated };
+
+//@brief: Whether walking into room starts a fight (it has an encounter that is not won yet). A lookup only, never adds to battleWon
+bool roomStartsFight(const GameScene& room, const std::map<int,bool>& battleWon);
+
+//@brief: The enemy encounterID spawns, room is the fight's room (nullptr or another encounter's room = the default stats)
+EncounterEnemy encounterEnemy(const GameScene* room, int encounterID);
+
+//@brief: Picks item up: its collected bit (keys need nothing else, the bit opens the doors), a potion goes in the bag,
+//        the bat upgrades the weapons
+void pickUpItem(Character& player, ItemID item, ItemSet& collectedItems);
+
+//@brief: Marks encounterID won, on the map and on the player's defeat flags (what a save keeps)
+void recordVictory(int encounterID, Character& player, std::map<int,bool>& battleWon);
+
+//@brief: Whether the fight is over, adds the line that says so to the log (the player dying comes first)
+FightOutcome fightOutcome(std::vector<std::string>& log, Character* const* entities);
+
+//@brief: Player's melee (ranged = false) or ranged attack on the enemy, journaled
+//@return - True if it hit
+bool playerAttack(CombatHandler& fight, Character* const* entities, bool ranged);
+
+//@brief: Player starts defending, journaled
+void playerDefend(CombatHandler& fight, Character* const* entities);
+
+//@brief: Player drinks a healing item (the caller checks the item heals and the player is not at full health), journaled
+//        and taken out of the bag
+void playerUseItem(CombatHandler& fight, Character* const* entities, Item item);
+
+/**
+ * @author: Edwin Baiden
+ * @brief: The enemy's turn: its defense from last turn ends, action plays out (whatever the caller's search picked),
+ *         then the end of the round ticks both sides' status effects. Every step is journaled and logged, and the turn
+ *         goes back to the player unless the fight is over.
+ * @param playerHit - Set to whether an enemy attack hit (the game flashes the player), optional
+ * @return - Where the fight stands
+ * @version: 1.0
+ */
+FightOutcome enemyTurn(CombatHandler& fight, Character* const* entities, const Action& action, bool* playerHit = nullptr);
+
+#endif // GAMERULES_H
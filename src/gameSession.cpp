@@ -0,0 +1,351 @@
+/*======================================= gameSession.cpp ====================================
+  Project: TTRPG Game ?
+  Subsystem: Headless Sessions
+  Primary Author: Edwin Baiden
+  Description: Implementation of the headless session (see gameSession.h). The rules come from
+               gameRules.h, the same ones GameManager in screenManager.cpp calls, only with the
+               session's own state instead of the file statics and without anything on screen.
+*/
+#include "gameSession.h"
+
+#include "combatAI.h"
+#include "gameRules.h"
+#include "progressLog.h"
+#include "saveData.h"
+#include "sceneGen.h"
+#include "startingStats.gen.h"
+
+//======================= SESSION WORLD =======================
+
+//@brief: Load hook of the world's library, the same layout the game plays (SCENE_LAYOUT_SEED)
+static void ApplySessionLayout(Building& building)
+{
+    std::string error;
+    if (!applyLayoutSeed(building, GENERATED_STAT_ROWS, STATS_ROW_COUNT, SCENE_LAYOUT_SEED, error))
+        platformLog(PLATFORM_LOG_WARNING, "Layout: %s, keeping the authored one", error.c_str());
+}
+
+bool SessionWorld::load(std::string& error)
+{
+    library.setLoadHook(ApplySessionLayout);
+    buildings.clear();
+    for (int index = 0; index < SCENE_MAX_BUILDINGS; ++index)
+    {
+        const Building* building = library.building(index);
+        if (!building) break;
+        buildings.push_back(building);
+    }
+    if (buildings.empty()) error = library.error();
+    return !buildings.empty();
+}
+
+const GameScene* SessionWorld::scene(int sceneId) const
+{
+    const int index = SCENE_BUILDING(sceneId);
+    if (sceneId < 0 || index >= (int)buildings.size()) return nullptr;
+    const Building& building = *buildings[index];
+    return SCENE_ROOM(sceneId) < (int)building.scenes.size() ? &building.scenes[SCENE_ROOM(sceneId)] : nullptr;
+}
+
+//======================= GAME SESSION =======================
+
+//@brief: Dice seed of a session's fight, both numbers go through one splitmix64 round so sessions with consecutive seeds
+//        never share a fight's dice (seed + fight number made session S fight k+1 the same fight as session S+1 fight k)
+static std::uint32_t FightSeed(std::uint32_t sessionSeed, int fight)
+{
+    std::uint64_t z = ((std::uint64_t)sessionSeed << 32 | (std::uint32_t)fight) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (std::uint32_t)(z ^ (z >> 32));
+}
+
+const char* sessionStateName(SessionState state)
+{
+    switch (state)
+    {
+        case SessionState::Idle: return "idle";
+        case SessionState::Exploration: return "exploring";
+        case SessionState::Combat: return "fighting";
+        case SessionState::Ended: return "ended";
+        case SessionState::Dead: return "dead";
+    }
+    return "?";
+}
+
+GameSession::GameSession(const SessionWorld& sessionWorld, std::uint32_t seed)
+    : world(sessionWorld), sessionSeed(seed ? seed : new_rng_seed())
+{
+    rng.eng.seed(sessionSeed);
+    rng.state = RngState{sessionSeed, 0};
+}
+
+GameSession::~GameSession() = default; // combat before pool (members go in reverse order), the pool destroys the characters
+
+bool GameSession::isArrowOpen(const SceneArrow& arrow) const
+{
+    return arrow.isEnabled && (arrow.requiredKey == ItemID::None || collectedItems.test((std::size_t)arrow.requiredKey));
+}
+
+bool GameSession::isItemVisible(const GameScene& room, const SceneItem& item) const
+{
+    if (collectedItems.test((std::size_t)item.item)) return false;
+    if (!item.requiresVictory) return true;
+    auto battle = battleWon.find(room.encounterID);
+    return room.hasEncounter && battle != battleWon.end() && battle->second;
+}
+
+SessionResult GameSession::start(const std::string& characterID, const std::string& name)
+{
+    RngScope dice(rng);
+    if (!archetypeInfo(archetypeFromID(characterID)).player) return {false, characterID + " is not a player class"};
+
+    combat.reset();
+    pool.clear();
+    entities[0] = entities[1] = nullptr;
+    battleWon.clear();
+    collectedItems.reset();
+    activeEncounterID = -1;
+    currentSceneIndex = savedPlayerSceneIndex = SCENE_START_ID;
+    fightsStarted = 0;
+
+    CreateCharacter(pool, entities, world.stats(), characterID, name.empty() ? characterID : name);
+    if (!entities[0])
+    {
+        current = SessionState::Idle;
+        return {false, "could not create " + characterID};
+    }
+    return enterRoom(SCENE_START_ID);
+}
+
+SessionResult GameSession::enterRoom(int sceneId)
+{
+    const GameScene* room = world.scene(sceneId);
+    if (!room) return {false, "there is no room " + std::to_string(sceneId)};
+    currentSceneIndex = sceneId;
+
+    if (room->isEnding)
+    {
+        current = SessionState::Ended;
+        return {true, std::string(room->sceneName) + ": you made it out"};
+    }
+    if (roomStartsFight(*room, battleWon))
+    {
+        savedPlayerSceneIndex = currentSceneIndex;
+        activeEncounterID = room->encounterID;
+        startFight();
+        return combat ? combatResult() : look();
+    }
+    current = SessionState::Exploration;
+    return look();
+}
+
+void GameSession::startFight()
+{
+    const EncounterEnemy enemy = encounterEnemy(scene(), activeEncounterID);
+    if (!entities[1]) CreateCharacter(pool, entities, world.stats(), enemy.statID, enemy.name); // a loaded save brings its enemy
+    if (!entities[1])
+    {
+        activeEncounterID = -1; // cant fight nothing, same fallback as the game
+        current = SessionState::Exploration;
+        return;
+    }
+
+    combat = std::make_unique<CombatHandler>();
+    combat->playerTurn = entities[0]->cbt.initiative >= entities[1]->cbt.initiative; // higher initiative goes first
+    AddNewLogEntry(combat->log, "A wild " + entities[1]->getName() + " appears!");
+
+    // the fight's dice come from the session seed, so the same seed and commands fight the same fights
+    const std::uint32_t fightSeed = FightSeed(sessionSeed, ++fightsStarted);
+    seed_rng(fightSeed);
+    combat->journal.begin(fightSeed, *entities[0], *entities[1]);
+    current = SessionState::Combat;
+
+    if (!combat->playerTurn) enemyTurn();
+}
+
+SessionResult GameSession::look() const
+{
+    const GameScene* room = scene();
+    if (current == SessionState::Idle || !room || !entities[0]) return {false, "no run yet (start one)"};
+
+    const Character& player = *entities[0];
+    std::string text = std::string(sessionStateName(current)) + " \"" + room->sceneName + "\" hp " +
+                       std::to_string(player.vit.health) + "/" + std::to_string(player.vit.maxHealth);
+
+    if (current == SessionState::Combat && entities[1])
+    {
+        text += " vs " + entities[1]->getName() + " hp " + std::to_string(entities[1]->vit.health) + "/" + std::to_string(entities[1]->vit.maxHealth);
+        text += combat && combat->playerTurn ? " (your turn)" : " (enemy turn)";
+    }
+    else if (current == SessionState::Exploration)
+    {
+        text += " exits [";
+        for (std::size_t i = 0; i < room->sceneArrows.size(); ++i)
+        {
+            const SceneArrow& arrow = room->sceneArrows[i];
+            if (!arrow.isEnabled) continue;
+            const GameScene* target = world.scene(arrow.targetSceneIndex);
+            text += " " + std::to_string(i) + ":" + (target ? target->sceneName : "?") + (isArrowOpen(arrow) ? "" : "(locked)");
+        }
+        text += " ] floor [";
+        for (std::size_t i = 0; i < room->sceneItems.size(); ++i)
+            if (isItemVisible(*room, room->sceneItems[i])) text += " " + std::to_string(i) + ":" + itemInfo(room->sceneItems[i].item).name;
+        text += " ]";
+    }
+
+    if (const PlayerCharacter* p = asPlayer(entities[0]))
+    {
+        text += " bag [";
+        const auto& items = p->inv.getItems();
+        for (std::size_t i = 0; i < items.size(); ++i)
+            text += " " + std::to_string(i) + ":" + items[i].name() + "x" + std::to_string(items[i].quantity);
+        text += " ]";
+    }
+    return {true, text};
+}
+
+SessionResult GameSession::go(int arrow)
+{
+    RngScope dice(rng);
+    const GameScene* room = scene();
+    if (current != SessionState::Exploration || !room) return {false, std::string("cant walk while ") + sessionStateName(current)};
+    if (arrow < 0 || arrow >= (int)room->sceneArrows.size() || !room->sceneArrows[arrow].isEnabled) return {false, "no exit " + std::to_string(arrow)};
+    if (!isArrowOpen(room->sceneArrows[arrow])) return {false, "locked, it needs " + std::string(itemInfo(room->sceneArrows[arrow].requiredKey).name)};
+    return enterRoom(room->sceneArrows[arrow].targetSceneIndex);
+}
+
+SessionResult GameSession::take(int item)
+{
+    const GameScene* room = scene();
+    if (current != SessionState::Exploration || !room) return {false, std::string("cant pick things up while ") + sessionStateName(current)};
+    if (item < 0 || item >= (int)room->sceneItems.size() || !isItemVisible(*room, room->sceneItems[item])) return {false, "nothing to take at " + std::to_string(item)};
+
+    const ItemID id = room->sceneItems[item].item;
+    pickUpItem(*entities[0], id, collectedItems); // same as a click on the item
+    return {true, std::string("took ") + itemInfo(id).name};
+}
+
+SessionResult GameSession::melee()
+{
+    RngScope dice(rng);
+    if (current != SessionState::Combat || !combat->playerTurn) return {false, "not your turn to fight"};
+    combat->log.clear();
+    playerAttack(*combat, entities, false);
+    playerActed();
+    return combatResult();
+}
+
+SessionResult GameSession::ranged()
+{
+    RngScope dice(rng);
+    if (current != SessionState::Combat || !combat->playerTurn) return {false, "not your turn to fight"};
+    combat->log.clear();
+    playerAttack(*combat, entities, true);
+    playerActed();
+    return combatResult();
+}
+
+SessionResult GameSession::defend()
+{
+    RngScope dice(rng);
+    if (current != SessionState::Combat || !combat->playerTurn) return {false, "not your turn to fight"};
+    combat->log.clear();
+    playerDefend(*combat, entities);
+    playerActed();
+    return combatResult();
+}
+
+SessionResult GameSession::useItem(int item)
+{
+    RngScope dice(rng);
+    if (current != SessionState::Combat || !combat->playerTurn) return {false, "items are used on your turn in a fight"};
+    PlayerCharacter* player = asPlayer(entities[0]);
+    const auto& items = player->inv.getItems();
+    if (item < 0 || item >= (int)items.size()) return {false, "no item " + std::to_string(item) + " in the bag"};
+    const Item used = items[item];
+    if (used.healAmount == 0) return {false, std::string(used.name()) + " does nothing in a fight"};
+    if (player->vit.health == player->vit.maxHealth) return {false, "health is already full"}; // the turn is not used up, like in the game
+
+    combat->log.clear();
+    playerUseItem(*combat, entities, used);
+    playerActed();
+    return combatResult();
+}
+
+void GameSession::playerActed()
+{
+    if (fightOutcome(combat->log, entities) != FightOutcome::Going) endFight();
+    else enemyTurn();
+}
+
+void GameSession::enemyTurn()
+{
+    // the planner's search, run right here to a fixed depth (same as the console engine, load cannot change the move)
+    const Action enemyAction = searchToDepth(snapshotCombat(*entities[1], *entities[0]), AI_SYNC_SEARCH_DEPTH);
+    if (::enemyTurn(*combat, entities, enemyAction) != FightOutcome::Going) endFight();
+}
+
+void GameSession::endFight()
+{
+    if (!entities[0]->isAlive())
+    {
+        current = SessionState::Dead; // the fight stays on the record, only a load gets out of here
+    }
+    else
+    {
+        recordVictory(activeEncounterID, *entities[0], battleWon);
+        activeEncounterID = -1;
+        current = SessionState::Exploration;
+    }
+
+    if (!journalPrefix.empty() && !combat->journal.writeTo(journalPrefix + std::to_string(fightsStarted) + ".tlj"))
+        platformLog(PLATFORM_LOG_WARNING, "Session %u: could not write the journal of fight %d", sessionSeed, fightsStarted);
+    pool.despawn(entities[1]);
+    entities[1] = nullptr;
+    // combat stays until the reply is built (combatResult), the next fight replaces it
+}
+
+SessionResult GameSession::combatResult()
+{
+    SessionResult result;
+    if (combat)
+    {
+        for (const std::string& line : combat->log) result.text += (result.text.empty() ? "" : " / ") + line;
+        combat->log.clear();
+        if (current != SessionState::Combat) combat.reset();
+    }
+    if (current == SessionState::Dead) result.text += " / dead";
+    return result;
+}
+
+SessionResult GameSession::save(const std::string& path) const
+{
+    if (current != SessionState::Exploration && current != SessionState::Ended) return {false, std::string("cant save while ") + sessionStateName(current)};
+    SaveData data;
+    packSaveData(const_cast<Character**>(entities), currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems, data);
+    if (!writeSaveFile(path, data)) return {false, "could not write the save"};
+    return {true, "saved"};
+}
+
+SessionResult GameSession::load(const std::string& path)
+{
+    RngScope dice(rng);
+    SaveData data;
+    if (!readSaveState(path, data)) return {false, "no save"};
+    if (!isPlayerSave(data)) return {false, "save is not a player's"}; // checked first, the running session is left alone
+
+    combat.reset();
+    pool.clear();
+    entities[0] = entities[1] = nullptr;
+    battleWon.clear();
+    collectedItems.reset();
+    unpackSaveData(data, pool, entities, world.stats(), currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems);
+    SessionResult result = enterRoom(currentSceneIndex); // a save made on the way into a fight goes straight back into it
+    if (current != SessionState::Combat && entities[1])
+    {
+        pool.despawn(entities[1]); // enemy of a fight that is already won
+        entities[1] = nullptr;
+    }
+    return result;
+}
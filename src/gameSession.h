@@ -0,0 +1,164 @@
+/*======================================== gameSession.h =====================================
+  Project: TTRPG Game ?
+  Subsystem: Headless Sessions
+  Primary Author: Edwin Baiden
+  Description: One run of the game without a window. GameSession is the exploration, combat,
+               items and saves flow of the screen manager driven by commands instead of clicks,
+               with all of its state inside the object (the game keeps the same state in file
+               statics in screenManager.cpp, which is fine for one run per process). A session
+               owns its characters (EntityPool), its dice (RngStream), its world (room, keys,
+               battles) and its fight, so any number of them can run side by side. The headless
+               server (sessionServer.cpp) runs thousands for tournaments and automated tests.
+
+               The rules are the game's own: the same rooms (SessionWorld loads the buildings once
+               and every session reads them), room, item and turn rules (gameRules.h, the game
+               calls the same functions), combat engine (combat.h), enemy AI (combatAI.h, searched
+               on the calling thread to AI_SYNC_SEARCH_DEPTH, no clock) and save format
+               (progressLog.h). What the screens spread out over time (the enemy's thinking
+               delay, hit flashes, fades) means nothing here: a player action returns after the
+               enemy answered it.
+
+               The same seed and the same commands play the same run: every fight is seeded from
+               the session seed and the number of the fight (the game draws a fresh seed per
+               fight instead). The enemy search always goes AI_SYNC_SEARCH_DEPTH deep, so a heavily
+               loaded machine picks the same moves as an idle one.
+
+               Not thread safe: one thread at a time per session. The session binds its dice to
+               the calling thread for every command (RngScope), so which thread that is does not
+               matter.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "characters.h"
+#include "combat.h"
+#include "entityPool.h"
+#include "itemRegistry.h"
+#include "rng.h"
+#include "sceneGraph.h"
+
+//=============== HEADER GUARD ===============
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+//@author: Edwin Baiden
+//@brief: Where a session is (Idle until start()/load(), Ended in the ending room, Dead after losing a fight)
+//@version: 1.0
+enum class SessionState : std::uint8_t { Idle, Exploration, Combat, Ended, Dead };
+
+//@brief: Readable name of a session state (server replies)
+const char* sessionStateName(SessionState state);
+
+//@author: Edwin Baiden
+//@brief: Answer to one command (text is one line: what happened, or why nothing did)
+//@version: 1.0
+struct SessionResult
+{
+    bool ok = true;
+    std::string text;
+};
+
+/**
+ * @author: Edwin Baiden
+ * @brief: The rooms and starting stats every session plays with, loaded once and read only after that
+ * @version: 1.0
+ */
+class SessionWorld
+{
+    public:
+        explicit SessionWorld(std::string sceneDirectory) : library(std::move(sceneDirectory)) {}
+
+        //@brief: Loads every building (building1, building2, ... up to the first one missing) with the layout seed applied
+        //@return - False if not even the first building loads
+        bool load(std::string& error);
+
+        //@brief: Room by scene ID, nullptr if its building was not loaded (never loads, safe from any thread)
+        const GameScene* scene(int sceneId) const;
+
+        const StatTable& stats() const { return statTable; }
+        int buildingCount() const { return (int)buildings.size(); }
+
+    private:
+        SceneLibrary library;
+        StatTable statTable;                    // built in rows (sessions never see the override CSV)
+        std::vector<const Building*> buildings; // by index, owned by library
+};
+
+/**
+ * @author: Edwin Baiden
+ * @brief: One headless run: exploration, fights, items and saves, everything it needs inside it
+ * @version: 1.0
+ */
+class GameSession
+{
+    public:
+        //@brief: A session on world, rolling dice seeded with seed (0 = a fresh random seed)
+        GameSession(const SessionWorld& world, std::uint32_t seed);
+        ~GameSession();
+        GameSession(const GameSession&) = delete;
+        GameSession& operator=(const GameSession&) = delete;
+
+        //@brief: New run with a player class (CSV ID: Student, Rat, Professor, Attila) in the first room
+        SessionResult start(const std::string& characterID, const std::string& name);
+
+        //@brief: The room (exits, items, fight) or the fight (both sides' health, the player's items)
+        SessionResult look() const;
+
+        //@brief: Exploration: walk through the room's arrow (index as look lists them), a fight there starts right away
+        SessionResult go(int arrow);
+
+        //@brief: Exploration: picks up the room's item (index as look lists them)
+        SessionResult take(int item);
+
+        //@brief: Combat: the player's turn, answered by the enemy's (and the end of the round) before returning
+        SessionResult melee();
+        SessionResult ranged();
+        SessionResult defend();
+        SessionResult useItem(int item);
+
+        //@brief: Writes / reads a binary save (same format as the game's save slots), not during a fight
+        SessionResult save(const std::string& path) const;
+        SessionResult load(const std::string& path);
+
+        //@brief: Every fight's journal gets written to pathPrefix<fight>.tlj when it ends ("" = journals are dropped)
+        void keepJournals(std::string pathPrefix) { journalPrefix = std::move(pathPrefix); }
+
+        SessionState state() const { return current; }
+        std::uint32_t seed() const { return sessionSeed; }
+        int fights() const { return fightsStarted; }
+
+    private:
+        const SessionWorld& world;
+        std::uint32_t sessionSeed;
+        RngStream rng;                              // this session's dice, bound around every command
+        EntityPool pool;
+        Character* entities[2] = {nullptr, nullptr}; // player, enemy (both in pool)
+        int currentSceneIndex = SCENE_START_ID;
+        int activeEncounterID = -1;
+        int savedPlayerSceneIndex = SCENE_START_ID;
+        std::map<int, bool> battleWon;
+        ItemSet collectedItems;
+        std::unique_ptr<CombatHandler> combat;      // only while fighting
+        int fightsStarted = 0;
+        SessionState current = SessionState::Idle;
+        std::string journalPrefix;
+
+        const GameScene* scene() const { return world.scene(currentSceneIndex); }
+        bool isArrowOpen(const SceneArrow& arrow) const;
+        bool isItemVisible(const GameScene& room, const SceneItem& item) const;
+
+        SessionResult enterRoom(int sceneId);   // after a move or a load: ending, fight, or just the room
+        void startFight();
+        void playerActed();                     // enemy answers, round ends, fight may be over
+        void enemyTurn();                       // search the enemy's move, then play it (gameRules.h enemyTurn)
+        void endFight();                        // victory or death, the fight state goes
+        SessionResult combatResult();           // log lines of this command as the reply
+};
+
+#endif // GAMESESSION_H
@@ -0,0 +1,65 @@
+/*====================================== genSceneBlob.cpp ====================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Build Tool)
+  Primary Author: Edwin Baiden
+  Description: Build step that compiles a building's JSON (dat/scenes/building<N>.json) into the
+               binary blob the game loads (building<N>.tlb, see sceneGraph.h). The Makefile runs
+               it whenever the JSON changes. Broken JSON, unknown rooms/items/keys and arrows into
+               buildings that do not exist fail the build instead of the game.
+
+               Usage:
+                    ./GenSceneBlob <building<N>.json> <output.tlb>
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "sceneGraph.h"
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <building<N>.json> <output.tlb>\n";
+        return 2;
+    }
+    const std::string jsonPath = argv[1];
+
+    // the building number comes from the file name, it is the high byte of every scene ID in it
+    const std::string file = jsonPath.substr(jsonPath.find_last_of("/\\") + 1);
+    int number = 0;
+    if (std::sscanf(file.c_str(), "building%d.json", &number) != 1 || number < 1 || number > SCENE_MAX_BUILDINGS)
+    {
+        std::cerr << jsonPath << ": building files are named building<N>.json (1.." << SCENE_MAX_BUILDINGS << ")\n";
+        return 1;
+    }
+
+    std::vector<char> blob;
+    std::string error;
+    if (!compileSceneJson(jsonPath, number - 1, blob, error))
+    {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    Building check; // what the game will see
+    if (!loadSceneBlob(blob, number - 1, check))
+    {
+        std::cerr << jsonPath << ": compiled blob does not load\n";
+        return 1;
+    }
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    out.write(blob.data(), (std::streamsize)blob.size());
+    if (!out)
+    {
+        std::cerr << "could not write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << argv[2] << ": " << check.scenes.size() << " rooms, " << check.arrows.size() << " arrows, "
+              << check.items.size() << " items, " << check.textures.size() << " textures\n";
+    return 0;
+}
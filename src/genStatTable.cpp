@@ -0,0 +1,135 @@
+/*======================================= genStatTable.cpp ===================================
+  Project: TTRPG Game ?
+  Subsystem: Characters (Build Tool)
+  Primary Author: Andrew
+  Description: Build step that turns dat/Character_Starting_Stats.csv into startingStats.gen.h,
+               a constexpr table of StatRows compiled into the game. The Makefile runs it
+               whenever the CSV changes, so the game never opens the CSV at runtime.
+
+               Rows are written sorted by ID (StatView does a binary search over them) and the
+               output only depends on the CSV contents, so regenerating an unchanged CSV gives
+               an identical file.
+
+               Usage:
+                    ./GenStatTable <stats.csv> <output.h>
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "statSchema.h"
+
+namespace {
+    struct ParsedRow
+    {
+        std::string id;
+        int values[STAT_COLUMNS];
+    };
+
+    //@brief: Prints an error with the CSV line it came from and returns the exit code
+    int fail(const std::string& path, int lineNumber, const std::string& message)
+    {
+        std::cerr << path << ":" << lineNumber << ": " << message << "\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <stats.csv> <output.h>\n";
+        return 2;
+    }
+    const std::string csvPath = argv[1];
+    std::ifstream csv(csvPath);
+    if (!csv.is_open())
+    {
+        std::cerr << "could not open " << csvPath << "\n";
+        return 1;
+    }
+
+    std::string header;
+    std::getline(csv, header);
+    if (!header.empty() && header.back() == '\r') header.pop_back();
+    if (statSchemaHash(header) != statSchemaHash(STATS_CSV_HEADER))
+        return fail(csvPath, 1, "header does not match STATS_CSV_HEADER in statSchema.h (update CSVStats first)");
+
+    std::vector<ParsedRow> rows;
+    std::string line;
+    int lineNumber = 1;
+    while (std::getline(csv, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        std::istringstream lineStream(line);
+        std::string cell;
+        ParsedRow row;
+        std::getline(lineStream, row.id, ',');
+        if (row.id.empty() || row.id.size() >= STAT_ID_MAX)
+            return fail(csvPath, lineNumber, "ID must be 1 to " + std::to_string(STAT_ID_MAX - 1) + " characters");
+
+        int col = 0;
+        for (; col < STAT_COLUMNS && std::getline(lineStream, cell, ','); ++col)
+        {
+            try { row.values[col] = std::stoi(cell); }
+            catch (...) { return fail(csvPath, lineNumber, "'" + cell + "' is not a number"); }
+            if (row.values[col] < -127 || row.values[col] > 127)
+                return fail(csvPath, lineNumber, "'" + cell + "' does not fit in an int8 stat");
+        }
+        if (col != STAT_COLUMNS)
+            return fail(csvPath, lineNumber, "expected " + std::to_string(STAT_COLUMNS) + " stat columns");
+
+        for (const ParsedRow& other : rows)
+            if (other.id == row.id) return fail(csvPath, lineNumber, "duplicate ID " + row.id);
+        rows.push_back(row);
+    }
+    if (rows.empty()) return fail(csvPath, lineNumber, "no stat rows");
+
+    std::sort(rows.begin(), rows.end(), [](const ParsedRow& a, const ParsedRow& b) { return a.id < b.id; });
+
+    std::ostringstream out;
+    out << "/*==================================== startingStats.gen.h ==================================\n"
+        << "  GENERATED FILE - do not edit. Made by genStatTable.cpp from dat/Character_Starting_Stats.csv,\n"
+        << "  edit the CSV and run make instead.\n"
+        << "*/\n"
+        << "#include \"statSchema.h\"\n\n"
+        << "#ifndef STARTINGSTATS_GEN_H\n"
+        << "#define STARTINGSTATS_GEN_H\n\n"
+        << "#define STATS_SCHEMA_HASH 0x" << std::hex << statSchemaHash(header) << std::dec << "u // statSchemaHash() of the CSV header\n"
+        << "#define STATS_ROW_COUNT " << rows.size() << "\n\n"
+        << "// Sorted by ID, columns: " << header << "\n"
+        << "inline constexpr StatRow GENERATED_STAT_ROWS[STATS_ROW_COUNT] = {\n";
+    for (const ParsedRow& row : rows)
+    {
+        out << "    {\"" << row.id << "\", {";
+        for (int col = 0; col < STAT_COLUMNS; ++col)
+            out << (col ? ", " : "") << row.values[col];
+        out << "}},\n";
+    }
+    out << "};\n\n#endif // STARTINGSTATS_GEN_H\n";
+
+    // only touch the output when it changes so make doesnt rebuild everything for nothing
+    const std::string outPath = argv[2];
+    {
+        std::ifstream existing(outPath, std::ios::binary);
+        std::stringstream current;
+        current << existing.rdbuf();
+        if (existing.is_open() && current.str() == out.str()) return 0;
+    }
+    std::ofstream outFile(outPath, std::ios::binary | std::ios::trunc);
+    if (!outFile.is_open())
+    {
+        std::cerr << "could not write " << outPath << "\n";
+        return 1;
+    }
+    outFile << out.str();
+    return outFile.good() ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/*===================================== itemRegistry.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Characters (Item Registry)
+  Primary Author: Edwin Baiden
+  Description: Every item in the game gets an interned ItemID. The name and description live
+               once in the ITEM_REGISTRY table, inventories and scenes only carry the one byte ID,
+               and "has the player collected X" is a bit test on an ItemSet instead of comparing
+               strings. Names are only turned back into IDs at the edges (save files).
+
+               To add an item: add it to ItemID (before Count) and give it a row in ITEM_REGISTRY.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//=============== HEADER GUARD ===============
+#ifndef ITEMREGISTRY_H
+#define ITEMREGISTRY_H
+
+enum class ItemID : std::uint8_t {None, HealthPotion, BaseballBat, Key1, Key2, Count};
+
+#define ITEM_COUNT ((std::size_t)ItemID::Count)
+
+struct ItemInfo
+{
+    const char* name;        // shown in menus/logs and written to save files
+    const char* description;
+    bool isKey;              // unlocks SceneArrows that require it
+};
+
+inline constexpr ItemInfo ITEM_REGISTRY[] = {
+    {"",              "",                                false}, // None
+    {"Health Potion", "A strange liquid, restores 15HP", false},
+    {"Baseball Bat",  "Melee +2, range +1",              false},
+    {"Key 1",         "Opens Classroom 2",               true},
+    {"Key 2",         "Opens the building exit",         true},
+};
+static_assert(sizeof(ITEM_REGISTRY) / sizeof(ITEM_REGISTRY[0]) == ITEM_COUNT, "every ItemID needs an ITEM_REGISTRY row");
+
+constexpr const ItemInfo& itemInfo(ItemID id) { return ITEM_REGISTRY[(std::size_t)id]; }
+
+// Interns an item name (save files), unknown names are ItemID::None
+constexpr ItemID itemIDFromName(std::string_view name)
+{
+    for (std::size_t i = 1; i < ITEM_COUNT; ++i)
+        if (name == ITEM_REGISTRY[i].name) return (ItemID)i;
+    return ItemID::None;
+}
+
+// One bit per ItemID (collected items, keys)
+using ItemSet = std::bitset<ITEM_COUNT>;
+
+#endif // ITEMREGISTRY_H
@@ -5,15 +5,30 @@
 // main.cpp
 
 
+#include <cstdlib>
+#include <cstring>
+
 #include "raylib.h"
 #include "screenManager.h"
 
-int main() 
+#define ALLOC_CHECK_FRAMES 300 // Frames per phase of --alloc-check (room, then player turn)
+
+int main(int argc, char** argv) 
 {
+    // "--alloc-check [frames]": scripted run in a hidden window that fails if a steady frame allocates (make alloc-check)
+    int allocCheckFrames = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--alloc-check") != 0) continue;
+        allocCheckFrames = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+        if (allocCheckFrames <= 0) allocCheckFrames = ALLOC_CHECK_FRAMES;
+    }
+    const unsigned int hidden = allocCheckFrames > 0 ? FLAG_WINDOW_HIDDEN : 0;
+
     #if defined(__APPLE__) ||  defined (__MACH__) ||defined(__linux__)
-        SetConfigFlags(FLAG_WINDOW_HIGHDPI | FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT);
+        SetConfigFlags(FLAG_WINDOW_HIGHDPI | FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT | hidden);
     #else
-        SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT);
+        SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT | hidden);
     #endif
 
     InitAudioDevice();// Initialize audio device
@@ -28,6 +43,13 @@ int main()
 
     ScreenManager sm;     //Defining screen manager object
     sm.init();      // Initialize screen manager this loads to the main menu
+
+    if (allocCheckFrames > 0)
+    {
+        const int result = sm.runAllocationCheck(allocCheckFrames);
+        CloseWindow();
+        return result;
+    }
     
     while (!WindowShouldClose()) { 
         sm.update(GetFrameTime());
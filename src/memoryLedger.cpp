@@ -0,0 +1,235 @@
+/*===================================== memoryLedger.cpp =====================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Memory)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the memory accounting (see memoryLedger.h).
+*/
+#include "memoryLedger.h"
+
+#include <algorithm>
+#include <fstream>
+
+#define OWNER_COUNT ((int)MemOwner::Count)
+#define KIND_COUNT ((int)MemKind::Count)
+
+//@brief: An owner's budget and whether it was over at the last check (so it only warns once per crossing)
+struct MemBudget
+{
+    std::size_t cpuBytes;
+    std::size_t gpuBytes;
+    bool over;
+};
+
+//@brief: One registered gauge and what it said last time
+struct MemGaugeEntry
+{
+    MemOwner owner;
+    const char* name;
+    MemGauge gauge;
+    std::size_t bytes;
+};
+
+static MemOwner currentOwner = MemOwner::Shared;
+static MemTotals ledger[OWNER_COUNT][KIND_COUNT] = {};
+static MemBudget budgets[OWNER_COUNT] = {
+    {MEM_BUDGET_SHARED, false},
+    {MEM_BUDGET_MAIN_MENU, false},
+    {MEM_BUDGET_CHARACTER_SELECT, false},
+    {MEM_BUDGET_INTRO_CRAWL, false},
+    {MEM_BUDGET_EXPLORATION, false},
+    {MEM_BUDGET_COMBAT, false},
+};
+static MemGaugeEntry gauges[MEM_MAX_GAUGES] = {};
+static int gaugeCount = 0;
+static float sampleTimer = MEM_SAMPLE_SECONDS; // first call samples right away
+
+//@brief: Bytes as MB for the overlay and the log
+static float toMB(std::size_t bytes) { return (float)bytes / (1024.0f * 1024.0f); }
+
+MemFootprint memFootprint(const Texture2D& texture)
+{
+    std::size_t bytes = (std::size_t)GetPixelDataSize(texture.width, texture.height, texture.format);
+    if (texture.mipmaps > 1) bytes += bytes / 3; // the mip chain adds about a third
+    return {MemKind::Texture, 0, bytes};
+}
+
+MemFootprint memFootprint(const RenderTexture2D& target)
+{
+    MemFootprint footprint = memFootprint(target.texture);
+    if (target.depth.id) footprint.gpuBytes += (std::size_t)target.depth.width * target.depth.height * 4; // 24 bit depth, padded
+    return footprint;
+}
+
+MemFootprint memFootprint(const Sound& sound)
+{
+    return {MemKind::Sound, (std::size_t)sound.frameCount * sound.stream.channels * sound.stream.sampleSize / 8, 0};
+}
+
+MemFootprint memFootprint(const Music& music)
+{
+    if (!music.stream.buffer) return {MemKind::Music, 0, 0};
+    // two sub buffers of about 1/30 s (raylib's default) plus the decoder
+    const std::size_t frames = 2 * (std::size_t)(music.stream.sampleRate / 30);
+    return {MemKind::Music, frames * music.stream.channels * music.stream.sampleSize / 8 + MEM_MUSIC_DECODER_BYTES, 0};
+}
+
+MemFootprint memFootprint(const Font& font)
+{
+    MemFootprint footprint{MemKind::Font, (std::size_t)font.glyphCount * (sizeof(GlyphInfo) + sizeof(Rectangle)), memFootprint(font.texture).gpuBytes};
+    if (font.glyphs)
+        for (int i = 0; i < font.glyphCount; ++i) // raylib keeps every glyph's image next to the atlas
+            footprint.cpuBytes += (std::size_t)GetPixelDataSize(font.glyphs[i].image.width, font.glyphs[i].image.height, font.glyphs[i].image.format);
+    return footprint;
+}
+
+void memSetOwner(MemOwner owner) { currentOwner = owner; }
+MemOwner memOwner() { return currentOwner; }
+
+void memCharge(MemOwner owner, const MemFootprint& footprint)
+{
+    MemTotals& totals = ledger[(int)owner][(int)footprint.kind];
+    ++totals.count;
+    totals.cpuBytes += footprint.cpuBytes;
+    totals.gpuBytes += footprint.gpuBytes;
+}
+
+void memRelease(MemOwner owner, const MemFootprint& footprint)
+{
+    MemTotals& totals = ledger[(int)owner][(int)footprint.kind];
+    totals.count -= std::min<std::size_t>(totals.count, 1);
+    totals.cpuBytes -= std::min(totals.cpuBytes, footprint.cpuBytes);
+    totals.gpuBytes -= std::min(totals.gpuBytes, footprint.gpuBytes);
+}
+
+void memAddGauge(MemOwner owner, const char* name, MemGauge gauge)
+{
+    if (gaugeCount == MEM_MAX_GAUGES || !gauge)
+    {
+        TraceLog(LOG_WARNING, "Memory: no room for gauge %s (MEM_MAX_GAUGES)", name);
+        return;
+    }
+    gauges[gaugeCount++] = {owner, name, gauge, 0};
+}
+
+void memSetBudget(MemOwner owner, std::size_t cpuBytes, std::size_t gpuBytes)
+{
+    budgets[(int)owner] = {cpuBytes, gpuBytes, false};
+}
+
+void memSample(float dt)
+{
+    sampleTimer += dt;
+    if (sampleTimer < MEM_SAMPLE_SECONDS) return;
+    sampleTimer = 0.0f;
+
+    for (int o = 0; o < OWNER_COUNT; ++o) ledger[o][(int)MemKind::Heap] = {};
+    for (int g = 0; g < gaugeCount; ++g)
+    {
+        gauges[g].bytes = gauges[g].gauge();
+        MemTotals& heap = ledger[(int)gauges[g].owner][(int)MemKind::Heap];
+        ++heap.count;
+        heap.cpuBytes += gauges[g].bytes;
+    }
+
+    for (int o = 0; o < OWNER_COUNT; ++o)
+    {
+        const MemTotals totals = memOwnerTotals((MemOwner)o);
+        MemBudget& budget = budgets[o];
+        const bool over = (budget.cpuBytes && totals.cpuBytes > budget.cpuBytes) || (budget.gpuBytes && totals.gpuBytes > budget.gpuBytes);
+        if (over && !budget.over)
+            TraceLog(LOG_WARNING, "Memory: %s is over budget (CPU %.1f / %.1f MB, GPU %.1f / %.1f MB)", memOwnerName((MemOwner)o),
+                     toMB(totals.cpuBytes), toMB(budget.cpuBytes), toMB(totals.gpuBytes), toMB(budget.gpuBytes));
+        budget.over = over;
+    }
+}
+
+MemTotals memTotals(MemOwner owner, MemKind kind)
+{
+    return ledger[(int)owner][(int)kind];
+}
+
+MemTotals memOwnerTotals(MemOwner owner)
+{
+    MemTotals sum;
+    for (const MemTotals& totals : ledger[(int)owner])
+    {
+        sum.count += totals.count;
+        sum.cpuBytes += totals.cpuBytes;
+        sum.gpuBytes += totals.gpuBytes;
+    }
+    return sum;
+}
+
+const char* memOwnerName(MemOwner owner)
+{
+    static const char* names[OWNER_COUNT] = {"Shared", "Main menu", "Character select", "Intro crawl", "Exploration", "Combat"};
+    return owner < MemOwner::Count ? names[(int)owner] : "?";
+}
+
+const char* memKindName(MemKind kind)
+{
+    static const char* names[KIND_COUNT] = {"textures", "sounds", "music", "fonts", "heap"};
+    return kind < MemKind::Count ? names[(int)kind] : "?";
+}
+
+void memDrawOverlay(int x, int y, int fontSize)
+{
+    // columns at fixed offsets (the default font is not monospaced)
+    const int lineHeight = fontSize + 4;
+    const int columns[] = {0, 9, 12, 15, 18, 27}; // in font sizes: name, tex, snd, mus, CPU, GPU
+    auto row = [&](int line, const char* cells[6], Color color) {
+        for (int c = 0; c < 6; ++c) DrawText(cells[c], x + columns[c] * fontSize, y + line * lineHeight, fontSize, color);
+    };
+    DrawRectangle(x - 6, y - 6, fontSize * 37, lineHeight * (OWNER_COUNT + 2) + 8, Fade(BLACK, 0.75f));
+    const char* header[6] = {"MEMORY", "tex", "snd", "mus", "CPU MB (budget)", "GPU MB (budget)"};
+    row(0, header, RAYWHITE);
+
+    MemTotals all;
+    for (int o = 0; o < OWNER_COUNT; ++o)
+    {
+        const MemTotals totals = memOwnerTotals((MemOwner)o);
+        const MemBudget& budget = budgets[o];
+        all.cpuBytes += totals.cpuBytes;
+        all.gpuBytes += totals.gpuBytes;
+
+        // TextFormat rotates a few static buffers, so every cell gets its own copy
+        char cells[6][32];
+        TextCopy(cells[0], memOwnerName((MemOwner)o));
+        TextCopy(cells[1], TextFormat("%d", (int)ledger[o][(int)MemKind::Texture].count));
+        TextCopy(cells[2], TextFormat("%d", (int)ledger[o][(int)MemKind::Sound].count));
+        TextCopy(cells[3], TextFormat("%d", (int)ledger[o][(int)MemKind::Music].count));
+        TextCopy(cells[4], TextFormat("%.1f (%.0f)", toMB(totals.cpuBytes), toMB(budget.cpuBytes)));
+        TextCopy(cells[5], TextFormat("%.1f (%.0f)", toMB(totals.gpuBytes), toMB(budget.gpuBytes)));
+        const char* line[6] = {cells[0], cells[1], cells[2], cells[3], cells[4], cells[5]};
+        row(o + 1, line, budget.over ? RED : (totals.count ? LIME : GRAY));
+    }
+
+    char cpu[32], gpu[32];
+    TextCopy(cpu, TextFormat("%.1f", toMB(all.cpuBytes)));
+    TextCopy(gpu, TextFormat("%.1f", toMB(all.gpuBytes)));
+    const char* total[6] = {"Total", "", "", "", cpu, gpu};
+    row(OWNER_COUNT + 1, total, RAYWHITE);
+}
+
+bool memDump(const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << "owner / kind                count      CPU bytes      GPU bytes\n";
+    for (int o = 0; o < OWNER_COUNT; ++o)
+    {
+        const MemTotals totals = memOwnerTotals((MemOwner)o);
+        const MemBudget& budget = budgets[o];
+        out << TextFormat("%-26s %6d %14zu %14zu   budget %zu / %zu%s\n", memOwnerName((MemOwner)o), (int)totals.count,
+                          totals.cpuBytes, totals.gpuBytes, budget.cpuBytes, budget.gpuBytes, budget.over ? "  OVER" : "");
+        for (int k = 0; k < KIND_COUNT; ++k)
+        {
+            const MemTotals& kind = ledger[o][k];
+            if (kind.count) out << TextFormat("  %-24s %6d %14zu %14zu\n", memKindName((MemKind)k), (int)kind.count, kind.cpuBytes, kind.gpuBytes);
+        }
+        for (int g = 0; g < gaugeCount; ++g)
+            if ((int)gauges[g].owner == o) out << TextFormat("    heap: %-18s %14zu\n", gauges[g].name, gauges[g].bytes);
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,124 @@
+/*====================================== memoryLedger.h ======================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Memory)
+  Primary Author: Edwin Baiden
+  Description: Memory accounting per screen/game state. Every texture, sound, music stream and font
+               is charged to an owner (MemOwner) when its handle loads it and released when the
+               handle unloads it (resources.h does both, nobody calls memCharge by hand for those).
+               A texture that stays loaded into the next state is handed over to it (retag).
+
+               Heap the raylib handles dont cover (the intro crawl text, loaded buildings, the entity
+               pool, the fight's log...) is reported by gauges: a function per thing that says how
+               many bytes it holds right now, polled every MEM_SAMPLE_SECONDS.
+
+               Bytes are split into CPU and GPU. GPU bytes are estimates (pixel data size of the
+               texture format, +1/3 with mipmaps, what the driver really does is its business), CPU
+               bytes of audio are the sample data raylib keeps around.
+
+               Every owner has a budget (MEM_BUDGET_* below, memSetBudget to change it). Going over
+               logs a warning once, it warns again after dropping back under and going over again.
+               The numbers show in the memory overlay (KEY_MEMORY_OVERLAY) and memDump() writes them
+               to a file (KEY_MEMORY_DUMP).
+
+               Main thread only (that is where raylib loads and unloads everything anyway).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//======================= PROJECT INCLUDES =======================
+#include "raylib.h"
+
+//=============== HEADER GUARD ===============
+#ifndef MEMORYLEDGER_H
+#define MEMORYLEDGER_H
+
+#define MEM_MB(x) ((std::size_t)(x) * 1024 * 1024)
+#define MEM_SAMPLE_SECONDS 0.5f             // How often the gauges are polled and the budgets checked
+#define MEM_MUSIC_DECODER_BYTES (64 * 1024) // Rough size of an mp3/ogg decoder's state (raylib does not say)
+#define MEM_MAX_GAUGES 16
+
+// Budgets per owner: CPU bytes, GPU bytes (room backgrounds are 1920x1080 RGBA, ~8 MB each)
+#define MEM_BUDGET_SHARED           MEM_MB(24), MEM_MB(24)     // sounds, font, render targets, entity pool
+#define MEM_BUDGET_MAIN_MENU        MEM_MB(4),  MEM_MB(48)
+#define MEM_BUDGET_CHARACTER_SELECT MEM_MB(4),  MEM_MB(48)
+#define MEM_BUDGET_INTRO_CRAWL      MEM_MB(1),  MEM_MB(8)
+#define MEM_BUDGET_EXPLORATION      MEM_MB(16), MEM_MB(256)
+#define MEM_BUDGET_COMBAT           MEM_MB(16), MEM_MB(96)
+
+//@author: Edwin Baiden
+//@brief: Who memory is charged to (the screen or game state that asked for it, Shared for what lives the whole session)
+//@version: 1.0
+enum class MemOwner : std::uint8_t { Shared, MainMenu, CharacterSelect, IntroCrawl, Exploration, Combat, Count };
+
+//@author: Edwin Baiden
+//@brief: What kind of thing the bytes are
+//@version: 1.0
+enum class MemKind : std::uint8_t { Texture, Sound, Music, Font, Heap, Count };
+
+//@author: Edwin Baiden
+//@brief: Bytes one resource holds
+//@version: 1.0
+struct MemFootprint
+{
+    MemKind kind = MemKind::Heap;
+    std::size_t cpuBytes = 0;
+    std::size_t gpuBytes = 0;
+};
+
+//@author: Edwin Baiden
+//@brief: What an owner holds of one kind (count = loaded resources, or gauges for heap)
+//@version: 1.0
+struct MemTotals
+{
+    std::size_t count = 0;
+    std::size_t cpuBytes = 0;
+    std::size_t gpuBytes = 0;
+};
+
+//@brief: How many bytes something holds right now (a gauge, has to be cheap, it is polled a few times a second)
+using MemGauge = std::size_t (*)();
+
+//@brief: Footprints of the raylib resources (GPU sizes are estimates, see the top of the file)
+MemFootprint memFootprint(const Texture2D& texture);
+MemFootprint memFootprint(const RenderTexture2D& target);
+MemFootprint memFootprint(const Sound& sound);
+MemFootprint memFootprint(const Music& music);
+MemFootprint memFootprint(const Font& font);
+
+//@brief: Owner new resources are charged to (set by whatever screen/game state is being entered)
+void memSetOwner(MemOwner owner);
+MemOwner memOwner();
+
+//@brief: Adds/removes a resource's bytes to/from an owner
+void memCharge(MemOwner owner, const MemFootprint& footprint);
+void memRelease(MemOwner owner, const MemFootprint& footprint);
+
+//@brief: Registers a heap gauge for an owner (name shows in the dump, up to MEM_MAX_GAUGES)
+void memAddGauge(MemOwner owner, const char* name, MemGauge gauge);
+
+//@brief: Changes an owner's budget (0 = no limit)
+void memSetBudget(MemOwner owner, std::size_t cpuBytes, std::size_t gpuBytes);
+
+//@brief: Polls the gauges and checks the budgets every MEM_SAMPLE_SECONDS (call once per frame)
+void memSample(float dt);
+
+//@brief: What an owner holds of a kind (heap as of the last sample)
+MemTotals memTotals(MemOwner owner, MemKind kind);
+
+//@brief: Everything an owner holds (all kinds)
+MemTotals memOwnerTotals(MemOwner owner);
+
+//@brief: Readable names (overlay and dump)
+const char* memOwnerName(MemOwner owner);
+const char* memKindName(MemKind kind);
+
+//@brief: Draws the counters (one line per owner, with the budgets) at x, y
+void memDrawOverlay(int x, int y, int fontSize);
+
+//@brief: Writes every owner's counters, budgets and gauges to a text file
+//@return - False if the file could not be written
+bool memDump(const std::string& path);
+
+#endif // MEMORYLEDGER_H
@@ -0,0 +1,104 @@
+/*======================================== platform.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: Engine Core (Platform)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the platform shim (see platform.h). Plain C++ and the OS, no raylib.
+*/
+#include "platform.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdarg>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#if defined(_WIN32)
+    // Only this one from <windows.h>, the whole header clashes with a lot of names
+    extern "C" __declspec(dllimport) unsigned long __stdcall GetModuleFileNameA(void* module, char* fileName, unsigned long size);
+#elif defined(__APPLE__)
+    #include <mach-o/dyld.h>
+#else
+    #include <unistd.h>
+#endif
+
+#define PLATFORM_LOG_LINE 1024 // Longer log lines are cut
+#define PLATFORM_PATH_MAX 4096
+
+namespace {
+    std::atomic<int> logLevel{PLATFORM_LOG_INFO};
+    std::atomic<PlatformLogSink> logSink{nullptr};
+
+    const char* levelName(int level)
+    {
+        switch (level)
+        {
+            case PLATFORM_LOG_DEBUG: return "DEBUG";
+            case PLATFORM_LOG_INFO: return "INFO";
+            case PLATFORM_LOG_WARNING: return "WARNING";
+            case PLATFORM_LOG_ERROR: return "ERROR";
+            default: return "LOG";
+        }
+    }
+
+    // Full path of the executable, empty if the OS would not say
+    std::string executablePath()
+    {
+        char path[PLATFORM_PATH_MAX] = {};
+    #if defined(_WIN32)
+        const unsigned long length = GetModuleFileNameA(nullptr, path, PLATFORM_PATH_MAX);
+        return length > 0 && length < PLATFORM_PATH_MAX ? std::string(path, length) : std::string();
+    #elif defined(__APPLE__)
+        std::uint32_t size = PLATFORM_PATH_MAX;
+        return _NSGetExecutablePath(path, &size) == 0 ? std::string(path) : std::string();
+    #else
+        const ssize_t length = readlink("/proc/self/exe", path, PLATFORM_PATH_MAX - 1);
+        return length > 0 ? std::string(path, (std::size_t)length) : std::string();
+    #endif
+    }
+}
+
+void platformLog(int level, const char* format, ...)
+{
+    if (level < logLevel.load(std::memory_order_relaxed)) return;
+
+    char text[PLATFORM_LOG_LINE];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (PlatformLogSink sink = logSink.load(std::memory_order_acquire)) sink(level, text);
+    else std::fprintf(stderr, "%s: %s\n", levelName(level), text); // one call per line, lines of two threads dont mix
+}
+
+void platformSetLogLevel(int level)
+{
+    logLevel.store(level, std::memory_order_relaxed);
+}
+
+void platformSetLogSink(PlatformLogSink sink)
+{
+    logSink.store(sink, std::memory_order_release);
+}
+
+const std::string& platformAppDirectory()
+{
+    // the executable does not move while it runs, looked up once
+    static const std::string directory = [] {
+        std::filesystem::path exe = executablePath();
+        std::error_code ec;
+        std::filesystem::path dir = exe.empty() ? std::filesystem::current_path(ec) : exe.parent_path();
+        std::string text = dir.string();
+        if (text.empty() || (text.back() != '/' && text.back() != '\\')) text += (char)std::filesystem::path::preferred_separator;
+        return text;
+    }();
+    return directory;
+}
+
+void platformEnterAppDirectory()
+{
+    std::error_code ec;
+    std::filesystem::current_path(platformAppDirectory(), ec);
+    if (ec) platformLog(PLATFORM_LOG_WARNING, "Could not change to %s: %s", platformAppDirectory().c_str(), ec.message().c_str());
+}
@@ -0,0 +1,53 @@
+/*========================================= platform.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Engine Core (Platform)
+  Primary Author: Edwin Baiden
+  Description: The little the engine core (characters, combat, AI, dice, saves, see libtllcore.a
+               in the Makefile) needs from the outside: log lines and the executable's directory.
+               It used to get both from raylib (TraceLog, ChangeDirectory/GetApplicationDirectory),
+               which meant the replay tool, the benchmarks and the session server linked the
+               whole graphics stack for two functions.
+
+               Log lines go to stderr ("INFO: ...", same look as raylib's) unless a sink is set.
+               The game sets one that hands them to TraceLog, so its log stays in one place and
+               raylib's log level applies to the core's lines too.
+
+               The log level and the sink are meant to be set once at startup, logging itself
+               works from any thread.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <string>
+
+//=============== HEADER GUARD ===============
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+// Log levels, same values as raylib's TraceLogLevel so a sink can pass them straight to TraceLog
+#define PLATFORM_LOG_DEBUG 2
+#define PLATFORM_LOG_INFO 3
+#define PLATFORM_LOG_WARNING 4
+#define PLATFORM_LOG_ERROR 5
+
+//@brief: Where log lines go instead of stderr (text is formatted already, no newline)
+using PlatformLogSink = void (*)(int level, const char* text);
+
+//@brief: printf style log line, dropped if level is under the log level
+void platformLog(int level, const char* format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+//@brief: Lines under level are dropped (default PLATFORM_LOG_INFO)
+void platformSetLogLevel(int level);
+
+//@brief: Sends log lines to sink (nullptr = back to stderr)
+void platformSetLogSink(PlatformLogSink sink);
+
+//@brief: Directory of the running executable, with a trailing separator (like raylib's GetApplicationDirectory)
+const std::string& platformAppDirectory();
+
+//@brief: Makes the executable's directory the working directory (relative data paths are from there)
+void platformEnterAppDirectory();
+
+#endif // PLATFORM_H
@@ -4,174 +4,215 @@
     Primary Author: Edwin Baiden
     Description: Implementation file for progress saving and loading functions.
                 This file defines functions to save and load game progress,
-                including character stats, inventory, and world state using JSON format.
+                including character stats, inventory, and world state using the binary save format (saveData.h).
     
                     Functions:
+                        - void packSaveData(Character** entities, int currentSceneIndex, int activeEncounterID,
+                        int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems, SaveData& data):
+                        Copies the game state into a SaveData.
+
+                        - bool isPlayerSave(const SaveData& data):
+                        Whether a SaveData holds a player class (checked before a load throws anything away).
+
+                        - bool unpackSaveData(const SaveData& data, EntityPool& pool, Character** ent, const StatTable& stats, ...):
+                        Rebuilds the characters and world state from a SaveData.
+
                         - bool saveProgress(Character** entities, int currentSceneIndex, int activeEncounterID,
-                        int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const std::vector<std::string>& collectedItems):
-                        Saves the current game progress to a JSON file.
+                        int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems, const std::string& path):
+                        Saves the current game progress to a binary save file (SAVE_PATH unless a slot file is given).
     
-                        - bool LoadProgress (Character**& ent, std::istringstream* aStatLines, int& currentSceneIndex, int& activeEncounterID,
-                        int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, std::vector<std::string>& collectedItems):
-                        Loads game progress from a JSON file into the provided character array and world state variables.
+                        - bool readSaveState(const std::string& path, SaveData& data):
+                        Reads a binary save and replays its autosave journal on top.
+
+                        - bool LoadProgress (EntityPool& pool, Character** ent, const StatTable& stats, int& currentSceneIndex, int& activeEncounterID,
+                        int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems, const std::string& path):
+                        Loads game progress from the binary save file (plus the autosave journal replayed on top) into the provided
+                        character array and world state variables (an old savegame.json is migrated to the binary file the first time).
+                        Starts a new session in the entity pool (everything from the old one is despawned).
+
+                        - bool exportSaveJson(const std::string& path) / bool importSaveJson(const std::string& path):
+                        Debug export/import of the save as JSON (same layout the old savegame.json had).
     
-                    Uses the nlohmann/json library for JSON serialization and deserialization.
+                    Uses the nlohmann/json library only for the JSON export/import.
 */
 #include "progressLog.h"
+#include "autosaveJournal.h"
 using json = nlohmann::json;
 
+bool readSaveState(const std::string& path, SaveData& data)
+{
+    if (!readSaveFile(path, data)) return false;
+    int replayed = replayAutosaveJournal(autosaveJournalPath(path), data);
+    if (replayed > 0) platformLog(PLATFORM_LOG_INFO, "Replayed %d autosave records", replayed);
+    return true;
+}
+
 
-bool saveProgress(Character** ent, int currentSceneIndex, int activeEncounterID, 
-    int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const std::vector<std::string>& collectedItems)
+void packSaveData(Character** ent, int currentSceneIndex, int activeEncounterID, 
+    int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems, SaveData& data)
 {
-    // Create a JSON object to hold the save data
-    json j;
-    j["player"]["class"] = dynamic_cast<PlayerCharacter*>(ent[0])->characterClass; // Save player class
-    j["player"]["name"] = dynamic_cast<PlayerCharacter*>(ent[0])->name; // Save player name
-    j["player"]["attributes"]["strength"] = ent[0]->att.strength; // Save player strength
-    j["player"]["attributes"]["dexterity"] = ent[0]->att.dexterity; // Save player dexterity
-    j["player"]["attributes"]["constitution"] = ent[0]->att.constitution; // Save player constitution
-    j["player"]["defenseStats"]["armor"] = ent[0]->def.armor; // Save player armor
-    j["player"]["CombatStats"]["meleeDamage"] = ent[0]->cbt.meleeDamage; // Save player melee damage
-    j["player"]["CombatStats"]["rangeDamage"] = ent[0]->cbt.rangeDamage; // Save player range damage
-    j["player"]["CombatStats"]["initiative"] = ent[0]->cbt.initiative; // Save player initiative
-    j["player"]["weapons"]["meleeWeapon"] = dynamic_cast<PlayerCharacter*>(ent[0])->wep.meleeWeapon; // Save player melee weapon
-    j["player"]["weapons"]["rangeWeapon"] = dynamic_cast<PlayerCharacter*>(ent[0])->wep.rangeWeapon; // Save player range weapon
-    j["player"]["vitalStats"]["health"] = ent[0]->vit.health; // Save player health
-    j["player"]["vitalStats"]["maxHealth"] = ent[0]->vit.maxHealth; // Save player max health
-    j["player"]["inventory"] = json::array(); // Initialize inventory array
+    data = SaveData{};
+    const PlayerCharacter* player = asPlayer(ent[0]);
+    data.archetype = (std::uint8_t)player->archetype; // Save player class
+    std::strncpy(data.name, player->name.c_str(), SAVE_NAME_MAX - 1); // Save player name
+    data.strength = player->att.strength; // Save player strength
+    data.dexterity = player->att.dexterity; // Save player dexterity
+    data.constitution = player->att.constitution; // Save player constitution
+    data.armor = player->def.armor; // Save player armor
+    data.meleeDamage = player->cbt.meleeDamage; // Save player melee damage
+    data.rangeDamage = player->cbt.rangeDamage; // Save player range damage
+    data.initiative = player->cbt.initiative; // Save player initiative
+    data.meleeWeapon = player->wep.meleeWeapon; // Save player melee weapon
+    data.rangeWeapon = player->wep.rangeWeapon; // Save player range weapon
+    data.health = player->vit.health; // Save player health
+    data.maxHealth = player->vit.maxHealth; // Save player max health
 
     // Save each inventory item
-    for (const auto& item : dynamic_cast<PlayerCharacter*>(ent[0])->getInventory().getItems()) { // Iterate through inventory items
-        json itemJson; // Create JSON object for each item
-        itemJson["name"] = item.name; // Save item name
-        itemJson["healAmount"] = item.healAmount; // Save item heal amount
-        itemJson["quantity"] = item.quantity; // Save item quantity
-        j["player"]["inventory"].push_back(itemJson); // Add item JSON to inventory array
+    for (const auto& item : player->getInventory().getItems()) {
+        if (data.itemCount == SAVE_MAX_ITEMS) break; // never happens with the items we have now
+        data.items[data.itemCount++] = {(std::uint8_t)item.id, item.quantity, item.healAmount};
     }
 
-    
-    j["player"]["keys"]["key1"] = dynamic_cast<PlayerCharacter*>(ent[0])->key1; // Save key1 status
-    j["player"]["keys"]["key2"] = dynamic_cast<PlayerCharacter*>(ent[0])->key2; // Save key2 status
-    j["player"]["zombiesDefeated"]["zombie1"] = dynamic_cast<PlayerCharacter*>(ent[0])->zombie1Defeated; // Save zombie1 defeated status
-    j["player"]["zombiesDefeated"]["zombie2"] = dynamic_cast<PlayerCharacter*>(ent[0])->zombie2Defeated; // Save zombie2 defeated status
-    j["player"]["zombiesDefeated"]["zombie3"] = dynamic_cast<PlayerCharacter*>(ent[0])->zombie3Defeated; // Save zombie3 defeated status
-    j["world"]["currentSceneIndex"] = currentSceneIndex; // Save current scene index
-    j["world"]["activeEncounterID"] = activeEncounterID; // Save active encounter ID
-    j["world"]["savedPlayerSceneIndex"] = savedPlayerSceneIndex; // Save saved player scene index
-    j["world"]["collectedItems"] = collectedItems; // Save collected items
-
-    // Save combat state if enemy exists
-    if (ent[1]!= nullptr) 
-    {
-        j["combat"]["ZombieHP"] = ent[1]->vit.health; // Save zombie health
-        j["combat"]["ZombieMaxHP"] = ent[1]->vit.maxHealth; // Save zombie max health
-    } else 
+    data.zombiesDefeated = (std::uint8_t)(player->zombie1Defeated | player->zombie2Defeated << 1 | player->zombie3Defeated << 2);
+    data.currentSceneIndex = currentSceneIndex; // Save current scene index
+    data.activeEncounterID = activeEncounterID; // Save active encounter ID
+    data.savedPlayerSceneIndex = savedPlayerSceneIndex; // Save saved player scene index
+    data.collectedItems = (std::uint32_t)collectedItems.to_ulong(); // Save collected items (keys included)
+
+    // Save combat state if enemy exists (0 HP = no enemy)
+    if (ent[1] != nullptr) 
     {
-        j["combat"]["ZombieHP"] = 0; // No enemy, set health to 0
-        j["combat"]["ZombieMaxHP"] = 0; // No enemy, set max health to 0
+        data.enemyHealth = ent[1]->vit.health;
+        data.enemyMaxHealth = ent[1]->vit.maxHealth;
     }
-    
-    j["combat"]["battleWon"] = json::object();
+
     for (const auto& [encounterID, won] : battleWon) 
     {
-        j["combat"]["battleWon"][std::to_string(encounterID)] = won;
+        if (encounterID < 0 || encounterID >= SAVE_MAX_ENCOUNTERS) continue;
+        data.battlesFought |= 1u << encounterID;
+        if (won) data.battlesWon |= 1u << encounterID;
     }
+}
 
-
-    ChangeDirectory(GetApplicationDirectory());
-    if (!std::filesystem::exists("../dat/usrData")) 
-    {
-        std::filesystem::create_directory("../dat/usrData");
-    }
-    std::ofstream outFile("../dat/usrData/savegame.json");
-    if (!outFile.is_open()) 
-    {
-        return false; // Failed to open file for writing
-    }
-    outFile << j.dump(4);
-    outFile.close();
-    return true;
+bool isPlayerSave(const SaveData& data)
+{
+    return data.archetype < (std::uint8_t)Archetype::Count && ARCHETYPES[data.archetype].player;
 }
 
-bool LoadProgress (Character**& ent, std::istringstream* aStatLines, int& currentSceneIndex, int& activeEncounterID, 
-    int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, std::vector<std::string>& collectedItems)
+bool unpackSaveData(const SaveData& data, EntityPool& pool, Character** ent, const StatTable& stats, int& currentSceneIndex,
+    int& activeEncounterID, int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems)
 {
-    ent  = new Character*[2]{nullptr, nullptr};
-    
-    ChangeDirectory(GetApplicationDirectory());
-    std::ifstream inFile("../dat/usrData/savegame.json");
-    if (!inFile.is_open()) 
-    {
-        return false; // No save file found
-    }
+    if (!isPlayerSave(data)) return false; // not a player class, dont make a broken character
 
-    json j;
-    inFile >> j;
-    inFile.close();
+    CreateCharacter(pool, ent, stats, ARCHETYPES[data.archetype].csvID, std::string(data.name, strnlen(data.name, SAVE_NAME_MAX)));
+    PlayerCharacter* player = asPlayer(ent[0]);
+    player->att.strength = data.strength;
+    player->att.dexterity = data.dexterity;
+    player->att.constitution = data.constitution;
+    player->def.armor = data.armor;
+    player->cbt.meleeDamage = data.meleeDamage;
+    player->cbt.rangeDamage = data.rangeDamage;
+    player->cbt.initiative = data.initiative;
+    player->wep.meleeWeapon = data.meleeWeapon;
+    player->wep.rangeWeapon = data.rangeWeapon;
+    player->vit.health = data.health;
+    player->vit.maxHealth = data.maxHealth;
 
-    
-    if (j["player"]["class"]== "Student") 
-    {
-       CreateCharacter(ent, aStatLines, "Student", j["player"]["name"].get<std::string>());
-    }else if (j["player"]["class"]== "Rat")
-    {
-        CreateCharacter(ent, aStatLines, "Rat", j["player"]["name"].get<std::string>());
-    }else if (j["player"]["class"]== "Professor") 
-    {
-        CreateCharacter(ent, aStatLines, "Professor", j["player"]["name"].get<std::string>());
-    }else if (j["player"]["class"]== "Attila") 
-    {
-        CreateCharacter(ent, aStatLines, "Attila", j["player"]["name"].get<std::string>());
-    }
-    ent[0]->att.strength = j["player"]["attributes"]["strength"].get<std::int8_t>();
-    ent[0]->att.dexterity = j["player"]["attributes"]["dexterity"].get<std::int8_t>();
-    ent[0]->att.constitution = j["player"]["attributes"]["constitution"].get<std::int8_t>();
-    ent[0]->def.armor = j["player"]["defenseStats"]["armor"].get<std::int8_t>();
-    ent[0]->cbt.meleeDamage = j["player"]["CombatStats"]["meleeDamage"].get<std::uint8_t>();
-    ent[0]->cbt.rangeDamage = j["player"]["CombatStats"]["rangeDamage"].get<std::uint8_t>();
-    ent[0]->cbt.initiative = j["player"]["CombatStats"]["initiative"].get<std::int8_t>();
-    dynamic_cast<PlayerCharacter*>(ent[0])->wep.meleeWeapon = j["player"]["weapons"]["meleeWeapon"].get<std::uint8_t>();
-    dynamic_cast<PlayerCharacter*>(ent[0])->wep.rangeWeapon = j["player"]["weapons"]["rangeWeapon"].get<std::uint8_t>();
-    ent[0]->vit.health = j["player"]["vitalStats"]["health"].get<std::int8_t>();
-    ent[0]->vit.maxHealth = j["player"]["vitalStats"]["maxHealth"].get<std::int8_t>();
-
-    dynamic_cast<PlayerCharacter*>(ent[0])->getInventory().clearItems();
-    for (const auto& itemJson : j["player"]["inventory"]) 
+    player->getInventory().clearItems();
+    for (int i = 0; i < data.itemCount && i < SAVE_MAX_ITEMS; ++i) 
     {
         Item item;
-        item.name = itemJson["name"].get<std::string>();
-        item.healAmount = itemJson["healAmount"].get<std::uint8_t>();
-        item.quantity = itemJson["quantity"].get<std::uint8_t>();
-        dynamic_cast<PlayerCharacter*>(ent[0])->getInventory().additem(item);
+        item.id = (ItemID)data.items[i].id;
+        if (item.id == ItemID::None || item.id >= ItemID::Count) continue; // item that no longer exists
+        item.quantity = data.items[i].quantity;
+        item.healAmount = data.items[i].healAmount;
+        player->getInventory().additem(item);
     }
-    dynamic_cast<PlayerCharacter*>(ent[0])->key1 = j["player"]["keys"]["key1"].get<bool>();
-    dynamic_cast<PlayerCharacter*>(ent[0])->key2 = j["player"]["keys"]["key2"].get<bool>();
-    dynamic_cast<PlayerCharacter*>(ent[0])->zombie1Defeated = j["player"]["zombiesDefeated"]["zombie1"].get<bool>();
-    dynamic_cast<PlayerCharacter*>(ent[0])->zombie2Defeated = j["player"]["zombiesDefeated"]["zombie2"].get<bool>();
-    dynamic_cast<PlayerCharacter*>(ent[0])->zombie3Defeated = j["player"]["zombiesDefeated"]["zombie3"].get<bool>();
-
+    player->zombie1Defeated = (data.zombiesDefeated & 1) != 0;
+    player->zombie2Defeated = (data.zombiesDefeated & 2) != 0;
+    player->zombie3Defeated = (data.zombiesDefeated & 4) != 0;
 
-    currentSceneIndex = j["world"]["currentSceneIndex"].get<int>();
-    activeEncounterID = j["world"]["activeEncounterID"].get<int>();
-    savedPlayerSceneIndex = j["world"]["savedPlayerSceneIndex"].get<int>();
-    collectedItems = j["world"]["collectedItems"].get<std::vector<std::string>>();
+    currentSceneIndex = data.currentSceneIndex;
+    activeEncounterID = data.activeEncounterID;
+    savedPlayerSceneIndex = data.savedPlayerSceneIndex;
+    collectedItems = ItemSet(data.collectedItems);
+    collectedItems.reset((std::size_t)ItemID::None);
 
     if (ent[1]== nullptr) 
     {
-        CreateCharacter(ent, aStatLines, "Zombie_Standard", "Zombie");
+        CreateCharacter(pool, ent, stats, "Zombie_Standard", "Zombie");
     }
     
     if (activeEncounterID != -1)
     {
-        ent[1]->vit.health = j["combat"]["ZombieHP"].get<std::int8_t>();
-        ent[1]->vit.maxHealth = j["combat"]["ZombieMaxHP"].get<std::int8_t>();
+        ent[1]->vit.health = data.enemyHealth;
+        ent[1]->vit.maxHealth = data.enemyMaxHealth;
     }
 
     battleWon.clear();
-    for (auto& [encounterIDStr, won] : j["combat"]["battleWon"].items()) 
+    for (int id = 0; id < SAVE_MAX_ENCOUNTERS; ++id) 
     {
-        battleWon[std::stoi(encounterIDStr)] = won.get<bool>();
+        if ((data.battlesFought >> id) & 1) battleWon[id] = ((data.battlesWon >> id) & 1) != 0;
     }
     return true;
-}
\ No newline at end of file
+}
+
+bool saveProgress(Character** ent, int currentSceneIndex, int activeEncounterID, 
+    int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems, const std::string& path)
+{
+    SaveData data;
+    packSaveData(ent, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems, data);
+
+    platformEnterAppDirectory();
+    if (!std::filesystem::exists(SAVE_DIR)) 
+    {
+        std::filesystem::create_directory(SAVE_DIR);
+    }
+    return writeSaveFile(path, data);
+}
+
+bool LoadProgress (EntityPool& pool, Character** ent, const StatTable& stats, int& currentSceneIndex, int& activeEncounterID, 
+    int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems, const std::string& path)
+{
+    platformEnterAppDirectory();
+    SaveData data;
+    if (!readSaveState(path, data))
+    {
+        // No (valid) binary save, migrate the old JSON save if there is one
+        if (path != SAVE_PATH || !std::filesystem::exists(SAVE_JSON_PATH) || !importSaveJson(SAVE_JSON_PATH) || !readSaveFile(SAVE_PATH, data))
+        {
+            return false; // No save file found, the running session is left alone
+        }
+        platformLog(PLATFORM_LOG_INFO, "Migrated %s to %s", SAVE_JSON_PATH, SAVE_PATH);
+    }
+    if (!isPlayerSave(data)) return false; // unpackSaveData would refuse it too, checked before anything is thrown away
+
+    // the save is good: new session, the old characters go back to the pool (this used to leak the old array)
+    pool.clear();
+    ent[0] = nullptr;
+    ent[1] = nullptr;
+    return unpackSaveData(data, pool, ent, stats, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems);
+}
+
+bool exportSaveJson(const std::string& path)
+{
+    platformEnterAppDirectory();
+    SaveData data;
+    if (!readSaveState(SAVE_PATH, data)) return false;
+    std::ofstream outFile(path);
+    if (!outFile.is_open()) return false;
+    outFile << saveDataToJson(data).dump(4);
+    return static_cast<bool>(outFile);
+}
+
+bool importSaveJson(const std::string& path)
+{
+    platformEnterAppDirectory();
+    std::ifstream inFile(path);
+    if (!inFile.is_open()) return false;
+    json j = json::parse(inFile, nullptr, false); // no exceptions, a broken file is just discarded
+    SaveData data;
+    if (j.is_discarded() || !saveDataFromJson(j, data)) return false;
+    if (!std::filesystem::exists(SAVE_DIR)) std::filesystem::create_directory(SAVE_DIR);
+    return writeSaveFile(SAVE_PATH, data);
+}
@@ -4,59 +4,104 @@
     Primary Author: Edwin Baiden
     Description: Header file for progress saving and loading functions.
                 This file declares functions to save and load game progress,
-                including character stats, inventory, and world state using JSON format.
+                including character stats, inventory, and world state using the binary save format (saveData.h).
+                JSON is only used for the debug export/import and to migrate an old savegame.json.
     
                     Functions:
+                        - packSaveData / unpackSaveData: copy the game state into and out of a SaveData.
+                        - isPlayerSave: whether unpackSaveData takes a SaveData.
+
                         - bool saveProgress(Character** entities, int currentSceneIndex, int activeEncounterID,
-                        int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const std::vector<std::string>& collectedItems):
-                        Saves the current game progress to a JSON file.
-    
-                        - bool LoadProgress (Character**& ent, std::istringstream* aStatLines, int& currentSceneIndex, int& activeEncounterID,
-                        int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, std::vector<std::string>& collectedItems):
-                        Loads game progress from a JSON file into the provided character array and world state variables.
+                        int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems):
+                        Saves the current game progress to the binary save file.
     
-                    Uses the nlohmann/json library for JSON serialization and deserialization.
+                        - bool LoadProgress (EntityPool& pool, Character** ent, const StatTable& stats, int& currentSceneIndex, int& activeEncounterID,
+                        int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems):
+                        Loads game progress from the binary save file into the provided character array and world state variables.
+                        Starts a new session in the entity pool (everything from the old one is despawned).
+
+                        - exportSaveJson / importSaveJson: debug export/import of the save as JSON.
 
 */
 //======================= STANDARD LIBRARY INCLUDES =======================
 #include <fstream>
+#include <cstring>
 #include <filesystem>
 
 //======================= PROJECT INCLUDES =======================
 #include "json.hpp"
-#include  "raylib.h"
+#include "platform.h"
 #include "characters.h"
+#include "entityPool.h"
+#include "saveData.h"
 
 //=============== HEADER GUARD ===============
 #ifndef PROGRESSLOG_H
 #define PROGRESSLOG_H
 
-//@brief: Saves the current game progress to a JSON file
+//@brief: Copies the game state into a SaveData (no file access)
+//@version: 1.0
+//@author: Edwin Baiden
+//@param entities - Array of character pointers (player and enemy)
+//@param data - Filled with the state, everything else zeroed
+void packSaveData(Character** entities, int currentSceneIndex, int activeEncounterID, 
+    int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems, SaveData& data);
+
+//@brief: Whether a SaveData holds a player class (the one thing unpackSaveData refuses), so a load can check
+//        before it throws the running session away
+bool isPlayerSave(const SaveData& data);
+
+//@brief: Rebuilds the player/enemy and world state from a SaveData
 //@version: 1.0
 //@author: Edwin Baiden
+//@param pool - Session entity pool the characters are spawned in (the caller clears it)
+//@return - False if the saved archetype is not a player class
+bool unpackSaveData(const SaveData& data, EntityPool& pool, Character** ent, const StatTable& stats, int& currentSceneIndex,
+    int& activeEncounterID, int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems);
+
+//@brief: Saves the current game progress to the binary save file (SAVE_PATH), right away on this thread
+//         (the game itself saves through SaveService so it never waits on the disk)
+//@version: 2.0
+//@author: Edwin Baiden
 //@param entities - Array of character pointers (player and enemy)
 //@param currentSceneIndex - Index of the current scene
 //@param activeEncounterID - ID of the active encounter
 //@param savedPlayerSceneIndex - Index of the saved player scene
 //@param battleWon - Map of encounter IDs to victory status
-//@param collectedItems - List of collected item names
+//@param collectedItems - Collected item bits
+//@param path - Save file to write (a save slot file, or the single SAVE_PATH save)
 //@return - True if saving was successful, false otherwise
 bool saveProgress(Character** entities, int currentSceneIndex, int activeEncounterID, 
-    int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const std::vector<std::string>& collectedItems);
+    int savedPlayerSceneIndex, const std::map<int,bool>& battleWon, const ItemSet& collectedItems, const std::string& path = SAVE_PATH);
 
-//@brief: Loads game progress from a JSON file into the provided character array and world state variables
-//@version: 1.0
+//@brief: Reads a binary save and replays its autosave journal on top
+//@return - False if there is no valid save at path
+bool readSaveState(const std::string& path, SaveData& data);
+
+//@brief: Loads game progress from the binary save file (plus the autosave journal) into the provided character array and world state variables,
+//         an old savegame.json is migrated to the binary file if there is no binary save yet
+//@version: 2.0
 //@author: Edwin Baiden
-//@param ent - Reference to an array of character pointers to populate
-//@param aStatLines - Pointer to an array of string streams containing character stats
+//@param pool - Session entity pool, cleared and refilled with the loaded characters (only once the save was read and checked)
+//@param ent - Player/enemy array to populate (untouched if loading fails)
+//@param stats - Starting stats table used to create the characters
 //@param currentSceneIndex - Reference to store the current scene index
 //@param activeEncounterID - Reference to store the active encounter ID
 //@param savedPlayerSceneIndex - Reference to store the saved player scene index
 //@param battleWon - Reference to a map to populate with encounter victory status
-//@param collectedItems - Reference to a vector to populate with collected item names
+//@param collectedItems - Reference to the collected item bits to fill
+//@param path - Save file to read (the old savegame.json is only migrated for SAVE_PATH)
 //@return - True if loading was successful, false otherwise
 
-bool LoadProgress (Character**& ent, std::istringstream* aStatLines, int& currentSceneIndex, int& activeEncounterID, 
-    int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, std::vector<std::string>& collectedItems);
+bool LoadProgress (EntityPool& pool, Character** ent, const StatTable& stats, int& currentSceneIndex, int& activeEncounterID, 
+    int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems, const std::string& path = SAVE_PATH);
+
+//@brief: Writes the binary save as JSON (same layout as the old savegame.json), for debugging
+//@return - False if there is no valid binary save or path cant be written
+bool exportSaveJson(const std::string& path);
+
+//@brief: Reads a JSON save (old savegame.json or an edited export) and writes it as the binary save
+//@return - False if the file is missing, not valid JSON or missing fields
+bool importSaveJson(const std::string& path);
 
 #endif //PROGRESSLOG_H
\ No newline at end of file
@@ -0,0 +1,228 @@
+/*===================================== replayJournal.cpp ====================================
+  Project: TTRPG Game ?
+  Subsystem: Combat Engine (Journal Replay Tool)
+  Primary Author: Sebastian Cardona
+  Description: Command line tool that re-runs recorded fights through the real combat engine.
+               For every journal it rebuilds both combatants (and their archetypes) from the header, reseeds the dice
+               with the fight's seed and replays each event through resolve_melee/resolve_ranged
+               (heal for items, tickStatusEffects at the end of a round). Every d20, damage roll and
+               HP value has to match what the game recorded, otherwise the first mismatch is
+               reported and the tool exits with 1.
+
+               No window is opened, so it is also used to time the combat engine on its own.
+
+               Usage:
+                    ./ReplayJournal [--log] [--bench N] <journal.tlj> [more.tlj ...]
+
+                    --log      print the regenerated combat log
+                    --bench N  replay every journal N times and report events per second
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "combat.h"
+#include "combatJournal.h"
+#include "rng.h"
+
+namespace {
+    //@brief: Rebuilds the stat blocks of a combatant from its journal header entry
+    void unpackCombatant(const JournalCombatant& jc, Attributes& att, DefenseStats& def, CombatStats& cbt, VitalStats& vit, StatusEffects& eff)
+    {
+        att.strength = jc.attributes[0];
+        att.dexterity = jc.attributes[1];
+        att.constitution = jc.attributes[2];
+        att.wisdom = jc.attributes[3];
+        att.charisma = jc.attributes[4];
+        att.intelligence = jc.attributes[5];
+        def.armor = jc.armor; // base armor, the defend bonus comes from the DEFENDING status
+        cbt.initiative = jc.initiative;
+        vit.health = jc.health;
+        vit.maxHealth = jc.maxHealth;
+        eff = StatusEffects{};
+        eff.active = jc.effectsActive;
+        std::memcpy(eff.duration, jc.effectDuration, sizeof(eff.duration));
+        std::memcpy(eff.magnitude, jc.effectMagnitude, sizeof(eff.magnitude));
+    }
+
+    std::string combatantName(const JournalCombatant& jc)
+    {
+        return std::string(jc.id, strnlen(jc.id, sizeof(jc.id)));
+    }
+
+    //@brief: Archetype of a combatant (its ranged hits put the same effects on as in the game), a bad byte is a Zombie
+    Archetype combatantArchetype(const JournalCombatant& jc)
+    {
+        return jc.archetype < (std::uint8_t)Archetype::Count ? (Archetype)jc.archetype : Archetype::Zombie;
+    }
+
+    //@brief: Puts a character in the defend state the game had when the event started
+    void syncDefense(Character& c, bool defending)
+    {
+        if (defending && !c.isDefending()) c.startDefense();
+        else if (!defending && c.isDefending()) c.endDefense();
+    }
+
+    //@brief: Replays one journal, returns the index of the first mismatching event or -1 if it all matched
+    int replay(const JournalHeader& header, const std::vector<CombatEvent>& events, std::vector<std::string>& log)
+    {
+        Attributes att; DefenseStats def; CombatStats cbt; VitalStats vit; StatusEffects eff;
+
+        unpackCombatant(header.combatants[JOURNAL_PLAYER], att, def, cbt, vit, eff);
+        PlayerCharacter player("Player", combatantName(header.combatants[JOURNAL_PLAYER]), att, def, cbt, vit, eff);
+        player.wep.meleeWeapon = header.combatants[JOURNAL_PLAYER].meleeWeapon;
+        player.wep.rangeWeapon = header.combatants[JOURNAL_PLAYER].rangeWeapon;
+        player.archetype = combatantArchetype(header.combatants[JOURNAL_PLAYER]);
+
+        unpackCombatant(header.combatants[JOURNAL_ENEMY], att, def, cbt, vit, eff);
+        NonPlayerCharacter enemy(combatantName(header.combatants[JOURNAL_ENEMY]), att, def, cbt, vit, eff);
+        enemy.wep.meleeWeapon = header.combatants[JOURNAL_ENEMY].meleeWeapon;
+        enemy.wep.rangeWeapon = header.combatants[JOURNAL_ENEMY].rangeWeapon;
+        enemy.archetype = combatantArchetype(header.combatants[JOURNAL_ENEMY]);
+
+        Character* const both[2] = {&player, &enemy}; // JOURNAL_PLAYER, JOURNAL_ENEMY
+        std::int8_t tickHPBefore[2] = {0, 0};
+        seed_rng(header.seed);
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            const CombatEvent& e = events[i];
+            bool playerDefending = (e.flags & JOURNAL_FLAG_PLAYER_DEFENDING) != 0;
+            bool enemyDefending = (e.flags & JOURNAL_FLAG_ENEMY_DEFENDING) != 0;
+            syncDefense(player, playerDefending);
+            syncDefense(enemy, enemyDefending);
+
+            Character& actor = e.actor == JOURNAL_PLAYER ? static_cast<Character&>(player) : enemy;
+            Character& target = e.actor == JOURNAL_PLAYER ? static_cast<Character&>(enemy) : player;
+            AttackRoll rolls;
+            std::int8_t hpBefore = 0, hpAfter = 0;
+
+            switch (static_cast<JournalAction>(e.action))
+            {
+                case JournalAction::Melee:
+                case JournalAction::Ranged:
+                    hpBefore = target.vit.health;
+                    if (static_cast<JournalAction>(e.action) == JournalAction::Melee)
+                        resolve_melee(actor, target, e.actor == JOURNAL_PLAYER ? enemyDefending : playerDefending, log, &rolls);
+                    else
+                        resolve_ranged(actor, target, e.actor == JOURNAL_PLAYER ? enemyDefending : playerDefending, log, &rolls);
+                    hpAfter = target.vit.health;
+                    break;
+                case JournalAction::Defend:
+                    hpBefore = hpAfter = actor.vit.health;
+                    AddNewLogEntry(log, nameOf(actor) + " defends.");
+                    actor.startDefense();
+                    break;
+                case JournalAction::UseItem:
+                    hpBefore = player.vit.health;
+                    player.heal(e.damageRoll);
+                    hpAfter = player.vit.health;
+                    rolls.damageRoll = (std::uint8_t)(hpAfter - hpBefore);
+                    AddNewLogEntry(log, nameOf(player) + " heals " + std::to_string(rolls.damageRoll) + " HP.");
+                    break;
+                case JournalAction::StatusTick:
+                    // the end of a round is a player event then an enemy event, the tick runs once for both on the first
+                    if (e.actor == JOURNAL_PLAYER)
+                    {
+                        tickHPBefore[0] = player.vit.health;
+                        tickHPBefore[1] = enemy.vit.health;
+                        tickStatusEffects(both, 2, nullptr);
+                    }
+                    hpBefore = tickHPBefore[e.actor == JOURNAL_PLAYER ? 0 : 1];
+                    hpAfter = actor.vit.health;
+                    if (hpAfter != hpBefore)
+                        AddNewLogEntry(log, nameOf(actor) + (hpAfter < hpBefore ? " loses " : " recovers ") +
+                                       std::to_string(std::abs(hpAfter - hpBefore)) + " HP from status effects.");
+                    break;
+                default:
+                    return (int)i;
+            }
+
+            bool hit = (e.flags & JOURNAL_FLAG_HIT) != 0;
+            if (rolls.hitRoll != e.d20 || rolls.damageRoll != e.damageRoll || rolls.hit != hit ||
+                hpBefore != e.hpBefore || hpAfter != e.hpAfter)
+                return (int)i;
+        }
+        return -1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool printLog = false;
+    long benchRuns = 0;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--log") == 0) printLog = true;
+        else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) benchRuns = std::atol(argv[++i]);
+        else paths.push_back(argv[i]);
+    }
+    if (paths.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " [--log] [--bench N] <journal.tlj> [more.tlj ...]\n";
+        return 2;
+    }
+
+    struct Loaded { std::string path; JournalHeader header; std::vector<CombatEvent> events; };
+    std::vector<Loaded> journals;
+    int failures = 0;
+    for (const std::string& path : paths)
+    {
+        Loaded j{path, {}, {}};
+        if (!readCombatJournal(path, j.header, j.events))
+        {
+            std::cerr << path << ": not a valid combat journal\n";
+            failures++;
+            continue;
+        }
+        journals.push_back(std::move(j));
+    }
+
+    for (const Loaded& j : journals)
+    {
+        std::vector<std::string> log;
+        int bad = replay(j.header, j.events, log);
+        if (printLog)
+            for (const std::string& line : log) std::cout << "  " << line << '\n';
+
+        if (bad >= 0)
+        {
+            const CombatEvent& e = j.events[bad];
+            std::cout << j.path << ": MISMATCH at event " << bad << " (turn " << e.turn << ", recorded d20=" << (int)e.d20
+                      << " dmg=" << (int)e.damageRoll << " hp " << (int)e.hpBefore << "->" << (int)e.hpAfter << ")\n";
+            failures++;
+        }
+        else
+        {
+            std::cout << j.path << ": OK, " << j.events.size() << " events, seed " << j.header.seed
+                      << (j.header.overflowed ? " (journal overflowed, tail of fight not recorded)" : "") << '\n';
+        }
+    }
+
+    if (benchRuns > 0 && !journals.empty())
+    {
+        std::vector<std::string> log;
+        log.reserve(JOURNAL_CAPACITY);
+        std::size_t eventCount = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long run = 0; run < benchRuns; ++run)
+        {
+            for (const Loaded& j : journals)
+            {
+                log.clear();
+                replay(j.header, j.events, log);
+                eventCount += j.events.size();
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "replayed " << eventCount << " events in " << seconds * 1000.0 << " ms ("
+                  << (seconds > 0.0 ? eventCount / seconds : 0.0) << " events/s)\n";
+    }
+
+    return failures == 0 ? 0 : 1;
+}
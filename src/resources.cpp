@@ -0,0 +1,109 @@
+/*======================================== resources.cpp =====================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Resources)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the texture delta loading and prefetching (see resources.h).
+*/
+#include "resources.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+TextureSet::Delta TextureSet::declare(const std::vector<Source>& sources)
+{
+    Delta delta;
+    finishPrefetch(); // a state entered before its transition finished still gets what was prefetched for it
+
+    // whatever is resident right now, by key (a key the old list had twice hands out one texture per use)
+    std::unordered_multimap<std::string, std::size_t> resident;
+    for (std::size_t i = 0; i < entries.size(); ++i)
+        if (!entries[i].key.empty()) resident.emplace(entries[i].key, i);
+
+    std::vector<Entry> next(sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        const Source& source = sources[i];
+        next[i].key = source.key;
+        if (source.key.empty()) continue; // empty slot (e.g. a save slot without a thumbnail)
+
+        auto found = resident.find(source.key);
+        if (found != resident.end())
+        {
+            next[i].texture = std::move(entries[found->second].texture);
+            resident.erase(found);
+            ++delta.kept;
+            continue;
+        }
+        auto staging = std::find_if(staged.begin(), staged.end(), [&](const Entry& e) { return e.key == source.key && e.texture; });
+        if (staging != staged.end())
+        {
+            next[i].texture = std::move(staging->texture);
+            ++delta.prefetched;
+            continue;
+        }
+        next[i].texture.reset(source.image ? LoadTextureFromImage(*source.image) : LoadTexture(source.key.c_str()));
+        ++delta.loaded;
+    }
+
+    delta.unloaded = (int)resident.size(); // the ones nobody took unload when the old list goes
+    for (Entry& entry : next) entry.texture.retag(memOwner()); // kept and prefetched ones belong to the declaring state now
+    entries = std::move(next);
+    staged.clear(); // prefetched for a state that did not want them after all
+    return delta;
+}
+
+void TextureSet::prefetch(const std::vector<Source>& sources)
+{
+    auto has = [](const auto& list, const std::string& key) {
+        return std::any_of(list.begin(), list.end(), [&](const auto& e) { return e.key == key; });
+    };
+    for (const Source& source : sources)
+    {
+        if (source.key.empty() || source.image) continue;
+        if (has(entries, source.key) || has(staged, source.key) || has(decoding, source.key)) continue; // resident or on its way
+        const std::string path = source.key;
+        decoding.push_back({path, std::async(std::launch::async, [path]() { return LoadImage(path.c_str()); })});
+    }
+}
+
+bool TextureSet::pump(int maxUploads)
+{
+    for (std::size_t i = 0; i < decoding.size() && maxUploads > 0;)
+    {
+        if (decoding[i].image.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            ++i;
+            continue;
+        }
+        Image image = decoding[i].image.get();
+        if (image.data) // a file that did not decode is left to declare(), it logs why
+        {
+            staged.push_back({decoding[i].key, TextureHandle(LoadTextureFromImage(image))});
+            --maxUploads;
+        }
+        UnloadImage(image);
+        decoding.erase(decoding.begin() + (std::ptrdiff_t)i);
+    }
+    return decoding.empty();
+}
+
+void TextureSet::finishPrefetch()
+{
+    for (Decode& decode : decoding) decode.image.wait();
+    pump((int)decoding.size());
+}
+
+void TextureSet::release()
+{
+    finishPrefetch(); // the worker threads still own their images until they are done
+    staged.clear();
+    entries.clear();
+}
+
+void TextureSet::replace(std::size_t i, const Source& source)
+{
+    if (i >= entries.size()) return;
+    entries[i].key = source.key;
+    entries[i].texture.reset(source.image ? LoadTextureFromImage(*source.image) : LoadTexture(source.key.c_str()));
+}
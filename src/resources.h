@@ -0,0 +1,191 @@
+/*======================================== resources.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Resources)
+  Primary Author: Edwin Baiden
+  Description: Ownership of the raylib resources the screens use. A Resident<T> is a loaded
+               texture/sound/font that unloads itself when it is reset, replaced or destroyed, so
+               nothing needs a matching Cleanup call anymore.
+
+               TextureSet holds the textures of whatever screen or game state is active, indexed
+               the way the screens always indexed ScreenTextures. Every ScreenState/GameState
+               declares the list of textures it needs when it is entered, and declare() works
+               out the difference to what is already resident: textures both lists have stay on
+               the GPU (only moved to their new index), new ones are loaded, the rest unloaded.
+               Main menu -> character select keeps the background, and going back to exploration
+               after a pause or a fight only loads what the fight replaced.
+
+               A state can also be prepared before it is entered (screen transitions): prefetch()
+               decodes the image files of the next list on worker threads while the old state is
+               still on screen, pump() uploads a few of the decoded images a frame on the main
+               thread (GL calls have to be made there), and declare() takes those uploads instead of
+               loading the files again. Anything not prefetched is loaded by declare() like before.
+
+               Every handle charges what it holds to the memory ledger (memoryLedger.h) under the owner
+               that was active when it loaded, declare() hands the textures it keeps to the declaring
+               state (retag).
+
+               The handles have to be released before the window closes (raylib cant unload
+               anything without a GL context), the screen manager does that in its destructor.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "raylib.h"
+#include "memoryLedger.h"
+
+//=============== HEADER GUARD ===============
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+/**
+ * @author: Edwin Baiden
+ * @brief: One loaded raylib resource, unloaded with Unload when the handle lets go of it (move only). What it holds is
+ *         charged to its owner in the memory ledger for as long as it is loaded
+ * @version: 1.1
+ */
+template <typename T, void (*Unload)(T)>
+class Resident
+{
+    public:
+        Resident() = default;
+        explicit Resident(T loadedValue, MemOwner memOwnerTag = memOwner()) { reset(loadedValue, memOwnerTag); }
+        Resident(Resident&& other) noexcept : value(other.value), loaded(other.loaded), owner(other.owner) { other.loaded = false; }
+        Resident& operator=(Resident&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                value = other.value;
+                loaded = other.loaded;
+                owner = other.owner;
+                other.loaded = false;
+            }
+            return *this;
+        }
+        Resident(const Resident&) = delete;
+        Resident& operator=(const Resident&) = delete;
+        ~Resident() { reset(); }
+
+        //@brief: Unloads the resource (if there is one)
+        void reset()
+        {
+            if (loaded)
+            {
+                memRelease(owner, memFootprint(value));
+                Unload(value);
+            }
+            loaded = false;
+            value = T{};
+        }
+
+        //@brief: Takes over a freshly loaded resource (the old one is unloaded first), charged to memOwnerTag
+        void reset(T loadedValue, MemOwner memOwnerTag = memOwner())
+        {
+            reset();
+            value = loadedValue;
+            loaded = true;
+            owner = memOwnerTag;
+            memCharge(owner, memFootprint(value));
+        }
+
+        //@brief: Hands the resource to another owner in the memory ledger (kept by the next state)
+        void retag(MemOwner memOwnerTag)
+        {
+            if (loaded && memOwnerTag != owner)
+            {
+                memRelease(owner, memFootprint(value));
+                memCharge(memOwnerTag, memFootprint(value));
+            }
+            owner = memOwnerTag;
+        }
+
+        explicit operator bool() const { return loaded; }
+        const T& operator*() const { return value; }
+        const T* operator->() const { return &value; }
+
+    private:
+        T value{};
+        bool loaded = false;
+        MemOwner owner = MemOwner::Shared;
+};
+
+using TextureHandle = Resident<Texture2D, UnloadTexture>;
+using SoundHandle = Resident<Sound, UnloadSound>;
+using FontHandle = Resident<Font, UnloadFont>;
+using MusicHandle = Resident<Music, UnloadMusicStream>;
+
+/**
+ * @author: Edwin Baiden
+ * @brief: Textures of the active screen/game state, declared per state and loaded as a delta
+ * @version: 1.0
+ */
+class TextureSet
+{
+    public:
+        //@brief: One texture a state needs. key is the file path, or (with image set) any name unique to that image's contents
+        struct Source
+        {
+            Source() = default;
+            Source(std::string sourceKey, const Image* sourceImage = nullptr) : key(std::move(sourceKey)), image(sourceImage) {}
+            Source(const char* path) : key(path ? path : "") {}
+
+            std::string key;
+            const Image* image = nullptr; // loaded with LoadTextureFromImage instead of from the file
+        };
+
+        //@brief: What the last declare() did (debug log)
+        struct Delta
+        {
+            int loaded = 0;
+            int prefetched = 0;     // taken from what prefetch()/pump() already uploaded
+            int kept = 0;
+            int unloaded = 0;
+        };
+
+        //@brief: Makes exactly these textures resident, at these indexes (an empty key is an empty slot)
+        //@return - How many textures were loaded, kept and unloaded
+        Delta declare(const std::vector<Source>& sources);
+
+        //@brief: Starts decoding the files of sources that are not resident yet, each on a worker thread
+        //        (sources with an image are already in memory and empty slots have nothing to load, both are skipped)
+        void prefetch(const std::vector<Source>& sources);
+
+        //@brief: Uploads at most maxUploads of the images prefetch() finished decoding (main thread only)
+        //@return - True once everything prefetched is on the GPU, declare() then loads nothing from disk
+        bool pump(int maxUploads);
+
+        //@brief: Swaps the texture at index i for another one (the old one is unloaded)
+        void replace(std::size_t i, const Source& source);
+
+        //@brief: Unloads everything (before the window closes)
+        void release();
+
+        const Texture2D& operator[](std::size_t i) const { return *entries[i].texture; }
+        std::size_t size() const { return entries.size(); }
+        bool empty() const { return entries.empty(); }
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            TextureHandle texture;
+        };
+        struct Decode
+        {
+            std::string key;
+            std::future<Image> image;
+        };
+        std::vector<Entry> entries; // index = the state's texture index
+        std::vector<Entry> staged;  // prefetched and uploaded, waiting for the declare() of the next state
+        std::vector<Decode> decoding; // prefetched, still decoding (or decoded and waiting for pump())
+
+        //@brief: Waits for every decode still running and uploads all of them
+        void finishPrefetch();
+};
+
+#endif // RESOURCES_H
@@ -6,11 +6,19 @@
 
 
 namespace {
+    // Dice bound to this thread by an RngScope (nullptr = the shared ones)
+    thread_local RngStream* boundStream = nullptr;
+
     // This function returns a reference to a single global-ish engine,
-    // but it's hidden inside this file only.
-    std::mt19937& engine() {
-        static std::mt19937 eng{ std::random_device{}() };
-        return eng;
+    // but it's hidden inside this file only. A session's own dice win while they are bound.
+    RngStream& engine() {
+        static RngStream eng = [] {
+            RngStream e;
+            e.state.seed = std::random_device{}();
+            e.eng.seed(e.state.seed);
+            return e;
+        }();
+        return boundStream ? *boundStream : eng;
     }
 }
 
@@ -21,4 +29,47 @@ namespace {
 int roll_d(int sides) {
     std::uniform_int_distribution<int> dist(1, sides);
     return dist(engine());
-}
\ No newline at end of file
+}
+
+// @author: Andrew
+// @brief: reseeds the engine so the following rolls are reproducible (combat journal replay relies on this)
+// @param: std::uint32_t seed - the seed to use
+void seed_rng(std::uint32_t seed) {
+    engine().eng.seed(seed);
+    engine().state = RngState{seed, 0};
+}
+
+// @author: Andrew
+// @brief: pulls a fresh seed from the OS so every fight is different, but can still be replayed from its journal
+// @return: std::uint32_t - a random seed
+std::uint32_t new_rng_seed() {
+    return std::random_device{}();
+}
+
+// @author: Andrew
+// @brief: where the dice are right now (seed + draws since), cheap enough to store every turn
+// @return: RngState - pass it to restore_rng() to roll the same numbers again
+RngState rng_state() {
+    return engine().state;
+}
+
+// @author: Andrew
+// @brief: puts the dice back to a state from rng_state() (reseed, then skip the numbers already drawn)
+// @param: const RngState& state - what rng_state() returned
+void restore_rng(const RngState& state) {
+    RngStream& e = engine();
+    e.eng.seed(state.seed);
+    e.eng.discard(state.draws);
+    e.state = state;
+}
+
+// @author: Andrew
+// @brief: binds a session's dice to this thread until the scope ends
+// @param: RngStream& stream - the dice to roll with (has to outlive the scope)
+RngScope::RngScope(RngStream& stream) : previous(boundStream) {
+    boundStream = &stream;
+}
+
+RngScope::~RngScope() {
+    boundStream = previous;
+}
@@ -4,10 +4,58 @@
 #include <limits>
 #include <random>
 #include <algorithm>
+#include <cstdint>
 #ifndef RNG_H
 #define RNG_H
 
 // Roll a die with N sides
 int roll_d(int sides);
 
+// Reseed the dice (same seed = same rolls, used to make fights replayable)
+void seed_rng(std::uint32_t seed);
+
+// Get a fresh non-deterministic seed for a new fight
+std::uint32_t new_rng_seed();
+
+// Where the dice are: the last seed plus how many numbers were drawn since (8 bytes instead of the whole engine)
+struct RngState
+{
+    std::uint32_t seed = 0;
+    std::uint32_t draws = 0;
+};
+
+// Current position of the dice (world snapshots store it so an undone turn rolls the same dice again)
+RngState rng_state();
+
+// Puts the dice back where rng_state() was taken (reseeds and skips the draws)
+void restore_rng(const RngState& state);
+
+// A set of dice: the engine plus the seed it got and how many numbers it handed out since.
+// There is one shared set, a headless session (gameSession.h) brings its own so thousands of
+// runs can roll side by side without seeing each other's numbers.
+struct RngStream
+{
+    using result_type = std::mt19937::result_type;
+    static constexpr result_type min() { return std::mt19937::min(); }
+    static constexpr result_type max() { return std::mt19937::max(); }
+    result_type operator()() { ++state.draws; return eng(); }
+
+    std::mt19937 eng;
+    RngState state;
+};
+
+// While one of these is alive, every function above uses stream on this thread instead of the
+// shared dice (scopes nest, the previous dice come back when it goes)
+class RngScope
+{
+    public:
+        explicit RngScope(RngStream& stream);
+        ~RngScope();
+        RngScope(const RngScope&) = delete;
+        RngScope& operator=(const RngScope&) = delete;
+
+    private:
+        RngStream* previous;
+};
+
 #endif
\ No newline at end of file
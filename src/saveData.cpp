@@ -0,0 +1,271 @@
+/*======================================= saveData.cpp =======================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Binary Save Format)
+  Primary Author: Edwin Baiden
+  Description: Reading/writing the binary save (see saveData.h) and converting it to and from
+               the old savegame.json layout.
+
+               Writes never touch the existing save until the new one is complete: the file is
+               written to "<path>.<n>.tmp", flushed to disk (fsync), then renamed over the old save.
+               A crash mid-write leaves the old save (or a stray .tmp) behind, never half a save.
+               n is new for every write, so two threads saving to the same path (two server
+               sessions picking the same save name) never write into one temp file, the last
+               rename wins with a complete save.
+*/
+#include "saveData.h"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define SAVE_POSIX_IO 1
+#else
+    #define SAVE_POSIX_IO 0
+#endif
+
+using json = nlohmann::json;
+
+namespace {
+    constexpr std::array<std::uint32_t, 256> makeCrcTable()
+    {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }
+    constexpr std::array<std::uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+    // Whole file as it sits on disk, so loading is a single read
+    #pragma pack(push, 1)
+    struct SaveFile
+    {
+        SaveHeader header;
+        SaveData data;
+    };
+    #pragma pack(pop)
+
+    const char* ZOMBIE_KEYS[3] = {"zombie1", "zombie2", "zombie3"};
+}
+
+std::uint32_t saveChecksum(const void* data, std::size_t size)
+{
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) crc = CRC_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+namespace {
+    std::atomic<unsigned> tmpFilesMade{0}; // numbers the temp files of writeFileAtomic
+
+    // Writes the bytes to path and makes sure they are on disk before returning
+    bool writeDurable(const std::string& path, const void* bytes, std::size_t size)
+    {
+#if SAVE_POSIX_IO
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) return false;
+        const char* p = static_cast<const char*>(bytes);
+        while (size > 0)
+        {
+            ssize_t n = write(fd, p, size);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) { close(fd); return false; }
+            p += n;
+            size -= (std::size_t)n;
+        }
+        bool synced = fsync(fd) == 0;
+        return close(fd) == 0 && synced;
+#else
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(static_cast<const char*>(bytes), (std::streamsize)size);
+        out.flush(); // no fsync without POSIX, the rename below still keeps the old save intact
+        return static_cast<bool>(out);
+#endif
+    }
+
+    // fsync the directory so the rename itself survives a power loss
+    void syncParentDir(const std::string& path)
+    {
+#if SAVE_POSIX_IO
+        std::string dir = std::filesystem::path(path).parent_path().string();
+        int fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        fsync(fd);
+        close(fd);
+#else
+        (void)path;
+#endif
+    }
+}
+
+bool writeFileAtomic(const std::string& path, const void* bytes, std::size_t size)
+{
+    // write the new file next to the old one, only replace the old one once the new one is complete
+    const std::string tmpPath = path + "." + std::to_string(tmpFilesMade.fetch_add(1, std::memory_order_relaxed)) + SAVE_TMP_SUFFIX;
+    std::error_code ec;
+    if (!writeDurable(tmpPath, bytes, size))
+    {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    std::filesystem::rename(tmpPath, path, ec); // atomic replace on POSIX, MoveFileEx(REPLACE_EXISTING) on Windows
+    if (ec)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    syncParentDir(path);
+    return true;
+}
+
+bool writeSaveFile(const std::string& path, const SaveData& data)
+{
+    SaveFile file;
+    std::memcpy(file.header.magic, SAVE_MAGIC, 4);
+    file.header.version = SAVE_VERSION;
+    file.header.headerSize = sizeof(SaveHeader);
+    file.header.payloadSize = sizeof(SaveData);
+    file.header.checksum = saveChecksum(&data, sizeof(SaveData));
+    file.data = data;
+    return writeFileAtomic(path, &file, sizeof(file));
+}
+
+bool readSaveFile(const std::string& path, SaveData& data)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    SaveFile file;
+    in.read(reinterpret_cast<char*>(&file), sizeof(file));
+    if (in.gcount() != (std::streamsize)sizeof(file)) return false; // truncated (or an older, smaller version)
+
+    // only version 1 exists so far, older versions would be upgraded here before the checks below
+    if (std::memcmp(file.header.magic, SAVE_MAGIC, 4) != 0 || file.header.version != SAVE_VERSION ||
+        file.header.headerSize != sizeof(SaveHeader) || file.header.payloadSize != sizeof(SaveData))
+        return false;
+    if (saveChecksum(&file.data, sizeof(SaveData)) != file.header.checksum) return false;
+
+    data = file.data;
+    return true;
+}
+
+json saveDataToJson(const SaveData& data)
+{
+    json j;
+    j["player"]["class"] = archetypeInfo((Archetype)data.archetype).className;
+    j["player"]["name"] = std::string(data.name, strnlen(data.name, SAVE_NAME_MAX));
+    j["player"]["attributes"]["strength"] = data.strength;
+    j["player"]["attributes"]["dexterity"] = data.dexterity;
+    j["player"]["attributes"]["constitution"] = data.constitution;
+    j["player"]["defenseStats"]["armor"] = data.armor;
+    j["player"]["CombatStats"]["meleeDamage"] = data.meleeDamage;
+    j["player"]["CombatStats"]["rangeDamage"] = data.rangeDamage;
+    j["player"]["CombatStats"]["initiative"] = data.initiative;
+    j["player"]["weapons"]["meleeWeapon"] = data.meleeWeapon;
+    j["player"]["weapons"]["rangeWeapon"] = data.rangeWeapon;
+    j["player"]["vitalStats"]["health"] = data.health;
+    j["player"]["vitalStats"]["maxHealth"] = data.maxHealth;
+    j["player"]["inventory"] = json::array();
+    for (int i = 0; i < data.itemCount && i < SAVE_MAX_ITEMS; ++i)
+    {
+        json itemJson;
+        itemJson["name"] = itemInfo((ItemID)data.items[i].id).name;
+        itemJson["healAmount"] = data.items[i].healAmount;
+        itemJson["quantity"] = data.items[i].quantity;
+        j["player"]["inventory"].push_back(itemJson);
+    }
+    j["player"]["keys"]["key1"] = ((data.collectedItems >> (int)ItemID::Key1) & 1) != 0;
+    j["player"]["keys"]["key2"] = ((data.collectedItems >> (int)ItemID::Key2) & 1) != 0;
+    for (int z = 0; z < 3; ++z)
+        j["player"]["zombiesDefeated"][ZOMBIE_KEYS[z]] = ((data.zombiesDefeated >> z) & 1) != 0;
+
+    // packed int32 fields are unaligned, copy them before json takes a reference
+    j["world"]["currentSceneIndex"] = (int)data.currentSceneIndex;
+    j["world"]["activeEncounterID"] = (int)data.activeEncounterID;
+    j["world"]["savedPlayerSceneIndex"] = (int)data.savedPlayerSceneIndex;
+    j["world"]["collectedItems"] = json::array();
+    for (std::size_t id = 1; id < ITEM_COUNT; ++id)
+        if ((data.collectedItems >> id) & 1) j["world"]["collectedItems"].push_back(itemInfo((ItemID)id).name);
+
+    j["combat"]["ZombieHP"] = data.enemyHealth;
+    j["combat"]["ZombieMaxHP"] = data.enemyMaxHealth;
+    j["combat"]["battleWon"] = json::object();
+    for (int id = 0; id < SAVE_MAX_ENCOUNTERS; ++id)
+        if ((data.battlesFought >> id) & 1) j["combat"]["battleWon"][std::to_string(id)] = ((data.battlesWon >> id) & 1) != 0;
+    return j;
+}
+
+bool saveDataFromJson(const json& j, SaveData& data)
+{
+    data = SaveData{};
+    try
+    {
+        // old saves wrote the class name, the old loader compared against the CSV ID, take either
+        const std::string cls = j.at("player").at("class").get<std::string>();
+        int archetype = -1;
+        for (int a = 0; a < (int)Archetype::Count; ++a)
+            if (ARCHETYPES[a].player && (cls == ARCHETYPES[a].className || cls == ARCHETYPES[a].csvID)) archetype = a;
+        if (archetype < 0) return false;
+        data.archetype = (std::uint8_t)archetype;
+
+        const json& p = j.at("player");
+        std::strncpy(data.name, p.at("name").get<std::string>().c_str(), SAVE_NAME_MAX - 1);
+        data.strength = p.at("attributes").at("strength").get<std::int8_t>();
+        data.dexterity = p.at("attributes").at("dexterity").get<std::int8_t>();
+        data.constitution = p.at("attributes").at("constitution").get<std::int8_t>();
+        data.armor = p.at("defenseStats").at("armor").get<std::int8_t>();
+        data.meleeDamage = p.at("CombatStats").at("meleeDamage").get<std::uint8_t>();
+        data.rangeDamage = p.at("CombatStats").at("rangeDamage").get<std::uint8_t>();
+        data.initiative = p.at("CombatStats").at("initiative").get<std::int8_t>();
+        data.meleeWeapon = p.at("weapons").at("meleeWeapon").get<std::uint8_t>();
+        data.rangeWeapon = p.at("weapons").at("rangeWeapon").get<std::uint8_t>();
+        data.health = p.at("vitalStats").at("health").get<std::int8_t>();
+        data.maxHealth = p.at("vitalStats").at("maxHealth").get<std::int8_t>();
+        for (const auto& itemJson : p.at("inventory"))
+        {
+            ItemID id = itemIDFromName(itemJson.at("name").get<std::string>());
+            if (id == ItemID::None || data.itemCount == SAVE_MAX_ITEMS) continue; // unknown item / no room
+            data.items[data.itemCount++] = {(std::uint8_t)id, itemJson.at("quantity").get<std::uint8_t>(),
+                                            itemJson.at("healAmount").get<std::uint8_t>()};
+        }
+        for (int z = 0; z < 3; ++z)
+            if (p.at("zombiesDefeated").at(ZOMBIE_KEYS[z]).get<bool>()) data.zombiesDefeated |= (std::uint8_t)(1u << z);
+
+        const json& w = j.at("world");
+        data.currentSceneIndex = w.at("currentSceneIndex").get<int>();
+        data.activeEncounterID = w.at("activeEncounterID").get<int>();
+        data.savedPlayerSceneIndex = w.at("savedPlayerSceneIndex").get<int>();
+        for (const auto& name : w.at("collectedItems"))
+        {
+            ItemID id = itemIDFromName(name.get<std::string>());
+            if (id != ItemID::None) data.collectedItems |= 1u << (int)id;
+        }
+
+        const json& c = j.at("combat");
+        data.enemyHealth = c.at("ZombieHP").get<std::int8_t>();
+        data.enemyMaxHealth = c.at("ZombieMaxHP").get<std::int8_t>();
+        for (auto& [encounterIDStr, won] : c.at("battleWon").items())
+        {
+            int id = std::stoi(encounterIDStr);
+            if (id < 0 || id >= SAVE_MAX_ENCOUNTERS) continue;
+            data.battlesFought |= 1u << id;
+            if (won.get<bool>()) data.battlesWon |= 1u << id;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return false; // missing field or wrong type
+    }
+    return true;
+}
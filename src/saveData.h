@@ -0,0 +1,132 @@
+/*======================================== saveData.h ========================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Binary Save Format)
+  Primary Author: Edwin Baiden
+  Description: The binary save file. Everything the game saves is packed into one plain SaveData
+               struct (player stats, inventory, zombies defeated, world state, collected items and
+               keys, won battles, enemy HP), so a save is one write() and a load is one read()
+               straight into the struct, no JSON DOM and no string lookups.
+
+               File layout (little endian, packed):
+                    SaveHeader | SaveData
+
+               The header has a magic, the format version, the payload size and a CRC32 of the
+               payload, so truncated or corrupted files are rejected instead of half loaded.
+
+               JSON is still supported as a debug export/import (saveDataToJson/saveDataFromJson)
+               and uses exactly the layout the old savegame.json had, which is also how existing
+               JSON saves get migrated to the binary file.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//======================= PROJECT INCLUDES =======================
+#include "json.hpp"
+#include "characters.h" // ItemID/ItemSet and the Archetype table
+
+//=============== HEADER GUARD ===============
+#ifndef SAVEDATA_H
+#define SAVEDATA_H
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    #error "The binary save format is written straight from memory and assumes a little endian CPU"
+#endif
+
+#define SAVE_MAGIC "TLLS"            // First 4 bytes of every binary save
+#define SAVE_VERSION 1               // Bump (and add a migration in readSaveFile) when SaveData changes
+#define SAVE_DIR "../dat/usrData"    // Relative to the executable
+#define SAVE_PATH SAVE_DIR "/savegame.tls"       // Binary save the game reads and writes
+#define SAVE_JSON_PATH SAVE_DIR "/savegame.json" // Old JSON save, migrated on the first load
+#define SAVE_TMP_SUFFIX ".tmp"    // writeSaveFile writes to <path>.<n> + this first, then renames over the save
+#define SAVE_NAME_MAX 24             // Longest player name stored (including the terminator)
+#define SAVE_MAX_ITEMS 16            // Inventory entries stored (extra entries are dropped)
+#define SAVE_MAX_ENCOUNTERS 32       // Encounter IDs 0..31 fit in the battle bitmasks
+
+#pragma pack(push, 1)
+//@brief: One inventory entry, 3 bytes on disk
+//@version: 1.0
+//@author: Edwin Baiden
+struct SaveItem
+{
+    std::uint8_t id;          // ItemID
+    std::uint8_t quantity;
+    std::uint8_t healAmount;
+};
+
+//@brief: Everything in a save, one plain struct
+//@version: 1.0
+//@author: Edwin Baiden
+struct SaveData
+{
+    // player
+    std::uint8_t archetype;          // Archetype of the player
+    char name[SAVE_NAME_MAX];
+    std::int8_t strength;
+    std::int8_t dexterity;
+    std::int8_t constitution;
+    std::int8_t armor;
+    std::uint8_t meleeDamage;
+    std::uint8_t rangeDamage;
+    std::int8_t initiative;
+    std::uint8_t meleeWeapon;
+    std::uint8_t rangeWeapon;
+    std::int8_t health;
+    std::int8_t maxHealth;
+    std::uint8_t itemCount;
+    SaveItem items[SAVE_MAX_ITEMS];
+    std::uint8_t zombiesDefeated;    // bit 0..2 = zombie1..3
+
+    // world
+    std::int32_t currentSceneIndex;
+    std::int32_t activeEncounterID;
+    std::int32_t savedPlayerSceneIndex;
+    std::uint32_t collectedItems;    // ItemSet bits (keys included)
+    std::uint32_t battlesFought;     // bit per encounter ID that has a battleWon entry
+    std::uint32_t battlesWon;        // bit per encounter ID that was won
+
+    // combat
+    std::int8_t enemyHealth;         // 0 when there was no enemy
+    std::int8_t enemyMaxHealth;
+};
+
+//@brief: Header at the start of every binary save
+//@version: 1.0
+//@author: Edwin Baiden
+struct SaveHeader
+{
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t headerSize;        // sizeof(SaveHeader), lets a later version grow the header
+    std::uint32_t payloadSize;       // sizeof(SaveData) of that version
+    std::uint32_t checksum;          // saveChecksum() of the payload
+};
+#pragma pack(pop)
+
+static_assert(ITEM_COUNT <= 32, "SaveData::collectedItems only has 32 bits");
+
+//@brief: CRC32 (IEEE) of a block of bytes
+std::uint32_t saveChecksum(const void* data, std::size_t size);
+
+//@brief: Replaces path with the bytes, crash safe (written to a temp file of its own, path.<n> + SAVE_TMP_SUFFIX, fsync, rename).
+//        Safe to call from several threads on the same path, the last rename wins
+//@return - True if the new file is complete and in place, on false the old file is untouched
+bool writeFileAtomic(const std::string& path, const void* bytes, std::size_t size);
+
+//@brief: Writes the header and data to a binary save file, crash safe (temp file, fsync, rename)
+//@return - True if the whole file was written and replaced the old save
+bool writeSaveFile(const std::string& path, const SaveData& data);
+
+//@brief: Reads a binary save in one read, checks magic, version, size and checksum
+//@return - True if data was filled from a valid save
+bool readSaveFile(const std::string& path, SaveData& data);
+
+//@brief: Debug export, same layout as the old savegame.json
+nlohmann::json saveDataToJson(const SaveData& data);
+
+//@brief: Debug import / migration of an old savegame.json
+//@return - True if every required field was there
+bool saveDataFromJson(const nlohmann::json& j, SaveData& data);
+
+#endif // SAVEDATA_H
@@ -0,0 +1,292 @@
+/*===================================== saveService.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Background Saves)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the SaveService (see saveService.h).
+*/
+#include "saveService.h"
+
+#include <filesystem>
+
+void SaveService::start(const std::string& dir)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) return;
+    saveDir = dir;
+    readSaveIndex(saveDir + "/" SAVE_INDEX_NAME, committed); // no index yet = every slot empty
+    listed = committed;
+    running = true;
+    worker = std::thread(&SaveService::run, this);
+}
+
+void SaveService::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+    }
+    wake.notify_one();
+    if (worker.joinable()) worker.join(); // run() writes whatever is still queued before it returns
+}
+
+void SaveService::selectSlot(int newSlot)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (newSlot < 0 || newSlot >= SAVE_SLOT_COUNT) return;
+    slot = newSlot;
+    hasLatest = false;
+    haveJournalBase = false; // the next autosave starts this slot with a full save
+}
+
+int SaveService::activeSlot() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return slot;
+}
+
+void SaveService::submit(const SaveData& snapshot, const SlotInfo& info, Callback onDone)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    latestSnapshot = snapshot;
+    hasLatest = true;
+    journalState = snapshot;
+    haveJournalBase = true;
+
+    Job job;
+    job.slot = slot;
+    job.full = true;
+    job.data = snapshot;
+    job.info = info;
+    job.callbacks.push_back(std::move(onDone));
+    enqueue(std::move(job), lock);
+}
+
+void SaveService::autosave(const SaveData& snapshot, const SlotInfo& info)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // first autosave of the slot, or a change records cant describe: full save and a new journal
+    std::vector<AutosaveRecord> records;
+    if (!haveJournalBase || !diffSaveData(journalState, snapshot, records))
+    {
+        lock.unlock();
+        submit(snapshot, info);
+        return;
+    }
+    latestSnapshot = snapshot;
+    hasLatest = true;
+    journalState = snapshot;
+    if (records.empty()) return; // nothing changed
+
+    Job job;
+    job.slot = slot;
+    job.info = info;
+    job.records = std::move(records);
+    enqueue(std::move(job), lock);
+}
+
+void SaveService::enqueue(Job&& job, std::unique_lock<std::mutex>& lock)
+{
+    SlotInfo& shown = listed.slots[job.slot];
+    const std::uint32_t generation = shown.generation;
+    shown = job.info;
+    shown.used = 1;
+    shown.generation = generation;
+
+    if (!running)
+    {
+        // no worker (tools, or start() was never called), just write it here
+        lock.unlock();
+        bool ok = process(job);
+        lock.lock();
+        if (!journalValid && job.slot == slot) haveJournalBase = false;
+        for (auto& callback : job.callbacks) finished.emplace_back(std::move(callback), ok);
+        return;
+    }
+
+    // merge into the newest queued job of the same slot if the worker has not picked it up yet
+    if (!jobs.empty() && jobs.back().slot == job.slot)
+    {
+        Job& back = jobs.back();
+        if (job.full)
+        {
+            // an older snapshot (and records on top of it) is replaced, its callbacks wait for this one
+            back.full = true;
+            back.data = job.data;
+            back.records.clear();
+        }
+        else
+        {
+            back.records.insert(back.records.end(), job.records.begin(), job.records.end());
+        }
+        back.info = job.info;
+        for (auto& callback : job.callbacks) back.callbacks.push_back(std::move(callback));
+    }
+    else
+    {
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+int SaveService::poll()
+{
+    std::vector<std::pair<Callback, bool>> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.swap(finished);
+    }
+    // run outside the lock so a callback can submit again
+    for (auto& [callback, ok] : done)
+        if (callback) callback(ok);
+    return (int)done.size();
+}
+
+bool SaveService::latest(SaveData& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasLatest) return false;
+    out = latestSnapshot;
+    return true;
+}
+
+SaveIndex SaveService::listing() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return listed;
+}
+
+std::string SaveService::slotPath(int s) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (s < 0 || s >= SAVE_SLOT_COUNT || !committed.slots[s].used) return "";
+    return saveSlotPath(saveDir, s, committed.slots[s].generation);
+}
+
+bool SaveService::isBusy() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !jobs.empty() || writing;
+}
+
+bool SaveService::process(const Job& job)
+{
+    bool ok = true;
+    if (job.full) ok = writeFull(job.slot, job.data, job.info);
+    if (!job.records.empty()) writeRecords(job.slot, job.records, job.info); // on top of the full save above (if any)
+    return ok;
+}
+
+bool SaveService::writeFull(int s, const SaveData& data, const SlotInfo& info)
+{
+    SaveIndex index;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index = committed;
+    }
+    const SlotInfo& old = index.slots[s];
+    const bool hadOld = old.used != 0;
+    const std::uint32_t oldGeneration = old.generation;
+    const std::uint32_t generation = hadOld ? oldGeneration + 1 : 1;
+    const std::string path = saveSlotPath(saveDir, s, generation);
+
+    std::error_code ec;
+    std::filesystem::create_directories(saveDir, ec);
+    journalValid = false;
+    diskSlot = -1;
+    if (!writeSaveFile(path, data)) return false;
+    bool journalStarted = resetAutosaveJournal(autosaveJournalPath(path), saveChecksum(&data, sizeof(SaveData)));
+
+    // commit: until the index names the new generation the old save is still the slot's save
+    index.slots[s] = info;
+    index.slots[s].used = 1;
+    index.slots[s].generation = generation;
+    if (!writeSaveIndex(saveDir + "/" SAVE_INDEX_NAME, index))
+    {
+        std::filesystem::remove(path, ec);
+        std::filesystem::remove(autosaveJournalPath(path), ec);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        committed = index;
+    }
+    if (hadOld)
+    {
+        const std::string oldPath = saveSlotPath(saveDir, s, oldGeneration);
+        std::filesystem::remove(oldPath, ec);
+        std::filesystem::remove(autosaveJournalPath(oldPath), ec);
+    }
+
+    diskSlot = s;
+    diskPath = path;
+    diskState = data;
+    journalBytes = sizeof(AutosaveHeader);
+    journalValid = journalStarted;
+    indexStale = false;
+    return true;
+}
+
+void SaveService::writeRecords(int s, const std::vector<AutosaveRecord>& records, const SlotInfo& info)
+{
+    // records only mean something on top of the save the journal was started for
+    if (!journalValid || diskSlot != s || !appendAutosaveRecords(autosaveJournalPath(diskPath), records.data(), records.size()))
+    {
+        journalValid = false;
+        return;
+    }
+    for (const AutosaveRecord& r : records) applyAutosaveRecord(diskState, r);
+    journalBytes += records.size() * sizeof(AutosaveRecord);
+    staleInfo = info;
+    indexStale = true;
+
+    // compaction: fold the journal into a fresh save once it gets big
+    if (journalBytes >= AUTOSAVE_COMPACT_BYTES)
+        writeFull(s, diskState, info);
+}
+
+void SaveService::flushStaleIndex()
+{
+    if (!indexStale || diskSlot < 0) return;
+    SaveIndex index;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index = committed;
+    }
+    // same save file, only the info the load menu shows is brought up to date
+    const std::uint32_t generation = index.slots[diskSlot].generation;
+    index.slots[diskSlot] = staleInfo;
+    index.slots[diskSlot].used = 1;
+    index.slots[diskSlot].generation = generation;
+    if (writeSaveIndex(saveDir + "/" SAVE_INDEX_NAME, index))
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        committed = index;
+        indexStale = false;
+    }
+}
+
+void SaveService::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this] { return !jobs.empty() || !running; });
+        if (jobs.empty()) break; // stopping and nothing left to write
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        writing = true;
+
+        lock.unlock();
+        bool ok = process(job);
+        lock.lock();
+
+        writing = false;
+        if (!journalValid && job.slot == slot) haveJournalBase = false; // something failed, the next autosave writes everything again
+        for (auto& callback : job.callbacks) finished.emplace_back(std::move(callback), ok);
+    }
+    lock.unlock();
+    flushStaleIndex(); // the load menu should show where autosave left off next time
+}
@@ -0,0 +1,143 @@
+/*====================================== saveService.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Background Saves)
+  Primary Author: Edwin Baiden
+  Description: Saves the game without the render thread ever waiting on the disk. The main
+               thread packs the game state into a SaveData (plain data, cheap to copy) and hands
+               it to submit() together with the SlotInfo the load menu shows for it. A worker
+               thread writes it to the active save slot (saveSlots.h: new slot file, then the
+               index as the commit) and queues the result. The main thread runs the completion
+               callbacks from poll() once per frame, so callbacks can touch game state without locks.
+
+               Saves queue up in order. If a new snapshot for the same slot comes in before the
+               worker picked up the previous one, only the newest is written (both callbacks
+               still run with its result). stop() writes whatever is still queued before joining,
+               so quitting right after saving is safe.
+
+               latest() returns the last submitted snapshot of the active slot and listing() the
+               index as it will be once the queue is written, so the main menu can list and go
+               straight back to a save without waiting for the write to finish.
+
+               autosave() is the cheap version for frequent saves: only the records that changed
+               since the last autosave are appended to the slot's autosave journal (autosaveJournal.h).
+               The first autosave after selectSlot() (or one the records cant describe) writes a
+               full save, and once the journal passes AUTOSAVE_COMPACT_BYTES the worker folds it
+               into a fresh save (compaction). Journal appends dont rewrite the index, the slot's
+               info is brought up to date by the next full save or when the service stops.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "autosaveJournal.h"
+#include "saveData.h"
+#include "saveSlots.h"
+
+//=============== HEADER GUARD ===============
+#ifndef SAVESERVICE_H
+#define SAVESERVICE_H
+
+/**
+ * @author: Edwin Baiden
+ * @brief: Background save writer, submit() on the main thread, callbacks come back through poll().
+ * @version: 1.0
+ */
+class SaveService
+{
+    public:
+        using Callback = std::function<void(bool)>; // Called with true if the save hit the disk
+
+        SaveService() = default;
+        ~SaveService() { stop(); }
+        SaveService(const SaveService&) = delete;
+        SaveService& operator=(const SaveService&) = delete;
+
+        //@brief: Reads the slot index in dir and starts the worker thread (make dir absolute, the game changes directory)
+        void start(const std::string& dir);
+
+        //@brief: Writes anything still queued, then joins the worker (safe to call more than once)
+        void stop();
+
+        //@brief: Slot that submit()/autosave() write to from now on (new game or loaded slot)
+        void selectSlot(int slot);
+        int activeSlot() const;
+
+        //@brief: Queues a full save of the active slot, never waits on the disk
+        //        (without start() it is written right away on this thread)
+        void submit(const SaveData& snapshot, const SlotInfo& info, Callback onDone = nullptr);
+
+        //@brief: Queues an autosave of the active slot, only the changes since the last one go to disk
+        void autosave(const SaveData& snapshot, const SlotInfo& info);
+
+        //@brief: Runs the callbacks of the saves that finished since the last call (main thread)
+        //@return - How many saves finished (0 on almost every frame)
+        int poll();
+
+        //@brief: Copies the last snapshot submitted for the active slot (written or not) into out
+        //@return - False if nothing was submitted since the slot was selected
+        bool latest(SaveData& out) const;
+
+        //@brief: The slot index as it will be once everything queued is written (for the load menu)
+        SaveIndex listing() const;
+
+        //@brief: Save file a slot currently points to ("" for an empty slot)
+        std::string slotPath(int slot) const;
+
+        //@brief: True while a save is queued or being written
+        bool isBusy() const;
+
+    private:
+        //@brief: One queued write: a full save and/or journal records for one slot
+        struct Job
+        {
+            int slot = 0;
+            bool full = false;
+            SaveData data{};
+            SlotInfo info{};
+            std::vector<AutosaveRecord> records;
+            std::vector<Callback> callbacks;
+        };
+
+        void run();
+        void enqueue(Job&& job, std::unique_lock<std::mutex>& lock);
+        bool process(const Job& job);  // writer side (the worker, or the caller without a worker)
+        bool writeFull(int slot, const SaveData& data, const SlotInfo& info);
+        void writeRecords(int slot, const std::vector<AutosaveRecord>& records, const SlotInfo& info);
+        void flushStaleIndex();
+
+        std::string saveDir;
+        std::thread worker;
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+
+        // everything below is guarded by mutex
+        bool running = false;
+        bool writing = false;
+        std::deque<Job> jobs;
+        std::vector<std::pair<Callback, bool>> finished; // waiting for poll()
+        int slot = 0;
+        bool hasLatest = false;
+        SaveData latestSnapshot{};
+        bool haveJournalBase = false;  // journalState is what the active slot will hold once the queue is written
+        SaveData journalState{};
+        SaveIndex committed{};         // what slots.idx holds
+        SaveIndex listed{};            // committed plus everything queued
+
+        // only touched by the writer side
+        int diskSlot = -1;             // slot diskState/journal belong to
+        std::string diskPath;          // save file of diskSlot
+        SaveData diskState{};          // save + journal as they are on disk
+        std::size_t journalBytes = 0;  // size of the journal on disk
+        bool journalValid = false;     // the journal on disk was started for diskPath
+        bool indexStale = false;       // records were appended after the index was written
+        SlotInfo staleInfo{};          // newest info of diskSlot, written to the index on stop()
+};
+
+#endif // SAVESERVICE_H
@@ -0,0 +1,67 @@
+/*====================================== saveSlots.cpp =======================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Save Slots)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the save slot index (see saveSlots.h).
+*/
+#include "saveSlots.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace {
+    // Whole file as it sits on disk, so loading is a single read
+    #pragma pack(push, 1)
+    struct SaveIndexFile
+    {
+        SaveIndexHeader header;
+        SaveIndex index;
+    };
+    #pragma pack(pop)
+}
+
+std::string saveSlotPath(const std::string& dir, int slot, std::uint32_t generation)
+{
+    return dir + "/slot" + std::to_string(slot + 1) + "_" + std::to_string(generation) + ".tls";
+}
+
+bool readSaveIndex(const std::string& path, SaveIndex& index)
+{
+    index = SaveIndex{};
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    SaveIndexFile file;
+    in.read(reinterpret_cast<char*>(&file), sizeof(file));
+    if (in.gcount() != (std::streamsize)sizeof(file)) return false;
+    if (std::memcmp(file.header.magic, SAVE_INDEX_MAGIC, 4) != 0 || file.header.version != SAVE_INDEX_VERSION ||
+        file.header.slotCount != SAVE_SLOT_COUNT || file.header.slotSize != sizeof(SlotInfo))
+        return false;
+    if (saveChecksum(&file.index, sizeof(SaveIndex)) != file.header.checksum) return false;
+
+    index = file.index;
+    return true;
+}
+
+bool writeSaveIndex(const std::string& path, const SaveIndex& index)
+{
+    SaveIndexFile file;
+    std::memcpy(file.header.magic, SAVE_INDEX_MAGIC, 4);
+    file.header.version = SAVE_INDEX_VERSION;
+    file.header.slotCount = SAVE_SLOT_COUNT;
+    file.header.slotSize = sizeof(SlotInfo);
+    file.header.checksum = saveChecksum(&index, sizeof(SaveIndex));
+    file.index = index;
+    return writeFileAtomic(path, &file, sizeof(file));
+}
+
+int pickNewGameSlot(const SaveIndex& index)
+{
+    int oldest = 0;
+    for (int s = 0; s < SAVE_SLOT_COUNT; ++s)
+    {
+        if (!index.slots[s].used) return s;
+        if (index.slots[s].savedAt < index.slots[oldest].savedAt) oldest = s;
+    }
+    return oldest;
+}
@@ -0,0 +1,92 @@
+/*======================================= saveSlots.h ========================================
+  Project: TTRPG Game ?
+  Subsystem: Progress Saving and Loading (Save Slots)
+  Primary Author: Edwin Baiden
+  Description: SAVE_SLOT_COUNT save slots plus one small index file (slots.idx) with what the
+               load menu shows for every slot: character, scene name, HP, playtime, when it was
+               saved and a downscaled thumbnail of the screen. The load menu reads only the index,
+               it never opens the saves themselves.
+
+               Every full save of a slot goes to a new file (slot<N>_<generation>.tls), and only
+               then the index is rewritten (temp file + rename) with the new generation. Rewriting
+               the index is the commit: a crash before it leaves the index pointing at the old
+               file, which is still complete, so the index and the saves never disagree. The old
+               generation is deleted after the commit.
+
+               File layout (little endian, packed):
+                    SaveIndexHeader | SlotInfo[SAVE_SLOT_COUNT]
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstdint>
+#include <string>
+
+//======================= PROJECT INCLUDES =======================
+#include "saveData.h"
+
+//=============== HEADER GUARD ===============
+#ifndef SAVESLOTS_H
+#define SAVESLOTS_H
+
+#define SAVE_SLOT_COUNT 3                      // How many save slots the load menu shows
+#define SAVE_INDEX_NAME "slots.idx"            // Index file, in the save directory
+#define SAVE_INDEX_MAGIC "TLLX"                // First 4 bytes of the index
+#define SAVE_INDEX_VERSION 1                   // Bump when SlotInfo changes
+#define SAVE_SCENE_NAME_MAX 24                 // Longest scene name stored (including the terminator)
+#define SAVE_THUMB_WIDTH 80                    // Thumbnail size, 16:9 like the game screen
+#define SAVE_THUMB_HEIGHT 45
+#define SAVE_THUMB_BYTES (SAVE_THUMB_WIDTH * SAVE_THUMB_HEIGHT * 3) // RGB, top row first
+
+#pragma pack(push, 1)
+//@brief: What the load menu shows for one slot (about 10.9 KB, mostly thumbnail)
+//@version: 1.0
+//@author: Edwin Baiden
+struct SlotInfo
+{
+    std::uint8_t used;               // 0 = empty slot
+    std::uint8_t archetype;          // Archetype of the player
+    char name[SAVE_NAME_MAX];
+    char sceneName[SAVE_SCENE_NAME_MAX];
+    std::int8_t health;
+    std::int8_t maxHealth;
+    std::uint32_t playtimeSeconds;
+    std::int64_t savedAt;            // unix time
+    std::uint32_t generation;        // the slot's save is slot<N>_<generation>.tls
+    std::uint8_t thumbnail[SAVE_THUMB_BYTES];
+};
+
+//@brief: Header at the start of the index
+//@version: 1.0
+//@author: Edwin Baiden
+struct SaveIndexHeader
+{
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t slotCount;         // SAVE_SLOT_COUNT
+    std::uint32_t slotSize;          // sizeof(SlotInfo)
+    std::uint32_t checksum;          // saveChecksum() of the slots
+};
+#pragma pack(pop)
+
+//@brief: Every slot's info, what slots.idx holds
+//@version: 1.0
+//@author: Edwin Baiden
+struct SaveIndex
+{
+    SlotInfo slots[SAVE_SLOT_COUNT];
+};
+
+//@brief: Save file of a slot generation in dir (slot<N>_<generation>.tls)
+std::string saveSlotPath(const std::string& dir, int slot, std::uint32_t generation);
+
+//@brief: Reads the index in one read, checks magic, version, sizes and checksum
+//@return - False if there is no valid index (index is left all empty)
+bool readSaveIndex(const std::string& path, SaveIndex& index);
+
+//@brief: Replaces the index (writeFileAtomic, this is the commit point of a slot save)
+bool writeSaveIndex(const std::string& path, const SaveIndex& index);
+
+//@brief: Slot a new game should use: the first empty one, otherwise the one saved longest ago
+//        (the main menu asks before a new game goes over a used slot)
+int pickNewGameSlot(const SaveIndex& index);
+
+#endif // SAVESLOTS_H
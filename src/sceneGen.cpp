@@ -0,0 +1,349 @@
+/*======================================= sceneGen.cpp =======================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Layout Generator)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the seeded fight/item placement (see sceneGen.h).
+*/
+#include "sceneGen.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    //@brief: splitmix64, a few instructions per number and no shared state, so every thread of ValidateSeeds
+    //        can run its own (the dice in rng.h are one global engine meant for fights)
+    struct LayoutRng
+    {
+        std::uint64_t state;
+
+        std::uint64_t next()
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // 0..n-1 (n is at most a few hundred, the modulo bias does not matter here)
+        int below(std::size_t n) { return (int)(next() % n); }
+    };
+
+    //@brief: Picks count entries out of rooms (partial Fisher-Yates on a copy), the picks end up in rooms[0..count)
+    void pickRooms(LayoutRng& rng, std::uint8_t* rooms, std::size_t size, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count && i < size; ++i)
+            std::swap(rooms[i], rooms[i + rng.below(size - i)]);
+    }
+}
+
+const char* layoutVerdictName(LayoutVerdict verdict)
+{
+    switch (verdict)
+    {
+        case LayoutVerdict::Ok: return "ok";
+        case LayoutVerdict::Unsolvable: return "unsolvable";
+        case LayoutVerdict::FightAtStart: return "fight next to the start";
+        case LayoutVerdict::HardestFirst: return "hardest fight first";
+        default: return "?";
+    }
+}
+
+bool buildLayoutTemplate(const Building& building, const StatRow* statRows, std::size_t statCount, LayoutTemplate& out, std::string& error)
+{
+    out = LayoutTemplate{};
+    out.rooms = (int)building.scenes.size();
+    out.startRoom = building.startRoom;
+
+    // room graph inside the building, the same edges the router uses (locked doors need their key's bit)
+    struct Edge { int from, to, keyBit; };
+    std::vector<Edge> edges;
+    for (int r = 0; r < out.rooms; ++r)
+    {
+        const GameScene& scene = building.scenes[r];
+        if (scene.isEnding && out.endingRoom < 0) out.endingRoom = r;
+        for (const SceneArrow& arrow : scene.sceneArrows)
+        {
+            if (!arrow.isEnabled || SCENE_BUILDING(arrow.targetSceneIndex) != building.index) continue;
+            int keyBit = -1;
+            if (arrow.requiredKey != ItemID::None)
+            {
+                auto known = std::find(out.keys.begin(), out.keys.end(), arrow.requiredKey);
+                if (known == out.keys.end())
+                {
+                    if (out.keys.size() == ROUTE_MAX_KEYS)
+                    {
+                        error = building.name + ": more than " + std::to_string(ROUTE_MAX_KEYS) + " different keys";
+                        return false;
+                    }
+                    known = out.keys.insert(out.keys.end(), arrow.requiredKey);
+                }
+                keyBit = (int)(known - out.keys.begin());
+            }
+            edges.push_back({r, SCENE_ROOM(arrow.targetSceneIndex), keyBit});
+        }
+
+        if (scene.hasEncounter)
+        {
+            out.encounters.push_back(scene);
+            out.encounterAuthoredRoom.push_back(r);
+        }
+        for (const SceneItem& item : scene.sceneItems)
+        {
+            out.items.push_back(item);
+            out.itemAuthoredRoom.push_back(r);
+        }
+    }
+
+    std::size_t loot = 0;
+    for (const SceneItem& item : out.items)
+    {
+        auto key = std::find(out.keys.begin(), out.keys.end(), item.item);
+        out.itemKeyBit.push_back(key == out.keys.end() ? -1 : (int)(key - out.keys.begin()));
+        loot += item.requiresVictory;
+    }
+    if (out.encounters.size() > GEN_MAX_ENCOUNTERS || out.items.size() > GEN_MAX_ITEMS)
+    {
+        error = building.name + ": a layout holds " + std::to_string(GEN_MAX_ENCOUNTERS) + " fights and " + std::to_string(GEN_MAX_ITEMS) + " items";
+        return false;
+    }
+    if (loot > out.encounters.size())
+    {
+        error = building.name + ": more loot than fights to drop it";
+        return false;
+    }
+
+    // the spawn pool, how hard each one is comes from its CSV row
+    if (!out.encounters.empty() && (building.enemies.empty() || building.enemies.size() > 0xFF))
+    {
+        error = building.name + ": needs 1 to 255 enemies to spawn";
+        return false;
+    }
+    for (const char* id : building.enemies)
+    {
+        const StatRow* row = std::find_if(statRows, statRows + statCount, [id](const StatRow& r) { return std::strcmp(r.id, id) == 0; });
+        if (row == statRows + statCount)
+        {
+            error = building.name + ": enemy \"" + id + "\" has no starting stats";
+            return false;
+        }
+        out.enemyThreats.push_back(enemyThreat(*row));
+    }
+
+    // rooms reached from the start and how far, once per key mask (a BFS each, at most 2^ROUTE_MAX_KEYS of them)
+    const std::size_t masks = std::size_t(1) << out.keys.size();
+    out.reach.assign(masks, LayoutTemplate::RoomSet());
+    out.distance.assign(masks * out.rooms, ROUTE_UNREACHABLE);
+    std::vector<int> queue(out.rooms);
+    for (std::size_t mask = 0; mask < masks; ++mask)
+    {
+        std::uint8_t* dist = out.distance.data() + mask * out.rooms;
+        int head = 0, tail = 0;
+        dist[out.startRoom] = 0;
+        queue[tail++] = out.startRoom;
+        while (head < tail)
+        {
+            const int room = queue[head++];
+            out.reach[mask].set(room);
+            for (const Edge& edge : edges)
+            {
+                if (edge.from != room || edge.to >= out.rooms || dist[edge.to] != ROUTE_UNREACHABLE) continue;
+                if (edge.keyBit >= 0 && !((mask >> edge.keyBit) & 1)) continue; // locked
+                dist[edge.to] = (std::uint8_t)std::min(dist[room] + 1, ROUTE_UNREACHABLE - 1);
+                queue[tail++] = edge.to;
+            }
+        }
+    }
+
+    for (int r = 0; r < out.rooms; ++r)
+    {
+        if (r == out.endingRoom) continue;
+        out.itemRooms.push_back((std::uint8_t)r);
+        const int walk = out.distance[r]; // mask 0, rooms behind a locked door count as far away
+        if (r != out.startRoom && walk > GEN_SAFE_RADIUS) out.fightRooms.push_back((std::uint8_t)r);
+    }
+    if (out.fightRooms.size() < out.encounters.size() || out.itemRooms.size() < out.items.size())
+    {
+        error = building.name + ": not enough rooms to place every fight and item";
+        return false;
+    }
+    return true;
+}
+
+void authoredLayout(const LayoutTemplate& tmpl, const Building& building, SceneLayout& out)
+{
+    out = SceneLayout{};
+    for (std::size_t i = 0; i < tmpl.encounters.size(); ++i)
+    {
+        out.encounterRoom[i] = (std::uint8_t)tmpl.encounterAuthoredRoom[i];
+        for (std::size_t e = 0; e < building.enemies.size(); ++e)
+            if (std::strcmp(building.enemies[e], tmpl.encounters[i].enemyStatID) == 0) out.enemy[i] = (std::uint8_t)e;
+    }
+    for (std::size_t i = 0; i < tmpl.items.size(); ++i)
+        out.itemRoom[i] = (std::uint8_t)tmpl.itemAuthoredRoom[i];
+}
+
+void generateLayout(const LayoutTemplate& tmpl, std::uint32_t seed, SceneLayout& out)
+{
+    LayoutRng rng{seed};
+    out.seed = seed;
+    std::uint8_t rooms[SCENE_MAX_PER_BUILDING];
+
+    // fights: distinct rooms out of the ones far enough from the start, a random enemy of the pool each
+    const std::size_t fights = tmpl.encounters.size();
+    std::copy(tmpl.fightRooms.begin(), tmpl.fightRooms.end(), rooms);
+    pickRooms(rng, rooms, tmpl.fightRooms.size(), fights);
+    for (std::size_t i = 0; i < fights; ++i)
+    {
+        out.encounterRoom[i] = rooms[i];
+        out.enemy[i] = (std::uint8_t)rng.below(tmpl.enemyThreats.size());
+    }
+
+    // items: one per room, loot goes to a fight that has none yet (the next one after a random pick)
+    bool used[SCENE_MAX_PER_BUILDING] = {};
+    bool lootTaken[GEN_MAX_ENCOUNTERS] = {};
+    for (std::size_t i = 0; i < tmpl.items.size(); ++i)
+    {
+        if (!tmpl.items[i].requiresVictory) continue;
+        std::size_t fight = (std::size_t)rng.below(fights);
+        while (lootTaken[fight]) fight = (fight + 1) % fights;
+        lootTaken[fight] = true;
+        out.itemRoom[i] = out.encounterRoom[fight];
+        used[out.itemRoom[i]] = true;
+    }
+    std::copy(tmpl.itemRooms.begin(), tmpl.itemRooms.end(), rooms);
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < tmpl.items.size(); ++i)
+    {
+        if (tmpl.items[i].requiresVictory) continue;
+        do {
+            pickRooms(rng, rooms + next, tmpl.itemRooms.size() - next, 1); // shuffle lazily, only as far as picks go
+        } while (used[rooms[next++]]);
+        out.itemRoom[i] = rooms[next - 1];
+        used[out.itemRoom[i]] = true;
+    }
+}
+
+LayoutVerdict checkLayout(const LayoutTemplate& tmpl, const SceneLayout& layout)
+{
+    const std::size_t fights = tmpl.encounters.size();
+    int fightPhase[GEN_MAX_ENCOUNTERS];
+    std::uint32_t phaseMask[ROUTE_MAX_KEYS + 1] = {};
+    std::fill(fightPhase, fightPhase + fights, -1);
+
+    // walk with the keys in hand, pick up every key in reach, repeat until no new key turns up (one phase per round)
+    std::uint32_t mask = 0;
+    int phase = 0;
+    for (;; ++phase)
+    {
+        phaseMask[phase] = mask;
+        const LayoutTemplate::RoomSet& reach = tmpl.reach[mask];
+        for (std::size_t i = 0; i < fights; ++i)
+            if (fightPhase[i] < 0 && reach.test(layout.encounterRoom[i])) fightPhase[i] = phase;
+
+        std::uint32_t gained = mask;
+        for (std::size_t i = 0; i < tmpl.items.size(); ++i)
+            if (tmpl.itemKeyBit[i] >= 0 && reach.test(layout.itemRoom[i])) gained |= 1u << tmpl.itemKeyBit[i];
+        if (gained == mask) break;
+        mask = gained;
+    }
+
+    const LayoutTemplate::RoomSet& reach = tmpl.reach[mask];
+    if (tmpl.endingRoom >= 0 && !reach.test(tmpl.endingRoom)) return LayoutVerdict::Unsolvable;
+    for (std::size_t i = 0; i < tmpl.items.size(); ++i)
+    {
+        if (!reach.test(layout.itemRoom[i])) return LayoutVerdict::Unsolvable;
+        if (!tmpl.items[i].requiresVictory) continue;
+        bool dropped = false; // loot only shows up after a fight in its room
+        for (std::size_t f = 0; f < fights; ++f) dropped |= layout.encounterRoom[f] == layout.itemRoom[i];
+        if (!dropped) return LayoutVerdict::Unsolvable;
+    }
+    for (std::size_t i = 0; i < fights; ++i)
+    {
+        if (fightPhase[i] < 0) return LayoutVerdict::Unsolvable;
+        for (std::size_t j = 0; j < i; ++j)
+            if (layout.encounterRoom[i] == layout.encounterRoom[j]) return LayoutVerdict::Unsolvable; // a room holds one fight
+    }
+
+    // fair: the player gets to look around before the first fight...
+    for (std::size_t i = 0; i < fights; ++i)
+    {
+        const int room = layout.encounterRoom[i];
+        if (room == tmpl.startRoom || tmpl.distance[room] <= GEN_SAFE_RADIUS) return LayoutVerdict::FightAtStart;
+    }
+
+    // ...and the fight they run into first (earliest phase, then closest) is not the one harder than all others
+    if (fights > 1)
+    {
+        std::size_t first = 0;
+        auto walk = [&](std::size_t i) { return tmpl.distance[phaseMask[fightPhase[i]] * tmpl.rooms + layout.encounterRoom[i]]; };
+        for (std::size_t i = 1; i < fights; ++i)
+            if (fightPhase[i] < fightPhase[first] || (fightPhase[i] == fightPhase[first] && walk(i) < walk(first))) first = i;
+
+        bool hardest = true;
+        for (std::size_t i = 0; i < fights && hardest; ++i)
+            if (i != first) hardest = tmpl.enemyThreats[layout.enemy[first]] > tmpl.enemyThreats[layout.enemy[i]];
+        if (hardest) return LayoutVerdict::HardestFirst;
+    }
+    return LayoutVerdict::Ok;
+}
+
+void applyLayout(Building& building, const LayoutTemplate& tmpl, const SceneLayout& layout)
+{
+    const char* empty = building.strings.c_str(); // offset 0 of a building's strings is ""
+
+    for (GameScene& scene : building.scenes)
+    {
+        scene.hasEncounter = false;
+        scene.encounterID = -1;
+        scene.enemyStatID = empty;
+        scene.environmentTexture = empty;
+        scene.combatBgOffset = scene.playerCharOffset = scene.enemyCharOffset = {0.0f, 0.0f};
+        scene.playerScale = scene.enemyScale = {0.0f, 0.0f};
+    }
+    for (std::size_t i = 0; i < tmpl.encounters.size(); ++i)
+    {
+        const GameScene& fight = tmpl.encounters[i];
+        GameScene& scene = building.scenes[layout.encounterRoom[i]];
+        scene.hasEncounter = true;
+        scene.encounterID = fight.encounterID;
+        scene.enemyStatID = building.enemies[layout.enemy[i]];
+        scene.environmentTexture = fight.environmentTexture;
+        scene.combatBgOffset = fight.combatBgOffset;
+        scene.playerCharOffset = fight.playerCharOffset;
+        scene.enemyCharOffset = fight.enemyCharOffset;
+        scene.playerScale = fight.playerScale;
+        scene.enemyScale = fight.enemyScale;
+    }
+
+    // items are regrouped by room so every room still points at one contiguous run
+    std::vector<SceneItem> items;
+    std::vector<std::size_t> first(building.scenes.size() + 1, 0);
+    items.reserve(tmpl.items.size());
+    for (std::size_t room = 0; room < building.scenes.size(); ++room)
+    {
+        first[room] = items.size();
+        for (std::size_t i = 0; i < tmpl.items.size(); ++i)
+            if (layout.itemRoom[i] == room) items.push_back(tmpl.items[i]);
+    }
+    first[building.scenes.size()] = items.size();
+    building.items = std::move(items);
+    for (std::size_t room = 0; room < building.scenes.size(); ++room)
+        building.scenes[room].sceneItems = {building.items.data() + first[room], first[room + 1] - first[room]};
+}
+
+bool applyLayoutSeed(Building& building, const StatRow* statRows, std::size_t statCount, std::uint32_t seed, std::string& error)
+{
+    if (seed == 0) return true;
+    LayoutTemplate tmpl;
+    if (!buildLayoutTemplate(building, statRows, statCount, tmpl, error)) return false;
+    SceneLayout layout;
+    generateLayout(tmpl, seed, layout);
+    const LayoutVerdict verdict = checkLayout(tmpl, layout);
+    if (verdict != LayoutVerdict::Ok)
+    {
+        error = "seed " + std::to_string(seed) + " is " + layoutVerdictName(verdict) + " in " + building.name;
+        return false;
+    }
+    applyLayout(building, tmpl, layout);
+    return true;
+}
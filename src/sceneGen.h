@@ -0,0 +1,117 @@
+/*======================================== sceneGen.h ========================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Layout Generator)
+  Primary Author: Edwin Baiden
+  Description: Seeded placement of a building's fights and items. The rooms and arrows stay the
+               authored ones, a seed decides which rooms the fights are in, which enemy (stat row
+               from the CSV, out of the building's "enemies" pool) each fight spawns and which room
+               every item lies in. The same seed always gives the same layout.
+
+               A layout is only used if checkLayout() passes it:
+                    - solvable: starting with no keys, walk everywhere the keys in hand open, pick up
+                      every key found there, repeat. Every fight, every item and the ending room have
+                      to be reached that way, so a key is never behind the door it opens
+                    - fair: no fight within GEN_SAFE_RADIUS rooms of the start, and the first fight
+                      the player can reach is not stronger than every other fight (enemyThreat())
+
+               LayoutTemplate is everything the generator needs about a building, built once:
+               the rooms each key mask reaches (one bitset per mask) and the distances from the
+               start. Generating and checking a seed then touches no strings and allocates nothing,
+               which is what lets ValidateSeeds (validateSeeds.cpp) go through a few hundred
+               thousand seeds a second and only seeds it passed get shipped (SCENE_LAYOUT_SEED).
+
+               A fight keeps its combat staging (background, offsets, scales) when it moves to
+               another room, and loot (items that appear after a victory) always goes into a room
+               with a fight.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "sceneGraph.h"
+#include "sceneRoute.h"     // ROUTE_MAX_KEYS / ROUTE_UNREACHABLE
+#include "statSchema.h"
+
+//=============== HEADER GUARD ===============
+#ifndef SCENEGEN_H
+#define SCENEGEN_H
+
+#define SCENE_LAYOUT_SEED 0u        // Layout the game plays, 0 = the authored one (put a seed ValidateSeeds passed here)
+#define GEN_SAFE_RADIUS 1           // No fight within this many rooms of the start (keyless walking distance)
+#define GEN_MAX_ENCOUNTERS 16       // Fights per building a layout can place
+#define GEN_MAX_ITEMS 32            // Items per building a layout can place
+
+//@author: Edwin Baiden
+//@brief: Why checkLayout() turned a layout down (Ok if it did not)
+//@version: 1.0
+enum class LayoutVerdict : std::uint8_t { Ok, Unsolvable, FightAtStart, HardestFirst, Count };
+
+//@brief: Readable name of a verdict (ValidateSeeds report)
+const char* layoutVerdictName(LayoutVerdict verdict);
+
+//@brief: How hard an enemy is to beat: health to chew through plus armor to hit (how long the fight lasts)
+constexpr int enemyThreat(const StatRow& row) { return row.get(MAX_HEALTH) + row.get(ARMOR); }
+
+//@author: Edwin Baiden
+//@brief: Where one seed puts everything (indexes into the template's lists, rooms are building room indexes)
+//@version: 1.0
+struct SceneLayout
+{
+    std::uint32_t seed = 0;
+    std::uint8_t encounterRoom[GEN_MAX_ENCOUNTERS] = {};   // per fight (LayoutTemplate::encounters)
+    std::uint8_t enemy[GEN_MAX_ENCOUNTERS] = {};           // per fight, index in LayoutTemplate::enemyThreats / Building::enemies
+    std::uint8_t itemRoom[GEN_MAX_ITEMS] = {};             // per item (LayoutTemplate::items)
+};
+
+/**
+ * @author: Edwin Baiden
+ * @brief: What the generator knows about one building (authored fights and items, reachability per key mask)
+ * @version: 1.0
+ */
+struct LayoutTemplate
+{
+    using RoomSet = std::bitset<SCENE_MAX_PER_BUILDING>;
+
+    int rooms = 0;
+    int startRoom = 0;
+    int endingRoom = -1;
+    std::vector<GameScene> encounters;          // authored fight rooms (encounterID and combat staging move with the fight)
+    std::vector<int> encounterAuthoredRoom;
+    std::vector<SceneItem> items;               // authored items
+    std::vector<int> itemAuthoredRoom;
+    std::vector<int> itemKeyBit;                // bit of the key an item is (-1 if it opens nothing here)
+    std::vector<int> enemyThreats;              // per Building::enemies entry
+    std::vector<ItemID> keys;                   // bit i of a key mask = keys[i]
+    std::vector<RoomSet> reach;                 // per key mask, rooms reachable from the start
+    std::vector<std::uint8_t> distance;         // per key mask, rooms from the start [mask * rooms + room]
+    std::vector<std::uint8_t> fightRooms;       // rooms a fight may be placed in (far enough from the start, not the ending)
+    std::vector<std::uint8_t> itemRooms;        // rooms an item may be placed in (not the ending)
+};
+
+//@brief: Reads a loaded building into a template, threats come from the stat rows (the enemies' CSV rows)
+//@return - False with a message in error if the building has more fights/items/keys than a layout holds,
+//          an enemy without a stat row, or not enough rooms to place everything
+bool buildLayoutTemplate(const Building& building, const StatRow* statRows, std::size_t statCount, LayoutTemplate& out, std::string& error);
+
+//@brief: The authored layout (every fight and item where the JSON put it, the enemies the rooms have)
+void authoredLayout(const LayoutTemplate& tmpl, const Building& building, SceneLayout& out);
+
+//@brief: Places fights, enemies and items from the seed (distinct rooms, loot with a fight), does not check it
+void generateLayout(const LayoutTemplate& tmpl, std::uint32_t seed, SceneLayout& out);
+
+//@brief: Solvability and fairness of a layout (see the top of the file)
+LayoutVerdict checkLayout(const LayoutTemplate& tmpl, const SceneLayout& layout);
+
+//@brief: Moves the building's fights and items to where the layout puts them (building has to be the one the template was built from)
+void applyLayout(Building& building, const LayoutTemplate& tmpl, const SceneLayout& layout);
+
+//@brief: All of the above for one seed: builds the template, generates the layout and applies it if checkLayout passes it
+//        (what the game and the session server do to every building they load, seed 0 keeps the authored layout)
+//@return - False with the reason in error if the building keeps its authored layout because of a broken template or seed
+bool applyLayoutSeed(Building& building, const StatRow* statRows, std::size_t statCount, std::uint32_t seed, std::string& error);
+
+#endif // SCENEGEN_H
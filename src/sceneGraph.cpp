@@ -0,0 +1,535 @@
+/*====================================== sceneGraph.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Scene Graph)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the building data files (see sceneGraph.h).
+*/
+#include "sceneGraph.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#include "json.hpp"
+#include "saveData.h" // SAVE_MAX_ENCOUNTERS
+#include "startingStats.gen.h"
+
+using json = nlohmann::json;
+
+namespace {
+    // ---- blob records (fixed size, strings are offsets into the string table, 0 = "") ----
+#pragma pack(push, 1)
+    struct SceneBlobHeader
+    {
+        char magic[4];
+        std::uint16_t version;
+        std::uint16_t buildingIndex;
+        std::uint16_t sceneCount;
+        std::uint16_t arrowCount;
+        std::uint16_t itemCount;
+        std::uint16_t textureCount;
+        std::uint16_t startRoom;
+        std::uint16_t minimapTexture;
+        std::uint16_t enemyCount;
+        std::uint32_t name;
+        std::uint32_t stringBytes;
+    };
+
+    struct SceneRecord
+    {
+        std::uint32_t name;
+        std::uint16_t texture;
+        std::uint32_t combatTexture;
+        float minimap[3];            // x, y, rotation
+        std::uint16_t firstArrow, arrowCount;
+        std::uint16_t firstItem, itemCount;
+        std::int16_t encounterID;    // -1 = no fight
+        float combat[10];            // bg offset, player offset, enemy offset, player scale, enemy scale
+        std::uint32_t enemy;         // stat ID of the enemy (CSV row)
+        std::uint32_t ending;
+    };
+
+    struct ArrowRecord
+    {
+        float area[4];
+        std::int8_t dir;
+        std::int32_t target;         // SCENE_ID
+        std::uint8_t enabled;
+        std::uint8_t requiredKey;
+        std::uint32_t text;
+    };
+
+    struct ItemRecord
+    {
+        std::uint8_t item;
+        std::uint8_t afterVictory;
+        std::uint16_t texture;
+        float area[4];
+        std::uint32_t text;
+    };
+#pragma pack(pop)
+
+    //@brief: Collects the records of a building while compiling (strings and textures are deduplicated)
+    struct BlobWriter
+    {
+        std::vector<SceneRecord> scenes;
+        std::vector<ArrowRecord> arrows;
+        std::vector<ItemRecord> items;
+        std::vector<std::uint32_t> textures;
+        std::vector<std::uint32_t> enemies;
+        std::string strings = std::string(1, '\0'); // offset 0 is the empty string
+        std::map<std::string, std::uint32_t> stringOffsets;
+        std::map<std::string, std::uint16_t> textureIndexes;
+
+        std::uint32_t string(const std::string& s)
+        {
+            if (s.empty()) return 0;
+            auto it = stringOffsets.find(s);
+            if (it != stringOffsets.end()) return it->second;
+            const std::uint32_t offset = (std::uint32_t)strings.size();
+            strings.append(s).push_back('\0');
+            stringOffsets.emplace(s, offset);
+            return offset;
+        }
+
+        std::uint16_t texture(const std::string& path)
+        {
+            auto it = textureIndexes.find(path);
+            if (it != textureIndexes.end()) return it->second;
+            const std::uint16_t index = (std::uint16_t)textures.size();
+            textures.push_back(string(path));
+            textureIndexes.emplace(path, index);
+            return index;
+        }
+    };
+
+    //@brief: Reads a [x, y(, w, h)] array into a record field (records are packed, so it goes through memcpy), zeros if missing
+    void readVec(const json& j, const char* key, float* out, std::size_t count)
+    {
+        float values[4] = {};
+        if (j.contains(key))
+        {
+            const json& v = j.at(key);
+            if (!v.is_array() || v.size() != count) throw std::runtime_error(std::string("\"") + key + "\" needs " + std::to_string(count) + " numbers");
+            for (std::size_t i = 0; i < count; ++i) values[i] = v.at(i).get<float>();
+        }
+        std::memcpy(out, values, count * sizeof(float));
+    }
+
+    std::int8_t parseDirection(const std::string& dir)
+    {
+        if (dir == "up") return UP;
+        if (dir == "down") return DOWN;
+        if (dir == "left") return LEFT;
+        if (dir == "right") return RIGHT;
+        if (dir == "none") return NONE;
+        throw std::runtime_error("unknown arrow direction \"" + dir + "\"");
+    }
+
+    //@brief: Room ID -> room index of a building JSON
+    std::map<std::string, int> readRoomIDs(const json& building)
+    {
+        std::map<std::string, int> rooms;
+        const json& scenes = building.at("scenes");
+        for (std::size_t i = 0; i < scenes.size(); ++i)
+        {
+            if (!rooms.emplace(scenes[i].at("id").get<std::string>(), (int)i).second)
+                throw std::runtime_error("room id \"" + scenes[i].at("id").get<std::string>() + "\" is used twice");
+        }
+        return rooms;
+    }
+
+    bool readJsonFile(const std::string& path, json& out)
+    {
+        std::ifstream in(path);
+        if (!in.is_open()) return false;
+        out = json::parse(in); // throws on broken JSON, caught by compileSceneJson
+        return true;
+    }
+
+    //@brief: Resolves "room" (this building) or "building<N>:room" to a scene ID
+    int resolveTarget(const std::string& target, int buildingIndex, const std::map<std::string, int>& rooms, const std::string& dir)
+    {
+        const std::size_t colon = target.find(':');
+        if (colon == std::string::npos)
+        {
+            auto it = rooms.find(target);
+            if (it == rooms.end()) throw std::runtime_error("arrow leads to unknown room \"" + target + "\"");
+            return SCENE_ID(buildingIndex, it->second);
+        }
+
+        const std::string buildingName = target.substr(0, colon);
+        const std::string room = target.substr(colon + 1);
+        int other = 0;
+        if (buildingName.rfind("building", 0) != 0 || std::sscanf(buildingName.c_str() + 8, "%d", &other) != 1
+            || other < 1 || other > SCENE_MAX_BUILDINGS)
+            throw std::runtime_error("bad building in \"" + target + "\" (expected building<N>:room)");
+        if (other - 1 == buildingIndex) return resolveTarget(room, buildingIndex, rooms, dir);
+
+        json otherBuilding;
+        if (!readJsonFile(sceneJsonPath(dir, other - 1), otherBuilding))
+            throw std::runtime_error("arrow leads into " + buildingName + " but " + sceneJsonPath(dir, other - 1) + " does not exist");
+        const std::map<std::string, int> otherRooms = readRoomIDs(otherBuilding);
+        auto it = otherRooms.find(room);
+        if (it == otherRooms.end()) throw std::runtime_error("arrow leads to unknown room \"" + target + "\"");
+        return SCENE_ID(other - 1, it->second);
+    }
+
+    //@brief: Throws if id is not a row of the starting stats CSV (enemies are created from their stat row)
+    void checkEnemyID(const std::string& id)
+    {
+        for (const StatRow& row : GENERATED_STAT_ROWS)
+            if (id == row.id) return;
+        throw std::runtime_error("enemy \"" + id + "\" is not in the starting stats CSV");
+    }
+
+    template <typename T>
+    void appendRecords(std::vector<char>& blob, const std::vector<T>& records)
+    {
+        const char* bytes = reinterpret_cast<const char*>(records.data());
+        blob.insert(blob.end(), bytes, bytes + records.size() * sizeof(T));
+    }
+}
+
+std::string sceneJsonPath(const std::string& dir, int buildingIndex)
+{
+    return dir + "/building" + std::to_string(buildingIndex + 1) + ".json";
+}
+
+std::string sceneBlobPath(const std::string& dir, int buildingIndex)
+{
+    return dir + "/building" + std::to_string(buildingIndex + 1) + ".tlb";
+}
+
+bool compileSceneJson(const std::string& jsonPath, int buildingIndex, std::vector<char>& blob, std::string& error)
+{
+    try
+    {
+        json building;
+        if (!readJsonFile(jsonPath, building))
+        {
+            error = "could not open " + jsonPath;
+            return false;
+        }
+        const std::string dir = std::filesystem::path(jsonPath).parent_path().string();
+        const std::map<std::string, int> rooms = readRoomIDs(building);
+        const json& scenes = building.at("scenes");
+        if (scenes.empty() || scenes.size() > SCENE_MAX_PER_BUILDING)
+            throw std::runtime_error("a building needs 1 to " + std::to_string(SCENE_MAX_PER_BUILDING) + " rooms");
+
+        BlobWriter w;
+        SceneBlobHeader header{};
+        std::memcpy(header.magic, SCENE_BLOB_MAGIC, 4);
+        header.version = SCENE_BLOB_VERSION;
+        header.buildingIndex = (std::uint16_t)buildingIndex;
+        header.name = w.string(building.value("name", "Building " + std::to_string(buildingIndex + 1)));
+        header.minimapTexture = w.texture(building.at("minimap").get<std::string>());
+        auto start = rooms.find(building.value("start", scenes[0].at("id").get<std::string>()));
+        if (start == rooms.end()) throw std::runtime_error("\"start\" is not a room of this building");
+        header.startRoom = (std::uint16_t)start->second;
+
+        for (const json& s : scenes)
+        {
+            const std::string id = s.at("id").get<std::string>();
+            try
+            {
+                SceneRecord r{};
+                r.name = w.string(s.at("name").get<std::string>());
+                r.texture = w.texture(s.at("texture").get<std::string>());
+                readVec(s, "minimap", r.minimap, 2);
+                r.minimap[2] = s.value("rotation", 0.0f);
+                r.ending = w.string(s.value("ending", ""));
+
+                r.firstArrow = (std::uint16_t)w.arrows.size();
+                for (const json& a : s.value("arrows", json::array()))
+                {
+                    ArrowRecord arrow{};
+                    readVec(a, "area", arrow.area, 4);
+                    arrow.dir = parseDirection(a.at("dir").get<std::string>());
+                    arrow.target = resolveTarget(a.at("to").get<std::string>(), buildingIndex, rooms, dir);
+                    arrow.enabled = a.value("enabled", true);
+                    arrow.text = w.string(a.value("text", ""));
+                    if (a.contains("key"))
+                    {
+                        const ItemID key = itemIDFromName(a.at("key").get<std::string>());
+                        if (key == ItemID::None) throw std::runtime_error("unknown key \"" + a.at("key").get<std::string>() + "\"");
+                        arrow.requiredKey = (std::uint8_t)key;
+                    }
+                    w.arrows.push_back(arrow);
+                }
+                r.arrowCount = (std::uint16_t)(w.arrows.size() - r.firstArrow);
+
+                r.firstItem = (std::uint16_t)w.items.size();
+                for (const json& i : s.value("items", json::array()))
+                {
+                    ItemRecord item{};
+                    const ItemID itemID = itemIDFromName(i.at("item").get<std::string>());
+                    if (itemID == ItemID::None) throw std::runtime_error("unknown item \"" + i.at("item").get<std::string>() + "\"");
+                    item.item = (std::uint8_t)itemID;
+                    item.afterVictory = i.value("afterVictory", false);
+                    item.texture = w.texture(i.at("texture").get<std::string>());
+                    readVec(i, "area", item.area, 4);
+                    item.text = w.string(i.value("text", ""));
+                    w.items.push_back(item);
+                }
+                r.itemCount = (std::uint16_t)(w.items.size() - r.firstItem);
+
+                const int encounter = s.value("encounter", -1);
+                if (encounter < -1 || encounter >= SAVE_MAX_ENCOUNTERS)
+                    throw std::runtime_error("\"encounter\" has to be 0 to " + std::to_string(SAVE_MAX_ENCOUNTERS - 1) + " (or -1, no fight)");
+                r.encounterID = (std::int16_t)encounter;
+                if (r.encounterID >= 0)
+                {
+                    const json& c = s.at("combat");
+                    r.combatTexture = w.string(c.at("background").get<std::string>());
+                    readVec(c, "backgroundOffset", r.combat + 0, 2);
+                    readVec(c, "playerOffset", r.combat + 2, 2);
+                    readVec(c, "enemyOffset", r.combat + 4, 2);
+                    readVec(c, "playerScale", r.combat + 6, 2);
+                    readVec(c, "enemyScale", r.combat + 8, 2);
+                    const std::string enemy = s.at("enemy").get<std::string>();
+                    checkEnemyID(enemy);
+                    r.enemy = w.string(enemy);
+                    if (std::find(w.enemies.begin(), w.enemies.end(), r.enemy) == w.enemies.end()) w.enemies.push_back(r.enemy);
+                }
+                w.scenes.push_back(r);
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error("room \"" + id + "\": " + e.what());
+            }
+        }
+
+        // the spawn pool of generated layouts: the "enemies" list, or the enemies the rooms already have
+        if (building.contains("enemies"))
+        {
+            w.enemies.clear();
+            for (const json& e : building.at("enemies"))
+            {
+                checkEnemyID(e.get<std::string>());
+                w.enemies.push_back(w.string(e.get<std::string>()));
+            }
+        }
+
+        header.sceneCount = (std::uint16_t)w.scenes.size();
+        header.arrowCount = (std::uint16_t)w.arrows.size();
+        header.itemCount = (std::uint16_t)w.items.size();
+        header.textureCount = (std::uint16_t)w.textures.size();
+        header.enemyCount = (std::uint16_t)w.enemies.size();
+        header.stringBytes = (std::uint32_t)w.strings.size();
+
+        blob.clear();
+        const char* headerBytes = reinterpret_cast<const char*>(&header);
+        blob.insert(blob.end(), headerBytes, headerBytes + sizeof(header));
+        appendRecords(blob, w.scenes);
+        appendRecords(blob, w.arrows);
+        appendRecords(blob, w.items);
+        appendRecords(blob, w.textures);
+        appendRecords(blob, w.enemies);
+        blob.insert(blob.end(), w.strings.begin(), w.strings.end());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        error = jsonPath + ": " + e.what();
+        return false;
+    }
+}
+
+bool loadSceneBlob(const std::vector<char>& blob, int buildingIndex, Building& out)
+{
+    SceneBlobHeader header;
+    if (blob.size() < sizeof(header)) return false;
+    std::memcpy(&header, blob.data(), sizeof(header));
+    if (std::memcmp(header.magic, SCENE_BLOB_MAGIC, 4) != 0 || header.version != SCENE_BLOB_VERSION) return false;
+    if (header.buildingIndex >= SCENE_MAX_BUILDINGS || (buildingIndex >= 0 && header.buildingIndex != buildingIndex)) return false;
+
+    const std::size_t expected = sizeof(header) + header.sceneCount * sizeof(SceneRecord) + header.arrowCount * sizeof(ArrowRecord)
+        + header.itemCount * sizeof(ItemRecord) + (header.textureCount + header.enemyCount) * sizeof(std::uint32_t) + header.stringBytes;
+    if (blob.size() != expected || header.sceneCount == 0 || header.sceneCount > SCENE_MAX_PER_BUILDING
+        || header.stringBytes == 0 || header.startRoom >= header.sceneCount || header.minimapTexture >= header.textureCount) return false;
+
+    const char* cursor = blob.data() + sizeof(header);
+    std::vector<SceneRecord> scenes(header.sceneCount);
+    std::vector<ArrowRecord> arrows(header.arrowCount);
+    std::vector<ItemRecord> items(header.itemCount);
+    std::vector<std::uint32_t> textures(header.textureCount);
+    std::vector<std::uint32_t> enemies(header.enemyCount);
+    auto take = [&cursor](void* dst, std::size_t bytes) { if (bytes) std::memcpy(dst, cursor, bytes); cursor += bytes; };
+    take(scenes.data(), scenes.size() * sizeof(SceneRecord));
+    take(arrows.data(), arrows.size() * sizeof(ArrowRecord));
+    take(items.data(), items.size() * sizeof(ItemRecord));
+    take(textures.data(), textures.size() * sizeof(std::uint32_t));
+    take(enemies.data(), enemies.size() * sizeof(std::uint32_t));
+
+    Building& b = out; // filled in place, the const char* point into b.strings (a moved small string would leave them dangling)
+    b = Building{};
+    b.strings.assign(cursor, header.stringBytes);
+    if (b.strings.back() != '\0') return false;
+    auto str = [&b](std::uint32_t offset) -> const char* { return offset < b.strings.size() ? b.strings.c_str() + offset : nullptr; };
+
+    b.index = header.buildingIndex;
+    b.startRoom = header.startRoom;
+    b.minimapTexture = header.minimapTexture;
+    if (!str(header.name)) return false;
+    b.name = str(header.name);
+
+    for (std::uint32_t offset : textures)
+    {
+        if (!str(offset)) return false;
+        b.textures.push_back(str(offset));
+    }
+    for (std::uint32_t offset : enemies)
+    {
+        if (!str(offset) || !*str(offset)) return false;
+        b.enemies.push_back(str(offset));
+    }
+
+    b.arrows.reserve(arrows.size());
+    for (const ArrowRecord& r : arrows)
+    {
+        if (!str(r.text) || r.dir < NONE || r.dir > RIGHT || r.requiredKey >= ITEM_COUNT || r.target < 0) return false;
+        if (SCENE_BUILDING(r.target) == header.buildingIndex && SCENE_ROOM(r.target) >= header.sceneCount) return false; // rooms of other buildings are checked when they load
+        SceneArrow a;
+        a.clickArea = {r.area[0], r.area[1], r.area[2], r.area[3]};
+        a.dir = (ArrowDirection)r.dir;
+        a.targetSceneIndex = r.target;
+        a.isEnabled = r.enabled != 0;
+        a.hoverText = str(r.text);
+        a.requiredKey = (ItemID)r.requiredKey;
+        b.arrows.push_back(a);
+    }
+
+    b.items.reserve(items.size());
+    for (const ItemRecord& r : items)
+    {
+        if (!str(r.text) || r.item == 0 || r.item >= ITEM_COUNT || r.texture >= header.textureCount) return false;
+        b.items.push_back({(ItemID)r.item, str(r.text), {r.area[0], r.area[1], r.area[2], r.area[3]}, r.texture, r.afterVictory != 0});
+    }
+
+    b.scenes.reserve(scenes.size());
+    for (const SceneRecord& r : scenes)
+    {
+        if (!str(r.name) || !str(r.combatTexture) || !str(r.enemy) || !str(r.ending) || r.texture >= header.textureCount
+            || r.firstArrow + r.arrowCount > arrows.size() || r.firstItem + r.itemCount > items.size()) return false;
+        if (r.encounterID >= SAVE_MAX_ENCOUNTERS || (r.encounterID >= 0 && !*str(r.enemy))) return false; // a fight needs someone to fight, and a save has to hold its result
+        GameScene s{};
+        s.sceneName = str(r.name);
+        s.textureIndex = r.texture;
+        s.environmentTexture = str(r.combatTexture);
+        s.minimapCoords = {r.minimap[0], r.minimap[1]};
+        s.minimapRotation = r.minimap[2];
+        s.sceneArrows = {b.arrows.data() + r.firstArrow, r.arrowCount};
+        s.sceneItems = {b.items.data() + r.firstItem, r.itemCount};
+        s.hasEncounter = r.encounterID >= 0;
+        s.encounterID = r.encounterID;
+        s.enemyStatID = str(r.enemy);
+        s.combatBgOffset = {r.combat[0], r.combat[1]};
+        s.playerCharOffset = {r.combat[2], r.combat[3]};
+        s.enemyCharOffset = {r.combat[4], r.combat[5]};
+        s.playerScale = {r.combat[6], r.combat[7]};
+        s.enemyScale = {r.combat[8], r.combat[9]};
+        s.endingTexture = str(r.ending);
+        s.isEnding = s.endingTexture[0] != '\0';
+        b.scenes.push_back(s);
+    }
+
+    return true;
+}
+
+const Building* SceneLibrary::building(int index)
+{
+    if (index < 0 || index >= SCENE_MAX_BUILDINGS) return nullptr;
+    if ((std::size_t)index < buildings.size() && buildings[index]) return buildings[index].get();
+
+    std::unique_ptr<Building> loaded = load(index, false);
+    if (!loaded) return nullptr;
+    if (buildings.size() <= (std::size_t)index) buildings.resize(index + 1);
+    buildings[index] = std::move(loaded);
+    return buildings[index].get();
+}
+
+bool SceneLibrary::reload(int index, int keepRoom)
+{
+    if (index < 0 || index >= SCENE_MAX_BUILDINGS) return false;
+    if ((std::size_t)index >= buildings.size() || !buildings[index]) return true; // not loaded, the next access reads the new file anyway
+
+    std::unique_ptr<Building> fresh = load(index, true); // the JSON was edited, a blob written within the same clock tick would pass as fresh
+    if (!fresh) return false;
+    if (keepRoom >= (int)fresh->scenes.size())
+    {
+        lastError = sceneJsonPath(dir, index) + ": room " + std::to_string(keepRoom) + " is gone";
+        return false;
+    }
+    buildings[index] = std::move(fresh);
+    return true;
+}
+
+std::unique_ptr<Building> SceneLibrary::load(int index, bool compileJson)
+{
+    namespace fs = std::filesystem;
+    const std::string jsonPath = sceneJsonPath(dir, index);
+    const std::string blobPath = sceneBlobPath(dir, index);
+    std::error_code ec;
+    const bool haveJson = fs::exists(jsonPath, ec);
+    const bool haveBlob = fs::exists(blobPath, ec);
+
+    std::vector<char> blob;
+    bool stale = !haveBlob || (haveJson && (compileJson || fs::last_write_time(jsonPath, ec) > fs::last_write_time(blobPath, ec)));
+    if (!stale)
+    {
+        std::ifstream in(blobPath, std::ios::binary);
+        blob.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    auto loaded = std::make_unique<Building>();
+    if (stale || !loadSceneBlob(blob, index, *loaded))
+    {
+        // no (usable) blob: compile the JSON and keep the result for the next start
+        if (!haveJson)
+        {
+            lastError = "no " + jsonPath + " or usable " + blobPath;
+            return nullptr;
+        }
+        if (!compileSceneJson(jsonPath, index, blob, lastError)) return nullptr;
+        if (!loadSceneBlob(blob, index, *loaded))
+        {
+            lastError = jsonPath + ": compiled blob does not load";
+            return nullptr;
+        }
+        const std::string tmpPath = blobPath + ".tmp";
+        {
+            std::ofstream outFile(tmpPath, std::ios::binary | std::ios::trunc);
+            outFile.write(blob.data(), (std::streamsize)blob.size());
+        }
+        fs::rename(tmpPath, blobPath, ec);
+        if (ec) fs::remove(tmpPath, ec);
+    }
+
+    if (loadHook) loadHook(*loaded);
+    return loaded;
+}
+
+const GameScene* SceneLibrary::scene(int sceneId)
+{
+    if (sceneId < 0) return nullptr;
+    const Building* b = building(SCENE_BUILDING(sceneId));
+    if (!b || SCENE_ROOM(sceneId) >= (int)b->scenes.size()) return nullptr;
+    return &b->scenes[SCENE_ROOM(sceneId)];
+}
+
+std::size_t SceneLibrary::heapBytes() const
+{
+    std::size_t bytes = buildings.capacity() * sizeof(std::unique_ptr<Building>);
+    for (const auto& b : buildings)
+    {
+        if (!b) continue;
+        bytes += sizeof(Building) + b->name.capacity() + b->strings.capacity();
+        bytes += b->scenes.capacity() * sizeof(GameScene) + b->arrows.capacity() * sizeof(SceneArrow) + b->items.capacity() * sizeof(SceneItem);
+        bytes += (b->textures.capacity() + b->enemies.capacity()) * sizeof(const char*);
+    }
+    return bytes;
+}
@@ -0,0 +1,213 @@
+/*======================================= sceneGraph.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Scene Graph)
+  Primary Author: Edwin Baiden
+  Description: The rooms of every building come from data files instead of code. Each building
+               is authored as dat/scenes/building<N>.json (rooms, arrows, items, minimap spots,
+               combat placement) and compiled by GenSceneBlob (make) into building<N>.tlb, a
+               binary blob the game loads with one read. Arrows point at rooms by index, the
+               compiler resolves the room IDs used in the JSON.
+
+               SceneLibrary loads a building the first time the player walks into it and keeps
+               it, so starting the game only loads building 1 and going back to exploration after
+               a fight does not rebuild anything. A building's rooms, arrows and items each sit in
+               one contiguous array, a GameScene only holds index ranges into them.
+
+               Scene IDs are SCENE_ID(building, room), so building 1 (index 0) keeps the plain room
+               indexes old saves have. An arrow can lead into another building ("building2:lobby"
+               in the JSON), that building is only loaded once the player takes the arrow.
+
+               If the blob is missing or older than its JSON the game compiles the JSON itself
+               (and writes the blob back), so editing the JSON and restarting is enough.
+
+               Blob layout (little endian, packed):
+                    SceneBlobHeader | SceneRecord[sceneCount] | ArrowRecord[arrowCount]
+                    | ItemRecord[itemCount] | std::uint32_t textureOffsets[textureCount]
+                    | std::uint32_t enemyOffsets[enemyCount] | strings
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "raylib.h"       // Rectangle / Vector2 (types only, the build tool does not link raylib)
+#include "itemRegistry.h"
+
+//=============== HEADER GUARD ===============
+#ifndef SCENEGRAPH_H
+#define SCENEGRAPH_H
+
+#define SCENE_DIR "../dat/scenes"            // Building files, relative to the executable
+#define SCENE_BLOB_MAGIC "TLLB"              // First 4 bytes of a building blob
+#define SCENE_BLOB_VERSION 2                 // Bump when a record changes
+#define SCENE_MAX_PER_BUILDING 256           // Rooms per building (the low byte of a scene ID)
+#define SCENE_MAX_BUILDINGS 128              // Scene IDs have to fit the int16 the saves and snapshots keep them in
+#define SCENE_ID(building, room) (((building) << 8) | (room))
+#define SCENE_BUILDING(id) ((id) >> 8)
+#define SCENE_ROOM(id) ((id) & 0xFF)
+#define SCENE_START_ID SCENE_ID(0, 0)        // First room of building 1, where a new game starts
+
+//@author: Edwin Baiden
+//@brief: Simple enum for direction. mostly used for arrows in exploration
+//@version: 1.0
+enum ArrowDirection { NONE = -1, UP, DOWN, LEFT, RIGHT };
+
+// Items on in the area (Keys, Potions)
+//@author: Edwin Baiden
+//@brief: Struct defining an item that sits on the floor in exploration mode. basicly stuff u can pick up
+//@version: 1.0
+struct SceneItem {
+    ItemID item; // Which item this is (e.g. ItemID::Key1), also its bit in collectedItems
+    const char* hoverText; // Text to display on mouseover (tells player what it is)
+    Rectangle clickArea; // Click zone on screen (hitbox)
+    int textureIndex; // Index in the building's textures (same index in ScreenTextures while exploring)
+    bool requiresVictory; // True if item only appears after room battle is won (loot drop)
+};
+
+// Navigation points (Doors, Hallway Arrows)
+//@author: Edwin Baiden
+//@brief: Struct for navigation arrows. Tells the game where to go next.
+//@version: 1.0
+struct SceneArrow {
+    Rectangle clickArea; // clickable area on screen
+    ArrowDirection dir; // which way is it pointing
+    int targetSceneIndex; // scene ID this arrow takes u to (SCENE_ID, can be another building)
+    bool isEnabled; // is the arrow clickable?
+    const char* hoverText; // text when mouse hovers
+    ItemID requiredKey = ItemID::None; // If not None, the player has to have collected this key (locked doors)
+};
+
+//@author: Edwin Baiden
+//@brief: A run of arrows or items inside a building's array (range-for works on it like on the old vectors)
+//@version: 1.0
+template <typename T>
+struct SceneRange {
+    const T* first = nullptr;
+    std::size_t count = 0;
+
+    const T* begin() const { return first; }
+    const T* end() const { return first + count; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](std::size_t i) const { return first[i]; }
+};
+
+// The Room Container
+//@author: Edwin Baiden
+//@brief: All data for one room or "scene" of a building. basicly a container for all the stuff in a room
+//@version: 1.0
+struct GameScene
+{
+    const char* sceneName;               // Name displayed on minimap
+    int textureIndex;                    // Background texture index for the room
+    const char* environmentTexture;      // Environment texture file path (for combat background loading, "" if no fight)
+
+    Vector2 minimapCoords;  // 0.0-1.0 Position on map image (normalized coords)
+    float minimapRotation;  // Rotation of the turtle icon on minimap
+
+    SceneRange<SceneArrow> sceneArrows; // Nav arrows (in the building's arrow array)
+    SceneRange<SceneItem> sceneItems;   // Items in room (in the building's item array)
+
+    // Combat Trigger stuff
+    bool hasEncounter; // Does this room have a fight?
+    int encounterID;   // Which enemy is it?
+    const char* enemyStatID; // Starting stats row of the enemy (CSV ID, "" if no fight)
+
+    // Where to draw combat elements, relative to the combat background (took a while to calibrate these)
+    // background: screen center - half the texture + offset, characters: screen center + half the texture + offset
+    Vector2 combatBgOffset;
+    Vector2 playerCharOffset;
+    Vector2 enemyCharOffset;
+    Vector2 playerScale; // size of player in this room
+    Vector2 enemyScale;  // size of enemy in this room
+
+    // Last room of the game: the background changes to endingTexture after a few seconds ("" otherwise)
+    bool isEnding;
+    const char* endingTexture;
+};
+
+//@author: Edwin Baiden
+//@brief: One building, everything in contiguous arrays (rooms reference arrows/items by index range)
+//@version: 1.0
+struct Building
+{
+    std::string name;
+    int index = 0;                        // Building number - 1 (the high byte of its scene IDs)
+    int startRoom = 0;                    // Room a building starts in
+    int minimapTexture = 0;               // Index in textures
+    std::vector<GameScene> scenes;
+    std::vector<SceneArrow> arrows;
+    std::vector<SceneItem> items;
+    std::vector<const char*> textures;    // Every texture the building's exploration screen uses (paths)
+    std::vector<const char*> enemies;     // Stat IDs generated layouts can spawn (the "enemies" list, or the ones the rooms use)
+    std::string strings;                  // All names/paths, the const char* above point in here (never resized after loading)
+};
+
+//@brief: Parses a building JSON into a blob (scene IDs resolved, other buildings are read from the same directory)
+//@return - False with a message in error if the JSON is broken, points at a room that does not exist or has an
+//           encounter ID a save cant hold (SAVE_MAX_ENCOUNTERS)
+bool compileSceneJson(const std::string& jsonPath, int buildingIndex, std::vector<char>& blob, std::string& error);
+
+//@brief: Builds a Building from a blob (checks magic, version, sizes, ranges)
+//@param buildingIndex - Index the blob has to be compiled for (a building<N>.tlb renamed or copied to another N
+//                       would point its arrows at the wrong rooms), -1 takes whichever building it is
+//@return - False if the blob is not a valid building
+bool loadSceneBlob(const std::vector<char>& blob, int buildingIndex, Building& out);
+
+//@brief: building<N>.json / .tlb path of a building index in dir
+std::string sceneJsonPath(const std::string& dir, int buildingIndex);
+std::string sceneBlobPath(const std::string& dir, int buildingIndex);
+
+/**
+ * @author: Edwin Baiden
+ * @brief: Lazily loaded buildings, each read once and kept until clear()
+ * @version: 1.0
+ */
+class SceneLibrary
+{
+    public:
+        //@brief: Called on every building right after it loads, before anyone sees it (e.g. to apply a generated layout)
+        using LoadHook = void (*)(Building& building);
+
+        explicit SceneLibrary(std::string directory) : dir(std::move(directory)) {}
+
+        //@brief: Building by index, loaded on first use (blob, or the JSON if the blob is missing or stale)
+        //@return - nullptr if the building has no valid data
+        const Building* building(int index);
+
+        //@brief: Scene by scene ID (loads its building if needed), nullptr if there is no such room
+        const GameScene* scene(int sceneId);
+
+        //@brief: Reads an already loaded building again (its JSON was edited) and swaps it in if it loads. Pointers into the
+        //        old version dangle after a swap, so only call this where nobody holds one (hot reload, top of the frame)
+        //@param keepRoom - Room index that has to exist in the new version (the player is in it), -1 for none
+        //@return - False if the new version does not load (the old one stays, see error()). True for a building that is not
+        //          loaded yet, there is nothing to swap
+        bool reload(int index, int keepRoom = -1);
+
+        //@brief: Forgets every loaded building (the next access reads them again)
+        void clear() { buildings.clear(); }
+
+        //@brief: Hook for buildings loaded from now on (already loaded ones keep what they have until clear())
+        void setLoadHook(LoadHook hook) { loadHook = hook; }
+
+        //@brief: Why the last building() call returned nullptr
+        const std::string& error() const { return lastError; }
+
+        //@brief: Heap the loaded buildings hold (memory ledger gauge)
+        std::size_t heapBytes() const;
+
+    private:
+        std::unique_ptr<Building> load(int index, bool compileJson); // blob (unless compileJson and there is a JSON), or the JSON compiled
+                                                                     // and the blob written back, hook applied
+
+        std::string dir;
+        std::string lastError;
+        std::vector<std::unique_ptr<Building>> buildings; // by index, nullptr = not loaded yet
+        LoadHook loadHook = nullptr;
+};
+
+#endif // SCENEGRAPH_H
@@ -0,0 +1,119 @@
+/*====================================== sceneRoute.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Routing)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the building routing tables (see sceneRoute.h).
+*/
+#include "sceneRoute.h"
+
+#include <algorithm>
+
+void SceneRouter::build(const Building& building)
+{
+    graphOf = &building;
+    rooms = (int)building.scenes.size();
+    keys.clear();
+    edges.clear();
+    edgeStart.assign(rooms + 1, 0);
+    tables.clear();
+
+    for (int r = 0; r < rooms; ++r)
+    {
+        edgeStart[r] = (std::uint16_t)edges.size();
+        const SceneRange<SceneArrow>& arrows = building.scenes[r].sceneArrows;
+        for (std::size_t a = 0; a < arrows.size() && a < ROUTE_UNREACHABLE; ++a)
+        {
+            const SceneArrow& arrow = arrows[a];
+            if (!arrow.isEnabled || SCENE_BUILDING(arrow.targetSceneIndex) != building.index) continue;
+
+            Edge edge{(std::uint8_t)SCENE_ROOM(arrow.targetSceneIndex), (std::uint8_t)a, ROUTE_MAX_KEYS};
+            if (arrow.requiredKey != ItemID::None)
+            {
+                auto known = std::find(keys.begin(), keys.end(), arrow.requiredKey);
+                if (known == keys.end())
+                {
+                    if (keys.size() == ROUTE_MAX_KEYS) continue; // out of bits, treat the door as locked for good
+                    known = keys.insert(keys.end(), arrow.requiredKey);
+                }
+                edge.keyBit = (std::uint8_t)(known - keys.begin());
+            }
+            edges.push_back(edge);
+        }
+    }
+    edgeStart[rooms] = (std::uint16_t)edges.size();
+
+    activeMask = 0;
+    active = &tableFor(0);
+}
+
+const SceneRouter::Table& SceneRouter::tableFor(std::uint32_t mask)
+{
+    auto cached = tables.find(mask);
+    if (cached != tables.end()) return cached->second;
+
+    Table& table = tables[mask];
+    table.next.assign((std::size_t)rooms * rooms, ROUTE_UNREACHABLE);
+    table.dist.assign((std::size_t)rooms * rooms, ROUTE_UNREACHABLE);
+
+    // BFS from every room, the first hop is carried along so every room reached knows which arrow leads toward it
+    std::vector<int> queue(rooms);
+    for (int from = 0; from < rooms; ++from)
+    {
+        table.dist[at(from, from)] = 0;
+        int head = 0, tail = 0;
+        queue[tail++] = from;
+        while (head < tail)
+        {
+            const int room = queue[head++];
+            const std::uint8_t d = table.dist[at(from, room)];
+            if (d + 1 >= ROUTE_UNREACHABLE) continue;
+            for (int e = edgeStart[room]; e < edgeStart[room + 1]; ++e)
+            {
+                const Edge& edge = edges[e];
+                if (edge.keyBit != ROUTE_MAX_KEYS && !((mask >> edge.keyBit) & 1)) continue; // locked
+                if (edge.to >= rooms || table.dist[at(from, edge.to)] != ROUTE_UNREACHABLE) continue;
+                table.dist[at(from, edge.to)] = (std::uint8_t)(d + 1);
+                table.next[at(from, edge.to)] = room == from ? edge.arrow : table.next[at(from, room)];
+                queue[tail++] = edge.to;
+            }
+        }
+    }
+    return table;
+}
+
+void SceneRouter::setKeys(const ItemSet& collected)
+{
+    if (!graphOf) return;
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        if (collected.test((std::size_t)keys[i])) mask |= 1u << i;
+    if (active && mask == activeMask) return; // no new key for this building, same table
+    activeMask = mask;
+    active = &tableFor(mask);
+}
+
+int SceneRouter::distance(int fromRoom, int toRoom) const
+{
+    if (!active || !valid(fromRoom) || !valid(toRoom)) return ROUTE_UNREACHABLE;
+    return active->dist[at(fromRoom, toRoom)];
+}
+
+int SceneRouter::nextArrow(int fromRoom, int toRoom) const
+{
+    if (!active || !valid(fromRoom) || !valid(toRoom) || fromRoom == toRoom) return -1;
+    const std::uint8_t arrow = active->next[at(fromRoom, toRoom)];
+    return arrow == ROUTE_UNREACHABLE ? -1 : arrow;
+}
+
+bool SceneRouter::route(int fromRoom, int toRoom, std::vector<int>& out) const
+{
+    out.clear();
+    if (distance(fromRoom, toRoom) == ROUTE_UNREACHABLE) return false;
+    out.push_back(fromRoom);
+    for (int room = fromRoom; room != toRoom;)
+    {
+        room = SCENE_ROOM(graphOf->scenes[room].sceneArrows[nextArrow(room, toRoom)].targetSceneIndex);
+        out.push_back(room);
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+/*======================================= sceneRoute.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Routing)
+  Primary Author: Edwin Baiden
+  Description: Shortest paths between the rooms of a building, for the route the minimap draws
+               to the next objective and for fast travel.
+
+               The arrows of a building form a small directed graph, locked doors are edges that
+               need a key. Which doors are open only depends on which of the building's keys the
+               player has, so SceneRouter gives every key a bit and keeps one routing table per key
+               mask: a BFS from every room fills the next hop (which arrow to take) and the distance
+               for every pair of rooms. After that a route query is a table lookup, and walking a
+               route is one lookup per room.
+
+               Tables are built the first time their key mask is needed (the no-keys one when the
+               building is loaded) and kept. Picking up a key only switches to the mask with that
+               bit set, the tables of the other masks stay valid because the graph never changes.
+
+               Arrows into other buildings are not part of the graph, routes stay inside a building.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+//======================= PROJECT INCLUDES =======================
+#include "itemRegistry.h"
+#include "sceneGraph.h"
+
+//=============== HEADER GUARD ===============
+#ifndef SCENEROUTE_H
+#define SCENEROUTE_H
+
+#define ROUTE_UNREACHABLE 0xFF   // distance (and next hop) of rooms that cant be reached with the current keys
+#define ROUTE_MAX_KEYS 8         // keys per building the router tells apart (more locks than that stay locked)
+
+/**
+ * @author: Edwin Baiden
+ * @brief: All-pairs next hop tables of one building, one per key mask, built on demand and cached
+ * @version: 1.0
+ */
+class SceneRouter
+{
+    public:
+        //@brief: Reads the building's arrows into the room graph and builds the table for no keys
+        void build(const Building& building);
+
+        //@brief: Selects the table for the keys collected (builds it the first time that key mask comes up)
+        void setKeys(const ItemSet& collected);
+
+        const Building* building() const { return graphOf; }
+
+        //@brief: Rooms (building room indexes) between from and to, ROUTE_UNREACHABLE if the doors in between are locked
+        int distance(int fromRoom, int toRoom) const;
+
+        //@brief: Index into fromRoom's sceneArrows of the first arrow on the way to toRoom (-1 if there is no way or its the same room)
+        int nextArrow(int fromRoom, int toRoom) const;
+
+        //@brief: Every room of the shortest way from fromRoom to toRoom (both included) into rooms
+        //@return - False if toRoom cant be reached (rooms is empty then)
+        bool route(int fromRoom, int toRoom, std::vector<int>& rooms) const;
+
+        //@brief: Key masks that have a table so far (for the debug log)
+        std::size_t cachedTables() const { return tables.size(); }
+
+    private:
+        //@brief: One arrow between two rooms of the building
+        struct Edge
+        {
+            std::uint8_t to;
+            std::uint8_t arrow;     // index in the room's sceneArrows
+            std::uint8_t keyBit;    // ROUTE_MAX_KEYS = no key needed
+        };
+
+        //@brief: Next hop (arrow index) and distance for every (from, to) pair, row major
+        struct Table
+        {
+            std::vector<std::uint8_t> next;
+            std::vector<std::uint8_t> dist;
+        };
+
+        const Table& tableFor(std::uint32_t mask);
+        std::size_t at(int fromRoom, int toRoom) const { return (std::size_t)fromRoom * rooms + toRoom; }
+        bool valid(int room) const { return room >= 0 && room < rooms; }
+
+        const Building* graphOf = nullptr;
+        int rooms = 0;
+        std::vector<ItemID> keys;                 // bit i of a key mask = keys[i] collected
+        std::vector<std::uint16_t> edgeStart;     // edges of room r are [edgeStart[r], edgeStart[r + 1])
+        std::vector<Edge> edges;
+        std::map<std::uint32_t, Table> tables;    // by key mask
+        const Table* active = nullptr;
+        std::uint32_t activeMask = 0;
+};
+
+#endif // SCENEROUTE_H
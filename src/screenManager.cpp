@@ -42,12 +42,18 @@
 
                     - void ScreenManager::changeScreen(ScreenState newScreen): Request a screen change to a new screen state.
 
+                    - void ScreenManager::requestScreen(ScreenState newScreen): Same behind a fade, the new screen's textures
+                      are prepared in the background while the old one fades out (updateTransition does the swap).
+
                     - ScreenState ScreenManager::getCurrentScreen() const: Get the current screen state.
 
                     - void ScreenManager::update(float dt): Update the current screen with delta time.
 
                     - void ScreenManager::render(): Render the current screen.
 
+                    - int ScreenManager::runAllocationCheck(int frames): Scripted run of one room and one player turn
+                      that fails if a steady frame allocates ("make alloc-check").
+
                     - void ScreenManager::enterScreen(ScreenState screen): Handle entering a new screen by loading
                       resources and setting styles.
 
@@ -63,6 +69,8 @@
                     - void GameManager::changeGameState(GameState newState): Request a change 
                       to a new game state (handles the transition logic).
 
+                    - void GameManager::requestGameState(GameState newState): Same behind a fade (into a fight and back out).
+
                     - GameState GameManager::getCurrentGameState() const: Get the current game state.
 
                     - void GameManager::enterGameState(GameState state): Handle entering a new game
@@ -78,8 +86,10 @@
                       (handles inputs and game logic).
 
                 Global/Helper Functions:
-                    - Cleanup Functions: A set of functions (CleanupScreenTextures, CleanupEntities, etc.)
-                      to safely delete and set pointers to nullptr to avoid memory leaks.
+                    - Resource Functions: UseScreenTextures/UseScreenRects set up the textures and rects a
+                      screen or game state declares (textures are loaded as a delta, see resources.h),
+                      UseMemoryOwner says who the memory ledger charges, UseBackgroundMusic swaps the music,
+                      ReleaseScreenResources/CleanupEntities let go of everything at the end.
 
                     - Init Functions: Functions to intialize game scenes (InitGameScenes) and 
                       load sounds (InitGameSounds).
@@ -88,12 +98,32 @@
                       depending on the current screen context.
 
                     - Other Helpers: Functions for loading intro text and drawing status panels.
+
+                    - Hot Reload: ApplyDataReloads picks up stats/intro text edited in dat/ and buildings edited in
+                      dat/scenes/ while the game runs (both are watched by a FileWatcher thread, changes are applied
+                      at the top of update()).
+
+                    - Saving: "Save & Exit" packs a SaveData snapshot and hands it to the SaveService, which
+                      writes it on a worker thread (savedSucessfully is set from its callback in update()).
+                      AutosaveProgress runs on every room change, item pickup and combat end and only
+                      appends the changes to the autosave journal. Saves go to the active save slot (saveSlots.h):
+                      START picks the first free slot (or the one saved longest ago), RELOAD SAVED GAME opens
+                      the load menu, which draws every slot from the slot index only (LoadSaveSlot reads the
+                      chosen slot). FillSlotInfo/CaptureSaveThumbnail keep the slot's info and thumbnail current,
+                      MigrateLegacySave moves the save from before slots into slot 1.
+
+                    - Frame Allocations: text a frame draws goes into the frame arena (frameMemory.h), and
+                      WatchFrameAllocations checks that steady exploration/combat frames allocate nothing
+                      (counted in TRACK_ALLOCS builds, shown under the memory overlay).
 ============================================================================================= */
 
 
 #define RAYGUI_IMPLEMENTATION
 #include "screenManager.h"
+#include "gameRules.h"
 #include "progressLog.h"
+#include "saveService.h"
+#include "frameMemory.h"
 
 
 //======================= GLOBAL STATIC VARIABLES =======================
@@ -101,17 +131,17 @@
     Global static variables to hold shared resources and game states.
     These persist through out the entireity of the game.
 
-    - allStatLines: Holds all the lines of stats for characters from the CSV file  (this is then used to display stats and 
-                                                                                    create new characters as the game goes on)
+    - startingStats: Holds the starting stats of every character, compiled into the game from the CSV file at build time
+                     (this is then used to display stats and create new characters as the game goes on)
     
     - gameSounds: Holds all the sounds that will be used while the program is opened (on event that something happens 
                                                                                       the appropriate sound will be played)
 
-    - ScreenTextures: Holds textures for different screens (these are dynamically allocated and deallocated
-                                                            when entering and exiting screens)
+    - ScreenTextures: Holds textures for different screens (every screen/game state declares the ones it needs when
+                                                            it is entered, only the difference gets loaded/unloaded)
 
-    - ScreenRects: Holds rectangles for different screens (these are dynamically allocated and deallocated
-                                                            when entering and exiting screens)
+    - ScreenRects: Holds rectangles for different screens (fixed storage, each screen/game state fills the ones it uses
+                                                            when it is entered)
 
     - characterCards (Character Selection Only but needs to be available to render() and update() and stuff in that state):
     Holds  character chard data such as current position, target position, default row, and texture (needed for animation)
@@ -122,554 +152,654 @@
     - scrollIntroCrawl(Intro Crawl screen only but needs to be available to render() and update()): 
     Holds the intro crawl text that will be scrolled up the screen in the intro crawl screen
 
-    - entities: Holds the player and enemy entities for combat (these are dynamically allocated and deallocated
-                                                            when entering and exiting screens; Player is at index 0, enemy is at index 1)
+    - entityPool: Owns every character of the current session (spawned/despawned in its slots, no new/delete per fight)
+
+    - entities: The player and enemy that are fighting, pointers into entityPool (Player is at index 0, enemy is at index 1)
     
     - gameManager: Holds the game manager instance to manage game states and transitions
 
     - nerdFont: Holds the nerd font used for rendering text in the game
 
-    NOTE: All pointers are initialized to nullptr and dynamically allocated when needed.
-          They are cleaned up in the Cleanup functions. This is to avoid memory leaks and 
-          ensure proper resource management(vectors would have been better but raw pointers were a req).
+    - transition: Holds the screen/game state change in progress (fade, target), see TRANSITION FUNCTIONS
+
+    - backgroundMusic: Holds the music stream that is playing (a handle too, so the memory ledger sees it)
+    - memoryOverlay: Holds whether the memory counters (memoryLedger.h) are drawn over the game
 
-    - numScreenTextures: Holds the number of textures in ScreenTextures array
-    - numScreenRects: Holds the number of rectangles in ScreenRects array
+    NOTE: Textures, sounds and the font are RAII handles (resources.h), they unload themselves when replaced.
+          ReleaseScreenResources lets go of all of them at shutdown (raylib needs the window for that).
+
+    - numScreenRects: Holds the number of rectangles the current screen uses in ScreenRects
     - introCrawlYPos: Holds the current Y position of the intro crawl text for scrolling effect
-    - gameScenes: Holds all the game scenes with their respective textures, arrows, items, and encounters (using a nodal mapping structure; not sure if this is the best way to do it)
+    - sceneLibrary: Holds the buildings (rooms with their arrows, items and encounters), each loaded from dat/scenes the first time the player enters it
+                    (with the fights and items moved to where SCENE_LAYOUT_SEED puts them, see ApplySceneLayout)
+    - currentBuilding: Holds the building whose textures are loaded in exploration
+    - buildingReloads: Buildings whose JSON was edited and that wait for a frame where they can be swapped (hot reload)
+    - sceneRouter / visitedRooms / objectiveRoute: Routing tables of currentBuilding, the rooms fast travel can go to and the minimap route
     - activeEncounterID: Holds the ID of the currently active encounter
-    - currentSceneIndex: Holds the index of the currently active scene in gameScenes
+    - currentSceneIndex: Holds the scene ID (sceneGraph.h SCENE_ID) of the currently active scene
     - savedPlayerSceneIndex: Holds the index of the player's last saved scene
     - battleWon: Holds a map of encounter IDs to whether the player has won that encounter
-    - collectedItems: Holds a vector of item names that the player has collected
+    - collectedItems: One bit per ItemID the player has collected (keys included)
     - byteSize: Holds the byte size of the icons that are used through out the game
     - loadedFromSave: Holds whether the game was loaded from a save file
-    - savedSucessfully: Holds whether the game was saved successfully
+    - savedSucessfully: Holds whether the last save made it to disk (set by the save service callback, a frame or two after "Save & Exit")
+    - saveListing: Holds the save slot index the main menu shows (read from slots.idx, never from the saves themselves)
+    - loadMenuOpen: Holds whether the main menu shows the slot list instead of its buttons
+    - overwriteSlot: Holds the used slot a new game would go over while the main menu asks about it (-1 = not asking)
+    - currentSlotInfo: Holds what the load menu will show for the slot being played (refreshed on every save)
+    - thumbnailTarget / thumbnailStale: Small render texture the slot thumbnail is downscaled into, and whether the room changed since the last one
+    - playtimeSeconds: Holds how long the slot has been played (pause menu not counted)
+    - worldHistory: Holds the last WORLD_HISTORY_CAPACITY world snapshots (one per room and per player turn) for rewinding
+    - quickSave / hasQuickSave: Holds the in-memory quicksave (F5) and whether there is one to quickload (F9)
+    - lastFrame / lastStateStamp / steadyFrames / steadyAllocFrames: What the last frame allocated, what the game looked like, how many
+                    steady frames there were and how many of them allocated anyway (allocation tracking builds, see frameMemory.h)
+    - scriptedRun: Holds whether runAllocationCheck is driving the game (nothing gets saved)
 
 */ 
 
 // ok so these are all the global variables that we need to keep track of stuff
 // i know globals are bad but we need them here for the way the code is structured
-static std::istringstream *allStatLines = nullptr; // Used throughout game - holds all the character stats from CSV
-static Sound *gameSounds = nullptr; // Used throughout game - all our sound effects go here
-static Texture2D *ScreenTextures = nullptr; // Used throughout game - images for whatver screen were on
-static Rectangle *ScreenRects = nullptr; // Used throughout game - clickable areas basically
-static charCard *characterCards = nullptr; // Used in Character Select state only - the lil cards u click on
-static int *CharSelectionStuff = nullptr; // Used in Character Select state only (holds selected character[0], hovered character[1], and initialized state[2])
-static std::stringstream *scrollIntroCrawl = nullptr; // Used in Intro Crawl state only - the star wars text thing
-static Character **entities = nullptr; // Used in Combat state only (Player at index 0, Enemy at index 1) - basically whos fighting
+static StatTable startingStats; // Used throughout game - holds all the character stats (built in, or the override CSV)
+static FileWatcher datWatcher; // Used throughout game - tells us when files in dat/ were edited (hot reload)
+static SaveService saveService; // Used throughout game - writes saves on a background thread
+static int introCrawlCharacter = -1; // Character the intro crawl was built for (so it can be rebuilt on hot reload)
+static std::array<SoundHandle, TOTAL_SOUNDS> gameSounds; // Used throughout game - all our sound effects go here
+static TextureSet ScreenTextures; // Used throughout game - images for whatver screen were on
+static Rectangle ScreenRects[MAX_SCREEN_RECTS] = {}; // Used throughout game - clickable areas basically
+static std::array<charCard, MAX_CHAR_CARDS> characterCards{}; // Used in Character Select state only - the lil cards u click on
+static int CharSelectionStuff[3] = {-1, -1, 0}; // Used in Character Select state only (holds selected character[0], hovered character[1], and initialized state[2])
+static std::unique_ptr<std::stringstream> scrollIntroCrawl; // Used in Intro Crawl state only - the star wars text thing
+static EntityPool entityPool; // Used throughout game - owns the characters of this session
+static Character *entities[2] = {nullptr, nullptr}; // Player at index 0, Enemy at index 1 (both live in entityPool) - basically whos fighting
 static GameManager *gameManager = nullptr; // Used throughout GAMEPLAY state - the big boss that controls everything
-static Font *nerdFont = nullptr; // Used throughout game - fancy font with icons and stuff
+static FontHandle nerdFont; // Used throughout game - fancy font with icons and stuff
+static ScreenTransition transition; // Used throughout game - the fade between screens/game states (and what comes after it)
 
 
-static int numScreenTextures = 0; // how many textures we got loaded rn
 static int numScreenRects = 0; // how many rectangles we got
 static float introCrawlYPos = 0.0f; // where the scrolly text is at
 static int byteSize=0; // needed for the icon rendering stuff
-static Music backgroundMusic = {0};
-static bool musicLoaded = false;
+static MusicHandle backgroundMusic; // whatever music is playing (menu/exploration or combat)
+static bool memoryOverlay = false; // memory counters drawn over the game (KEY_MEMORY_OVERLAY)
 static float endScreenTimer = 0.0f;
 static int endScreenPhase = 0;
 
 //Game scenes and related data (Please review above comment block)
 // these are for keeping track of where the player is and what theyve done
-static std::vector<GameScene> gameScenes; // all the rooms/locations in the game
+static SceneLibrary sceneLibrary(SCENE_DIR); // all the rooms/locations in the game, one building at a time
+static const Building* currentBuilding = nullptr; // building the exploration textures belong to
+static std::bitset<SCENE_MAX_BUILDINGS> buildingReloads; // edited buildings waiting to be swapped in (hot reload)
+static SceneRouter sceneRouter; // next hop tables of currentBuilding (minimap route, fast travel)
+static std::map<int, std::bitset<SCENE_MAX_PER_BUILDING>> visitedRooms; // rooms the player has been in, per building
+static std::vector<int> objectiveRoute; // rooms from the current one to the next objective (drawn on the minimap)
+static int objectiveArrow = -1; // arrow of the current room that is the first step of objectiveRoute
 static std::map<int,bool> battleWon; // which fights have been won (so zombies dont respawn)
-static std::vector<std::string> collectedItems; // stuff the player picked up
+static ItemSet collectedItems; // stuff the player picked up (one bit per ItemID)
 static bool loadedFromSave = false, savedSucessfully = false; // save/load flags
 static int activeEncounterID = -1; // which fight is happening rn (-1 means no fight)
-static int currentSceneIndex = TEX_ENTRANCE; // where the player is standing
-static int savedPlayerSceneIndex = TEX_ENTRANCE; // where they were when they saved
+static int currentSceneIndex = SCENE_START_ID; // where the player is standing
+static int savedPlayerSceneIndex = SCENE_START_ID; // where they were when they saved
+
+// Save slots (the load menu only ever reads the slot index)
+static SaveIndex saveListing; // what the load menu shows for every slot
+static bool loadMenuOpen = false; // main menu is showing the slot list
+static int overwriteSlot = -1; // every slot is used, asking before a new game goes over this one
+static SlotInfo currentSlotInfo{}; // load menu info of the slot being played
+static RenderTexture2D thumbnailTarget = {0}; // SAVE_THUMB_WIDTH x SAVE_THUMB_HEIGHT, the slot thumbnail is drawn in here
+static bool thumbnailStale = false; // room changed, grab a new thumbnail after the next frame
+static float playtimeSeconds = 0.0f; // time played on this slot
+
+// World snapshots (in memory only, a few hundred bytes each)
+static WorldHistory worldHistory; // rewind history: rooms in exploration, player turns in the current fight
+static WorldState quickSave{}; // F5 snapshot
+static bool hasQuickSave = false;
+
+// Frame allocations (only counted in TRACK_ALLOCS builds, frameMemory.h)
+static FrameReport lastFrame; // allocations of the last frame and whether it was steady (memory overlay)
+static std::uint64_t lastStateStamp = 0; // GameManager::stateStamp of the last frame
+static int steadyFrames = 0; // steady exploration/combat frames so far
+static int steadyAllocFrames = 0; // steady exploration/combat frames that allocated anyway
+static bool scriptedRun = false; // the allocation check is playing, autosaves are skipped (the slots are the player's)
+
+
+//======================= LAYOUT TABLES =======================
+/*
+    The rects of the screens that always look the same, resolved while compiling (uiLayout.h) and
+    copied into ScreenRects when the state is entered. Character select places its rects every frame
+    (they follow the cards) and the combat popups are placed when they open, so those are not in here.
+*/
 
-//======================= RESOURCE CLEANUP FUNCTIONS =======================
+// Start, load and exit under the middle of the screen, the load menu rows and their back button
+static constexpr LayoutItem MENU_LAYOUT_ITEMS[] = {
+    {0, Anchor::Top, 0, SCREEN_CENTER_Y + MAIN_BUTTON_OFFSET_Y, MAIN_BUTTON_WIDTH, MAIN_BUTTON_HEIGHT, LAYOUT_SCREEN, 3, MAIN_BUTTON_SPACING},
+    {R_MENU_SLOT_FIRST, Anchor::Top, 0, SLOT_ROW_Y, SLOT_ROW_WIDTH, SLOT_ROW_HEIGHT, LAYOUT_SCREEN, SAVE_SLOT_COUNT, SLOT_ROW_HEIGHT + SLOT_ROW_SPACING},
+    {R_MENU_SLOT_BACK, Anchor::Top, 0, SLOT_ROW_Y + SAVE_SLOT_COUNT * (SLOT_ROW_HEIGHT + SLOT_ROW_SPACING), MAIN_BUTTON_WIDTH, MAIN_BUTTON_HEIGHT},
+    {R_MENU_OVERWRITE, Anchor::Center, 0, 0, OVERWRITE_BOX_WIDTH, OVERWRITE_BOX_HEIGHT},
+};
+static constexpr std::array<Rectangle, MENU_RECT_COUNT> MENU_LAYOUT = resolveLayout<MENU_RECT_COUNT>(MENU_LAYOUT_ITEMS, GAME_SCREEN_WIDTH, GAME_SCREEN_HEIGHT);
+
+// Pause menu (exploration and combat share the indexes), the buttons hang off the top of the panel
+#define PAUSE_LAYOUT_ITEMS \
+    {R_PAUSE_BG_OVERLAY, Anchor::TopLeft, 0, 0, (float)GAME_SCREEN_WIDTH, (float)GAME_SCREEN_HEIGHT}, \
+    {R_PAUSE_PANEL, Anchor::Center, 0, 0, PAUSE_PANEL_WIDTH, PAUSE_PANEL_HEIGHT}, \
+    {R_BTN_RESUME, Anchor::Top, 0, 60.0f, PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT, R_PAUSE_PANEL, 3, PAUSE_BTN_HEIGHT + PAUSE_BTN_SPACING}
+
+// Exploration only has the pause button (top right) and the pause menu
+static constexpr LayoutItem EXPLORATION_LAYOUT_ITEMS[] = {
+    {R_EXP_PAUSE_BTN, Anchor::TopRight, 10, 50, 75, 75},
+    PAUSE_LAYOUT_ITEMS,
+};
+static constexpr std::array<Rectangle, MAX_SCREEN_RECTS> EXPLORATION_LAYOUT = resolveLayout<MAX_SCREEN_RECTS>(EXPLORATION_LAYOUT_ITEMS, GAME_SCREEN_WIDTH, GAME_SCREEN_HEIGHT);
+
+// Combat: player on the left, enemy mirrored on the right, action bar along the bottom (popups start empty)
+static constexpr LayoutItem COMBAT_LAYOUT_ITEMS[] = {
+    {R_PLAYER_NAME, Anchor::TopLeft, 0, 0, 450, 50},        // name bars
+    {R_ENEMY_NAME, Anchor::TopRight, 0, 0, 450, 50},
+    {R_PLAYER_PANEL, Anchor::TopLeft, 0, 50, 450, 832},     // big info panels
+    {R_ENEMY_PANEL, Anchor::TopRight, 0, 50, 450, 832},
+    {R_PLAYER_HP_BG, Anchor::TopLeft, 20, 150, 410, 30},    // health bars (foreground shrinks when hurt)
+    {R_PLAYER_HP_FG, Anchor::TopLeft, 20, 150, 410, 30},
+    {R_ENEMY_HP_BG, Anchor::TopRight, 20, 150, 410, 30},
+    {R_ENEMY_HP_FG, Anchor::TopRight, 20, 150, 410, 30},
+    {R_PLAYER_STATUS, Anchor::TopLeft, 20, 250, 410, 500},  // status effects
+    {R_ENEMY_STATUS, Anchor::TopRight, 20, 250, 410, 500},
+    {R_BOTTOM_PANEL, Anchor::BottomLeft, 0, -15, (float)GAME_SCREEN_WIDTH, 215}, // hangs 15 past the bottom edge
+    {R_BTN_ATTACK, Anchor::BottomLeft, 20, 100, 400, 80},
+    {R_BTN_DEFEND, Anchor::BottomLeft, 20, 0, 400, 80},
+    {R_BTN_USE_ITEM, Anchor::BottomLeft, 570, 100, 400, 80},
+    {R_LOG_BOX, Anchor::BottomRight, 20, 5, 780, 175},
+    {R_PAUSE_BTN, Anchor::TopRight, 460, 12.5f, 75, 75},   // left of the enemy name bar, centered on its bottom edge
+    PAUSE_LAYOUT_ITEMS,
+};
+static constexpr std::array<Rectangle, MAX_SCREEN_RECTS> COMBAT_LAYOUT = resolveLayout<MAX_SCREEN_RECTS>(COMBAT_LAYOUT_ITEMS, GAME_SCREEN_WIDTH, GAME_SCREEN_HEIGHT);
+#undef PAUSE_LAYOUT_ITEMS
+
+// The pause menu is still drawn the way the PAUSE_* macros describe it
+static_assert(sameRect(COMBAT_LAYOUT[R_PAUSE_PANEL], Rectangle{PAUSE_PANEL_X, PAUSE_PANEL_Y, PAUSE_PANEL_WIDTH, PAUSE_PANEL_HEIGHT}), "pause panel moved");
+static_assert(sameRect(EXPLORATION_LAYOUT[R_EXP_BTN_QUIT_NO_SAVE], Rectangle{PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f + 2 * (PAUSE_BTN_HEIGHT + PAUSE_BTN_SPACING), PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT}), "pause buttons moved");
+static_assert(sameRect(COMBAT_LAYOUT[R_BOTTOM_PANEL], Rectangle{0, (float)GAME_SCREEN_HEIGHT - 200, (float)GAME_SCREEN_WIDTH, 215}), "bottom panel moved");
+
+
+//======================= RESOURCE FUNCTIONS =======================
 /*
-    These are a set of functions that delete/deallocate any and all dynamic resources being used in the game.
-    Basically we gotta clean up after ourselves or else memory leaks happen and thats bad.
-    Each function handles one type of resource so its easier to manage.
+    Every screen and game state says what it needs when it is entered: the textures (UseScreenTextures)
+    and its rects (UseScreenLayout copies a layout table, UseScreenRects leaves them for the state to place). Nothing gets cleaned up on the way out anymore,
+    the next state's list decides what stays. Textures both states use stay loaded, the rects are one
+    fixed array that just gets overwritten.
     
-    The pattern is always: check if pointer exists, clean it up, delete it, set to nullptr
-    Setting to nullptr is important cause otherwise you get dangeling pointers and crashes
-    i learned this the hard way
+    The handles unload themselves, ReleaseScreenResources is only for shutdown cause raylib cant
+    unload anything once the window is gone.
 */
 
 /**
- * @brief Safely cleans up all screen textures. This function checks if ScreenTextures is not null, then iterates through each texture, unloading them before deleting the array and setting the pointer to nullptr. Gotta unload textures or else your GPU will fill up with unused data.
+ * @brief Makes the textures a screen or game state needs resident, in the order it indexes them. Textures already loaded by
+ *        the state before are kept (moved to their new index), only the new ones get loaded and the unused ones unloaded.
+ * @param who Name of the state for the debug log.
+ * @param sources The textures (file paths, or images with a unique key) in ScreenTextures order.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupScreenTextures() 
+void UseScreenTextures(const char* who, const std::vector<TextureSet::Source>& sources)
 {
-    if (ScreenTextures) { // only do stuff if theres actually something to clean
-        for (int i = 0; i < numScreenTextures; ++i) {
-            UnloadTexture(ScreenTextures[i]); // tell raylib to remove the texture from memory
-        }
-        delete[] ScreenTextures; // Delete the array of textures itself
-        ScreenTextures = nullptr; // Set pointer to nullptr so we dont accidentally use it again
-    }
-    numScreenTextures = 0; //Reset the count of screen textures back to zero
+    const TextureSet::Delta delta = ScreenTextures.declare(sources);
+    TraceLog(LOG_DEBUG, "%s textures: %d loaded, %d prefetched, %d kept, %d unloaded", who, delta.loaded, delta.prefetched, delta.kept, delta.unloaded);
 }
 
 /**
- * @brief Safely cleans up all screen rectangles. This function checks if ScreenRects is not null, then deletes the array and sets the pointer to nullptr. Rectangles dont need special unloading like textures do cause theyre just numbers basically.
+ * @brief Starts a new rect layout: the first count rects are zeroed for the state to fill in (no allocation, ScreenRects is fixed).
+ * @param count How many rects the state uses (at most MAX_SCREEN_RECTS).
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupScreenRects() 
+void UseScreenRects(int count)
 {
-    if (ScreenRects) { // same pattern as before
-        delete[] ScreenRects; // Delete the array of rectangles
-        ScreenRects = nullptr; // set to nullptr
-    }
-    numScreenRects = 0; // Reset the count so we know its empty
+    numScreenRects = std::min(count, MAX_SCREEN_RECTS);
+    std::fill(ScreenRects, ScreenRects + MAX_SCREEN_RECTS, Rectangle{0, 0, 0, 0});
 }
 
 /**
- * @brief Safely cleans up character cards. This function checks if characterCards is not null, then deletes the array and sets the pointer to nullptr. These are the lil character selection cards that slide around and look cool.
+ * @brief Copies a layout table into ScreenRects (the rects of a state that always looks the same).
+ * @param layout The state's resolved layout (LAYOUT TABLES).
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupCharacterCards() 
+template <std::size_t N>
+void UseScreenLayout(const std::array<Rectangle, N>& layout)
 {
-    if (characterCards) {
-        delete[] characterCards; // delete character cards
-        characterCards = nullptr; // Set pointer to nullptr so we dont get problems with old data
-    }
+    static_assert(N <= MAX_SCREEN_RECTS, "layout has more rects than ScreenRects");
+    UseScreenRects((int)N);
+    std::copy(layout.begin(), layout.end(), ScreenRects);
 }
 
 /**
- * @brief Safely cleans up character selection stuff. This function checks if CharSelectionStuff is not null, then deletes the array and sets the pointer to nullptr. This is just an int array so nothing fancy needed.
+ * @brief Unloads every texture, sound and the font (called before the window closes). The handles would do it on their own
+ *        when the program ends, but by then raylib has no window to unload them from.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupCharSelectionStuff() 
+void ReleaseScreenResources()
 {
-    if (CharSelectionStuff) {
-        delete[] CharSelectionStuff; // delete the selection data
-        CharSelectionStuff = nullptr; // nullptr it
-    }
+    ScreenTextures.release();
+    for (SoundHandle& sound : gameSounds) sound.reset();
+    nerdFont.reset();
+    backgroundMusic.reset();
+    scrollIntroCrawl.reset();
 }
 
 /**
- * @brief Safely cleans up stat lines. This function checks if allStatLines is not null, then clears the stringstream, deletes it, and sets the pointer to nullptr. Stringstreams are weird so we gotta clear them first before deleting.
+ * @brief Makes a screen or game state the owner of what gets loaded from now on (memory ledger). The music that is playing
+ *        belongs to whoever plays it, so it goes along.
+ * @param owner The screen or game state being entered.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupStatLines() 
+void UseMemoryOwner(MemOwner owner)
 {
-    if (allStatLines) {
-        allStatLines->clear(); // Clear the stringstream flags (you gotta do this with stringstreams)
-        allStatLines->str(""); // Clear the stringstream content (make it empty)
-        delete allStatLines; // now we can safely delete it
-        allStatLines = nullptr; // and nullptr it
-    }
+    memSetOwner(owner);
+    backgroundMusic.retag(owner);
 }
 
 /**
- * @brief Safely cleans up the intro crawl text. This function checks if scrollIntroCrawl is not null, then clears the stringstream, deletes it, and sets the pointer to nullptr. Same deal as the stat lines cleanup.
+ * @brief Swaps the background music for another looping track and starts it (the old stream is unloaded).
+ * @param path Music file.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupIntroCrawl() 
+void UseBackgroundMusic(const char* path)
 {
-    if (scrollIntroCrawl) {
-        scrollIntroCrawl->clear(); // clear flags first
-        scrollIntroCrawl->str(""); // then clear the actual text
-        delete scrollIntroCrawl; // Delete it
-        scrollIntroCrawl = nullptr; // and nullptr
-    }
+    Music music = LoadMusicStream(path);
+    music.looping = true;
+    backgroundMusic.reset(music);
+    PlayMusicStream(*backgroundMusic);
 }
 
 /**
- * @brief Safely cleans up nerd font. This function checks if nerdFont is not null, then unloads the font, deletes the pointer, and sets it to nullptr. Fonts need to be unloaded just like textures or raylib gets confused.
+ * @brief Ends the entity session. Every character goes back to the entity pool (destroyed in place, the pool keeps
+ *        its memory for the next session) and both combat slots are nulled so nothing points at them anymore.
  * @return void
- * @version 1.0
+ * @version 1.1
  * @author Edwin Baiden
  */
-void CleanupNerdFont() 
+void CleanupEntities() 
 {
-    if (nerdFont) {
-        UnloadFont(*nerdFont); // tell raylib to unload the font from memory
-        delete nerdFont; // Delete the pointer
-        nerdFont = nullptr; // Set to nullptr cause were responsible programmers
-    }
+    entityPool.clear();
+    entities[0] = nullptr;
+    entities[1] = nullptr;
+}
+
+//======================= GAMESCENE FUNCTION DEFINITIONS =======================
+/*
+    These functions are used to initialize and manage game scenes. Game scenes are basically
+    all the diffrent rooms and locations in the game that the player can walk around in.
+    Each scene has its own background image, navigation arrows, items to pick up, and maybe
+    an enemy encounter. Its like a point-and-click adventure game sorta.
+    
+    The rooms come from the building data files (dat/scenes/building<N>.json, compiled to .tlb
+    blobs, see sceneGraph.h). sceneLibrary loads a building the first time its needed and keeps
+    it, we just swap currentSceneIndex when the player clicks arrows. Only the textures get
+    loaded again when exploration starts (combat unloads them).
+*/
+
+/**
+ * @brief Checks if an item has been collected (one bit test on collectedItems). This is used to determine if an item should be displayed in the scene or not cause we dont want items to respawn after you already grabbed them.
+ * @param item The item to check for collection status (like ItemID::Key1 or ItemID::HealthPotion).
+ * @return true if the item has been collected already, false if its still there to grab.
+ * @version 1.1
+ * @author Edwin Baiden
+ */
+bool isItemCollected(ItemID item) {
+    return collectedItems.test((std::size_t)item);
+}
+
+/**
+ * @brief Checks if a navigation arrow can be used: it has to be enabled and, for locked doors, the player needs its key.
+ * @param arrow The arrow to check.
+ * @return true if the arrow should be drawn and clickable.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool isArrowOpen(const SceneArrow& arrow) {
+    return arrow.isEnabled && (arrow.requiredKey == ItemID::None || isItemCollected(arrow.requiredKey));
+}
+
+/**
+ * @brief Checks if a fight has been won. A lookup only, battleWon[id] would add the fight to the map (and allocate) when its not in there yet.
+ * @param encounterID The encounter to check.
+ * @return true if the player won that fight.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool isBattleWon(int encounterID) {
+    auto battle = battleWon.find(encounterID);
+    return battle != battleWon.end() && battle->second;
+}
+
+/**
+ * @brief Checks if an item of a room is lying there: not picked up yet, and if it drops from the room's fight that fight is won.
+ * @param scene The room the item is in.
+ * @param item The item to check.
+ * @return true if the item should be drawn and clickable.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool isItemVisible(const GameScene& scene, const SceneItem& item) {
+    return !isItemCollected(item.item) && (!item.requiresVictory || (scene.hasEncounter && isBattleWon(scene.encounterID)));
+}
+
+/**
+ * @brief Looks up the scene the player is standing in.
+ * @return The current scene, nullptr if its building has no valid data file.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+const GameScene* CurrentScene() {
+    return sceneLibrary.scene(currentSceneIndex);
+}
+
+/**
+ * @brief Name of a scene for the load menu (loads its building if it has not been loaded yet).
+ * @param sceneId Scene ID (SCENE_ID) to name.
+ * @return The scene name, "Unknown" if there is no such scene.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+const char* SceneName(int sceneId) {
+    ChangeDirectory(GetApplicationDirectory()); // the building files are relative to the executable
+    const GameScene* scene = sceneLibrary.scene(sceneId);
+    return scene ? scene->sceneName : "Unknown";
 }
 
 /**
- * @brief Safely cleans up game sounds. This function checks if gameSounds is not null, then iterates through each sound, unloading them before deleting the array and setting the pointer to nullptr. Sound effects gotta be unloaded too or youll have audio memory leaks which is apperently a thing.
+ * @brief Load hook of sceneLibrary: moves a building's fights and items to the layout SCENE_LAYOUT_SEED generates (sceneGen.h).
+ *        Seed 0 keeps the authored layout. Threats come from the built in stat rows, not the override CSV, so a layout
+ *        never depends on balancing files and saves always find their fights where they left them. A seed that does not
+ *        pass checkLayout here (the JSON changed since ValidateSeeds passed it) keeps the authored layout as well.
+ * @param building The building that was just loaded.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupGameSounds() 
-{
-    if (gameSounds) {
-        for (int i = 0; i < TOTAL_SOUNDS; ++i) {
-            UnloadSound(gameSounds[i]); // unload each sound one by one
-        }
-        delete[] gameSounds; // Delete the array of sounds
-        gameSounds = nullptr; // nullptr it
+void ApplySceneLayout(Building& building) {
+    if (SCENE_LAYOUT_SEED == 0) return;
+    std::string error;
+    if (!applyLayoutSeed(building, GENERATED_STAT_ROWS, STATS_ROW_COUNT, SCENE_LAYOUT_SEED, error)) {
+        TraceLog(LOG_WARNING, "Layout: %s, keeping the authored one", error.c_str());
+        return;
     }
+    TraceLog(LOG_INFO, "Layout: %s uses seed %u", building.name.c_str(), SCENE_LAYOUT_SEED);
 }
 
 /**
- * @brief Safely cleans up entities array. This function checks if entities is not null, then deletes each entity and sets pointers to nullptr before deleting the array and setting the pointer to nullptr. This ones more complicated cause we got pointers inside pointers.
+ * @brief Log sink of the engine core (platform.h): its lines go through TraceLog like the rest of the game's.
+ * @param level PLATFORM_LOG_* level (same values as raylib's).
+ * @param text The formatted line.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupEntities() 
-{
-    if (entities) 
-    {
-        //If player character exists in array delete them first
-        if (entities[0]) 
-        {
-            delete entities[0]; // delete player
-            entities[0] = nullptr; // nullptr the player slot
-        }
+void ForwardCoreLog(int level, const char* text) {
+    TraceLog(level, "%s", text);
+}
 
-        //If enemy character exists in array delete them too
-        if (entities[1]) 
-        {
-            delete entities[1]; // delete enemy
-            entities[1] = nullptr; // nullptr the enemy slot
+/**
+ * @brief Picks the room the minimap points the player to: the closest room (with the keys the player has) that still has something
+ *        to do in it, an item to pick up or a fight to win. Once everything is done its the way out (the ending room).
+ * @return Room index in currentBuilding, -1 if there is nothing left to reach.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+int FindObjective() {
+    const int here = SCENE_ROOM(currentSceneIndex);
+    int best = -1, bestDistance = ROUTE_UNREACHABLE, ending = -1;
+    for (int room = 0; room < (int)currentBuilding->scenes.size(); ++room) {
+        const int distance = sceneRouter.distance(here, room);
+        if (distance == ROUTE_UNREACHABLE) continue;
+        const GameScene& scene = currentBuilding->scenes[room];
+        if (scene.isEnding && ending < 0) ending = room;
+
+        const bool won = scene.hasEncounter && isBattleWon(scene.encounterID);
+        bool todo = scene.hasEncounter && !won;
+        for (const auto &item : scene.sceneItems)
+            todo |= !isItemCollected(item.item) && (!item.requiresVictory || won);
+        if (todo && distance < bestDistance) {
+            best = room;
+            bestDistance = distance;
         }
-        delete[] entities; // now delete the array itself
-        entities = nullptr; // and nullptr the whole thing
     }
+    return best >= 0 ? best : ending;
 }
 
 /**
- * @brief Safely cleans up all screen resources including textures, rects, character cards, selection state, and stat lines. This is like a convienience function that calls all the other cleanup functions so you dont have to remeber all of them.
+ * @brief Brings the routing up to date after the room or the collected items changed: marks the room as visited, switches the
+ *        router to the keys the player has now (only a new key builds a new table) and finds the route to the next objective.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
-void CleanupAllScreenResources() 
-{
-    // just call all the cleanup functions in order
-    // this is easier than remembering to call each one seperately
-    CleanupScreenTextures();
-    CleanupScreenRects();
-    CleanupCharacterCards();
-    CleanupCharSelectionStuff();
-    CleanupStatLines();
+void RefreshRoute() {
+    objectiveRoute.clear();
+    objectiveArrow = -1;
+    if (!currentBuilding || SCENE_BUILDING(currentSceneIndex) != currentBuilding->index) return;
+
+    const int here = SCENE_ROOM(currentSceneIndex);
+    visitedRooms[currentBuilding->index].set(here);
+    sceneRouter.setKeys(collectedItems);
+    const int objective = FindObjective();
+    if (objective >= 0 && sceneRouter.route(here, objective, objectiveRoute))
+        objectiveArrow = sceneRouter.nextArrow(here, objective);
 }
 
+/**
+ * @brief Checks if fast travel can go to a room of the current building: the player has been there and the doors on the way
+ *        are open with the keys they have. Two table lookups, no search.
+ * @param room Room index in currentBuilding.
+ * @return true if fast travel can go there.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool CanFastTravel(int room) {
+    if (!currentBuilding || room < 0 || room >= (int)currentBuilding->scenes.size() || room == SCENE_ROOM(currentSceneIndex)) return false;
+    return visitedRooms[currentBuilding->index].test(room) && sceneRouter.distance(SCENE_ROOM(currentSceneIndex), room) != ROUTE_UNREACHABLE;
+}
 
-//======================= GAMESCENE FUNCTION DEFINITIONS =======================
-/*
-    These functions are used to initialize and manage game scenes. Game scenes are basically
-    all the diffrent rooms and locations in the game that the player can walk around in.
-    Each scene has its own background image, navigation arrows, items to pick up, and maybe
-    an enemy encounter. Its like a point-and-click adventure game sorta.
-    
-    The way it works is we have a big vector of GameScene structs and each one has all the
-    info about that location. Then we just swap between them when the player clicks arrows.
-*/
+/**
+ * @brief Finds the fast travel target under a point of the minimap.
+ * @param point Position in game coordinates.
+ * @return Room index in currentBuilding, -1 if there is no room fast travel can go to under the point.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+int FastTravelRoomAt(Vector2 point) {
+    if (!currentBuilding) return -1;
+    for (int room = 0; room < (int)currentBuilding->scenes.size(); ++room)
+        if (CanFastTravel(room) && CheckCollisionPointCircle(point, MINIMAP_ROOM_POS(currentBuilding->scenes[room]), MINIMAP_ROOM_RADIUS))
+            return room;
+    return -1;
+}
 
 /**
- * @brief Checks if an item has been collected by comparing the item name with the collected items list. This is used to determine if an item should be displayed in the scene or not cause we dont want items to respawn after you already grabbed them.
- * @param itemName The name of the item to check for collection status (like "Key 1" or "Health Potion").
- * @return true if the item has been collected already, false if its still there to grab.
+ * @brief The textures exploration uses in a building, in the order the scenes index them (TEX_ARROW and TEX_TURTLE last).
+ * @param building The building the player is in.
+ * @return std::vector<TextureSet::Source> The texture list (also what a transition into exploration prefetches).
  * @version 1.0
  * @author Edwin Baiden
  */
-bool isItemCollected(const std::string& itemName) {
-    // loop through all collected items and see if this one is in there
-    for (const auto& item : collectedItems) // Iterate through collected items
-        if (item == itemName) return true; // found it! player already has this
-    return false; // not found so its still available to pick up
+std::vector<TextureSet::Source> ExplorationTextureSources(const Building& building)
+{
+    // one texture per path the building uses (room backgrounds, items, the minimap), then the shared UI ones
+    std::vector<TextureSet::Source> textures(building.textures.begin(), building.textures.end());
+    textures.push_back({"../assets/images/UI/explorationArrow.png"}); // TEX_ARROW, the clickable arrows
+    textures.push_back({"../assets/images/UI/turtleIcon.png"}); // TEX_TURTLE, player icon on minimap
+    return textures;
 }
 
 /**
- * @brief Initializes all game scenes with their respective textures, arrows (and where they lead to), items, and encounters. This function sets up the entire game world structure for exploration mode. Its a big function cause theres alot of scenes to set up. Currently only supports Student character type but we can add more later.
+ * @brief Loads the textures of the building the player is in (its rooms, items and minimap, then the arrow and turtle UI textures after them).
+ *        The building itself comes from sceneLibrary, so it is only read from disk the first time the player enters it.
+ *        Currently only supports Student character type but we can add more later.
  * @param playerCharacter Pointer to the player character (used for scene initialization per character type [has not been fully implemented due to time constraints]).
  * @return void
- * @version 1.0
+ * @version 2.0
  * @author Edwin Baiden
  */
 void InitGameScenes(Character* playerCharacter) 
 {
-    
-    // Clear existing scenes if any (start fresh)
-    gameScenes.clear();
-    
-    //Using dynamic_cast to check if the player character is of type Student
-    // if its a student we load the student version of the game world
+    currentBuilding = nullptr;
+
+    // Check the player's archetype, if its a student we load the student version of the game world
     // other character types would have diffrent layouts but we didnt have time for that
-    if (dynamic_cast<Student*>(playerCharacter)) 
+    if (playerCharacter && playerCharacter->archetype == Archetype::Student) 
     {
-        // Initialize scenes for Student character
-        // this is gonna be a long one
+        ChangeDirectory(GetApplicationDirectory()); // Change to application directory so that relative paths works (cause MacOS is picky about file paths)
 
-        // Load screen textures for all the exploration environments
-        // theres alot of them cause every room needs a background
-        numScreenTextures = TOTAL_EXP_TEX;
-        ScreenTextures = new Texture2D[numScreenTextures];
+        const Building* building = sceneLibrary.building(SCENE_BUILDING(currentSceneIndex));
+        if (!building || !sceneLibrary.scene(currentSceneIndex)) {
+            TraceLog(LOG_ERROR, "No scene %d: %s", currentSceneIndex, sceneLibrary.error().c_str());
+            return;
+        }
 
-        ChangeDirectory(GetApplicationDirectory()); // Change to application directory so that relative paths works (cause MacOS is picky about file paths)
-        
-        // Load all the environment textures for different locations in the building
-        // these are all the hallway and room backgrounds
-        ScreenTextures[TEX_ENTRANCE] = LoadTexture("../assets/images/environments/Building1/Hallway/Entrance.png");
-        ScreenTextures[TEX_EXIT] = LoadTexture("../assets/images/environments/Building1/Hallway/Hallway[2-4].png");
-        ScreenTextures[TEX_FRONT_OFFICE] = LoadTexture("../assets/images/environments/Building1/Hallway/Hallway[2-2].png");
-        ScreenTextures[TEX_WEST_HALLWAY_TOWARD] = LoadTexture("../assets/images/environments/Building1/Hallway/Hallway[2-1].png");
-        ScreenTextures[TEX_WEST_HALLWAY_AWAY] = LoadTexture("../assets/images/environments/Building1/Hallway/Hallway[1-2].png");
-        ScreenTextures[TEX_EAST_HALLWAY_TOWARD] = LoadTexture("../assets/images/environments/Building1/Hallway/Hallway[2-3].png");
-        ScreenTextures[TEX_EAST_HALLWAY_AWAY] = LoadTexture("../assets/images/environments/Building1/Hallway/Hallway[3-1].png");
-        ScreenTextures[TEX_CLASSROOM_1] = LoadTexture("../assets/images/environments/Building1/Class-Office/Classroom1.png");
-        ScreenTextures[TEX_CLASSROOM_2] = LoadTexture("../assets/images/environments/Building1/Class-Office/Classroom2.png");
-        ScreenTextures[TEX_CLASSROOM_3] = LoadTexture("../assets/images/environments/Building1/Class-Office/ClassroomZombies.png"); // spooky classroom with zombies
-        ScreenTextures[TEX_IN_OFFICE] = LoadTexture("../assets/images/environments/Building1/Class-Office/Office.png");
-        ScreenTextures[TEX_BATH_MEN] = LoadTexture("../assets/images/environments/Building1/Bathrooms/BathroomM.png"); // mens room
-        ScreenTextures[TEX_BATH_WOM] = LoadTexture("../assets/images/environments/Building1/Bathrooms/BathroomG.png"); // womens room
-        ScreenTextures[TEX_OUTSIDE] = LoadTexture("../assets/images/environments/Building1/finalScene[1].png"); // outside area
-        
-        // Load item textures that can be picked up in the game
-        // keys, potions, weapons, the usual RPG stuff
-        ScreenTextures[TEX_KEY_1] = LoadTexture("../assets/images/items/Key1.png"); // first key
-        ScreenTextures[TEX_KEY_2] = LoadTexture("../assets/images/items/Key2.png"); // second key
-        ScreenTextures[TEX_HEALTH_POTION] = LoadTexture("../assets/images/items/HealthPotion.png"); // heals you
-        ScreenTextures[TEX_BAT] = LoadTexture("../assets/images/items/BaseballBat.png"); // weapon
-        
-        // Load UI elements for navigation and minimap
-        ScreenTextures[TEX_ARROW] = LoadTexture("../assets/images/UI/explorationArrow.png"); // the clickable arrows
-        ScreenTextures[TEX_MINIMAP] = LoadTexture("../assets/images/environments/Building1/NewLayout.png"); // birds eye view of building
-        ScreenTextures[TEX_TURTLE] = LoadTexture("../assets/images/UI/turtleIcon.png"); // player icon on minimap
-
-        // Initialize game scenes array to hold all the different locations
-        // resize it to fit all our scenes
-        gameScenes.resize(TEX_OUTSIDE + 1);
-
-        // ==================== ENTRANCE SCENE ====================
-        // This is where the player starts when they begin the game
-        // its the front entrance of the building
-        GameScene* s = &gameScenes[TEX_ENTRANCE]; // get pointer to this scene for easier access
-        s->sceneName = "Entrance"; // what shows up on the minimap
-        s->textureIndex = TEX_ENTRANCE; // which background to use
-        s->minimapCoords = {0.475f, 0.8f}; // where the turtle goes on the minimap (normalized 0-1 coords)
-        s->minimapRotation = 0.0f; // which way the turtle faces
-        s->sceneArrows = {
-            // these are all the clickable arrows in this scene
-            // format: {{x, y, width, height}, direction, where it goes, is it usable, hover text, required key}
-            {{550, 500, 150, 150}, LEFT, TEX_WEST_HALLWAY_AWAY, true, "Go West", ""}, // go left
-            {{1220, 500, 150, 150}, RIGHT, TEX_EAST_HALLWAY_TOWARD, true, "Go East", ""}, // go right
-            {{885, 650, 150, 150}, UP, TEX_FRONT_OFFICE, true, "Go to Office Front", ""}, // go forward
-            {{885, 875, 150, 150}, DOWN, TEX_EXIT, true, "Exit Building", "Key 2"} // exit but needs key 2 first
-        };
+        // back from a fight or the same building again, only what the fight replaced gets loaded
+        // (nothing at all if a transition prefetched it)
+        UseScreenTextures("Exploration", ExplorationTextureSources(*building));
+        currentBuilding = building;
+        if (sceneRouter.building() != building) sceneRouter.build(*building); // new building, new room graph
+        RefreshRoute();
 
-        // ==================== EXIT SCENE ====================
-        // This is outside the building - the final area basically
-        // theres a frat bro zombie here
-        s = &gameScenes[TEX_EXIT];
-        s->sceneName = "Exit";
-        s->textureIndex = TEX_EXIT;
-        s->environmentTexture = "../assets/images/environments/Building1/Hallway/Hallway[2-4].png"; // used as combat background when fighting here
-        s->minimapCoords = {0.5f, 0.825f};
-        s->minimapRotation = 180.0f; // facing the other way
-        s->sceneArrows = {{{885, 875, 150, 150}, DOWN, TEX_ENTRANCE, true, "Enter Building", ""},
-                          {{885, 650, 150, 150}, UP, TEX_OUTSIDE, true, "Exit Building", ""}}; // can go back inside
-        s->hasEncounter = true; // theres a fight here
-        s->encounterID = 2; // its encounter number 2 (the frat bro)
-        // Combat positioning values - where to draw stuff during the fight
-        // these took a while to get right, lots of trial and error
-        s->combatBgX = (SCREEN_CENTER_X - (ScreenTextures[TEX_EXIT].width) / 2.0f);
-        s->combatBgY = (SCREEN_CENTER_Y - (ScreenTextures[TEX_EXIT].height) / 2.0f- 175.0f);
-        s->playerCharX = (SCREEN_CENTER_X + (ScreenTextures[TEX_EXIT].width) / 2.0f - 450.0f);
-        s->playerCharY = (SCREEN_CENTER_Y + (ScreenTextures[TEX_EXIT].height) / 2.0f - 700.0f);
-        s->enemyCharX = (SCREEN_CENTER_X + (ScreenTextures[TEX_EXIT].width) / 2.0f - 675.0f);
-        s->enemyCharY = (SCREEN_CENTER_Y + (ScreenTextures[TEX_EXIT].height) / 2.0f - 750.0f);
-        s->playerScale = {600.0f,650.0f}; // how big to draw the player
-        s->enemyScale = {400.0f,500.0f}; // how big to draw the enemy
-
-        // ==================== FRONT OFFICE SCENE ====================
-        // this is the hallway in front of the main office
-        // connects to a bunch of other areas so its like a hub
-        s = &gameScenes[TEX_FRONT_OFFICE];
-        s->sceneName = "Office Front";
-        s->textureIndex = TEX_FRONT_OFFICE;
-        s->minimapCoords = {0.45f, 0.475f};
-        s->minimapRotation = 0.0f;
-        s->sceneArrows = {
-            {{550, 725, 150, 150}, LEFT, TEX_WEST_HALLWAY_TOWARD, true, "Go West", ""}, // west hallway
-            {{1250, 725, 150, 150}, RIGHT, TEX_EAST_HALLWAY_TOWARD, true, "Go East", ""}, // east hallway
-            {{885, 875, 150, 150}, DOWN, TEX_EXIT, true, "Exit Building", "Key 2"}, // exit (need key)
-            {{885, 650, 150, 150}, UP, TEX_IN_OFFICE, true, "Enter Office", ""} // go into the office
-        };
+        // the last room swaps to its second ending picture, start from the first one again
+        endScreenPhase = 0;
+        endScreenTimer = 0.0f;
+    }
+    // if we had time we would add more character types here with different maps
+}
 
-        // ==================== WEST HALLWAY (TOWARD) SCENE ====================
-        // west hallway looking toward the end (toward the classrooms)
-        // the naming is confusing i know but "toward" means facing that direction
-        s = &gameScenes[TEX_WEST_HALLWAY_TOWARD];
-        s->sceneName = "West Hallway";
-        s->textureIndex = TEX_WEST_HALLWAY_TOWARD;
-        s->minimapCoords = {0.25f, 0.475f};
-        s->minimapRotation = 270.0f; // facing west
-        s->sceneArrows = {
-            {{500, 535, 150, 150}, LEFT, TEX_CLASSROOM_1, true, "Enter Classroom 1", ""}, // classroom 1 (has professor zombie)
-            {{1250, 535, 150, 150}, RIGHT, TEX_CLASSROOM_2, true, "Enter Classroom 2", "Key 1"}, // classroom 2 (locked, need key 1)
-            {{875, 750, 150, 150}, DOWN, TEX_WEST_HALLWAY_AWAY, true, "Return East", ""} // turn around
-        };
+//======================= TRANSITION FUNCTIONS =======================
+/*
+    requestScreen/requestGameState dont change anything right away. They work out the texture list
+    the next state is going to declare, hand it to ScreenTextures.prefetch (the files are decoded on
+    worker threads) and start fading out. While the screen goes dark nothing takes input and
+    updateTransition uploads at most TRANSITION_UPLOADS_PER_FRAME of the decoded images a frame.
+    Once its black and everything is on the GPU the old state is exited and the new one entered
+    (its declare() finds all its textures already there), then it fades back in.
+
+    The lists here are the same ones the states declare when they are entered, so they cant drift.
+*/
 
-        // ==================== WEST HALLWAY (AWAY) SCENE ====================
-        // west hallway but looking the other way (back toward center)
-        // "away" means facing away from that direction
-        s = &gameScenes[TEX_WEST_HALLWAY_AWAY];
-        s->sceneName = "West Hallway";
-        s->textureIndex = TEX_WEST_HALLWAY_AWAY;
-        s->minimapCoords = {0.2f, 0.475f};
-        s->minimapRotation = 90.0f; // facing east now
-        s->sceneArrows = {
-            {{855, 850, 150, 150}, DOWN, TEX_WEST_HALLWAY_TOWARD, true, "Return West", ""}, // turn back around
-            {{855, 550, 150, 150}, UP, TEX_EAST_HALLWAY_TOWARD, true, "Go East", ""}, // shortcut to east
-            {{500, 500, 150, 150}, LEFT, TEX_FRONT_OFFICE, true, "Go to Office Entrance", ""}, // back to hub
-            {{1250, 500, 150, 150}, RIGHT, TEX_EXIT, true, "Exit Building", "Key 2"} // exit shortcut
-        };
+/**
+ * @brief The file textures of the main menu (background and title, the slot thumbnails come from the slot index when it is entered).
+ * @return std::vector<TextureSet::Source> The texture list.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::vector<TextureSet::Source> MenuTextureSources()
+{
+    return {{"../assets/images/UI/startMenuBg.png"}, {"../assets/images/UI/gameTitle.png"}}; // cool background, game logo
+}
 
-        // ==================== EAST HALLWAY (TOWARD) SCENE ====================
-        // east hallway facing toward the end (bathrooms and classroom 3)
-        s = &gameScenes[TEX_EAST_HALLWAY_TOWARD];
-        s->sceneName = "East Hallway";
-        s->textureIndex = TEX_EAST_HALLWAY_TOWARD;
-        s->minimapCoords = {0.675f, 0.475f};
-        s->minimapRotation = 90.0f;
-        s->sceneArrows = {
-            {{885, 600, 150, 150}, UP, TEX_CLASSROOM_3, true, "Enter Classroom 3", ""}, // spooky zombie classroom
-            {{500, 600, 150, 150}, LEFT, TEX_BATH_MEN, true, "Enter Men's Bathroom", ""}, // mens room
-            {{1350, 600, 150, 150}, RIGHT, TEX_BATH_WOM, true, "Enter Women's Bathroom", ""}, // womens room
-            {{885, 850, 150, 150}, DOWN, TEX_EAST_HALLWAY_AWAY, true, "Go West", ""} // turn around
-        };
+/**
+ * @brief The textures of character select (the menu background, then the 4 character portraits from the archetype table).
+ * @return std::vector<TextureSet::Source> The texture list.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::vector<TextureSet::Source> CharacterSelectTextureSources()
+{
+    std::vector<TextureSet::Source> textures = {{"../assets/images/UI/startMenuBg.png"}}; // same background as menu
+    // portraits come from the archetype table (student, rat, professor, attila - only student is playable rn)
+    for (int i = 0; i < 4; ++i)
+        textures.push_back({ARCHETYPES[i].selectSprite});
+    return textures;
+}
 
-        // ==================== EAST HALLWAY (AWAY) SCENE ====================
-        // east hallway looking back toward the center
-        s = &gameScenes[TEX_EAST_HALLWAY_AWAY];
-        s->sceneName = "East Hallway";
-        s->textureIndex = TEX_EAST_HALLWAY_AWAY;
-        s->minimapCoords = {0.7f, 0.5f};
-        s->minimapRotation = 270.0f;
-        s->sceneArrows = {
-            {{855, 850, 150, 150}, DOWN, TEX_EAST_HALLWAY_TOWARD, true, "Return East", ""},
-            {{855, 550, 150, 150}, UP, TEX_WEST_HALLWAY_TOWARD, true, "Go West", ""},
-            {{1250, 500, 150, 150}, RIGHT, TEX_FRONT_OFFICE, true, "Go to Office Entrance", ""},
-            {{550, 500, 150, 150}, LEFT, TEX_EXIT, true, "Go to Exit", "Key 2"}
-        };
+/**
+ * @brief The textures of the fight in the current room (room background, player fighting pose, the enemy of activeEncounterID).
+ * @return std::vector<TextureSet::Source> The texture list, empty if there is no room or player.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::vector<TextureSet::Source> CombatTextureSources()
+{
+    const GameScene* scene = CurrentScene();
+    if (!scene || !entities[0]) return {};
+    std::vector<TextureSet::Source> textures = {{scene->environmentTexture}, // room background
+                                                {archetypeInfo(entities[0]->archetype).combatSprite}}; // player fighting pose
 
-        // ==================== CLASSROOM 1 SCENE ====================
-        // first classroom - has a professor zombie fight and key 2 after you win
-        // gotta beat the prof to get the key to escape
-        s = &gameScenes[TEX_CLASSROOM_1];
-        s->sceneName = "Classroom 1";
-        s->textureIndex = TEX_CLASSROOM_1;
-        s->environmentTexture = "../assets/images/environments/Building1/Class-Office/Classroom1.png";
-        s->minimapCoords = {0.19f, 0.625f};
-        s->minimapRotation = 180.0f;
-        s->sceneArrows = {{{885, 855, 150, 150}, DOWN, TEX_WEST_HALLWAY_TOWARD, true, "Exit Classroom", ""}}; // only way out
-        // the key only shows up AFTER you beat the zombie (requiresVictory = true)
-        // so you cant just grab it and run
-        s->sceneItems = {{"Key 2", "Pick up Key 2", {600, 625, 150, 150}, TEX_KEY_2, true}};
-        s->hasEncounter = true; // fight time
-        s->encounterID = 0; // Professor zombie encounter (hes encounter 0)
-        // all the combat positioning stuff again
-        s->combatBgX = (SCREEN_CENTER_X - (ScreenTextures[TEX_CLASSROOM_1].width) / 2.0f);
-        s->combatBgY = (SCREEN_CENTER_Y - (ScreenTextures[TEX_CLASSROOM_1].height) / 2.0f- 175.0f);
-        s->playerCharX = (SCREEN_CENTER_X + (ScreenTextures[TEX_CLASSROOM_1].width) / 2.0f - 500.0f);
-        s->playerCharY = (SCREEN_CENTER_Y + (ScreenTextures[TEX_CLASSROOM_1].height) / 2.0f - 790.0f);
-        s->enemyCharX = (SCREEN_CENTER_X + (ScreenTextures[TEX_CLASSROOM_1].width) / 2.0f - 670.0f);
-        s->enemyCharY = (SCREEN_CENTER_Y + (ScreenTextures[TEX_CLASSROOM_1].height) / 2.0f - 795.0f);
-        s->playerScale = {600.0f,700.0f};
-        s->enemyScale = {400.0f,400.0f};
-
-
-        // ==================== CLASSROOM 2 SCENE ====================
-        // second classroom - no fight here just a free health potion
-        // but you need key 1 to get in (which is in the office)
-        s = &gameScenes[TEX_CLASSROOM_2];
-        s->sceneName = "Classroom 2";
-        s->textureIndex = TEX_CLASSROOM_2;
-        s->minimapCoords = {0.15f, 0.325f};
-        s->minimapRotation = 0.0f;
-        s->sceneArrows = {{{885, 855, 150, 150}, DOWN, TEX_WEST_HALLWAY_TOWARD, true, "Exit Classroom", ""}};
-        // health potion is always available (requiresVictory = false) cause no fight here
-        s->sceneItems = {{"Health Potion", "Pick up Health Potion", {500, 480, 150, 150}, TEX_HEALTH_POTION, false}};
-
-        // ==================== CLASSROOM 3 SCENE ====================
-        // third classroom - just has spooky zombie decorations
-        // no items or fights, its just for atmosphere
-        s = &gameScenes[TEX_CLASSROOM_3];
-        s->sceneName = "Classroom 3";
-        s->textureIndex = TEX_CLASSROOM_3;
-        s->minimapCoords = {0.15f, 0.65f};
-        s->minimapRotation = 90.0f;
-        s->sceneArrows = {{{885, 855, 150, 150}, DOWN, TEX_EAST_HALLWAY_TOWARD, true, "Exit Classroom", ""}};
-        // nothing here, we could add stuff later if we want
-
-        // ==================== OFFICE SCENE ====================
-        // the main office - has a sorority zombie fight
-        // also has key 1 and a baseball bat (weapon upgrade)
-        // this is probably the most important room besides the exit
-        s = &gameScenes[TEX_IN_OFFICE];
-        s->sceneName = "Office";
-        s->textureIndex = TEX_IN_OFFICE;
-        s->environmentTexture = "../assets/images/environments/Building1/Class-Office/Office.png";
-        s->minimapCoords = {0.45f, 0.35f};
-        s->minimapRotation = 0.0f;
-        s->sceneArrows = {{{885, 855, 150, 150}, DOWN, TEX_FRONT_OFFICE, true, "Exit Office", ""}};
-        // TWO items here, key 1 and baseball bat, both always available
-        s->sceneItems = {
-            {"Key 1", "Pick up Key 1", {600, 400, 90, 90}, TEX_KEY_1, false}, // smaller hitbox for key
-            {"Baseball Bat", "Pick up Baseball Bat", {800, 500, 300, 150}, TEX_BAT, false} // bigger hitbox for bat
-        };
-        s->hasEncounter = true;
-        s->encounterID = 1; // Sorority zombie is encounter 1
-        // more positioning numbers
-        s->combatBgX = (SCREEN_CENTER_X - (ScreenTextures[TEX_IN_OFFICE].width) / 2.0f);
-        s->combatBgY = (SCREEN_CENTER_Y - (ScreenTextures[TEX_IN_OFFICE].height) / 2.0f- 150.0f);
-        s->playerCharX = (SCREEN_CENTER_X + (ScreenTextures[TEX_IN_OFFICE].width) / 2.0f - 500.0f);
-        s->playerCharY = (SCREEN_CENTER_Y + (ScreenTextures[TEX_IN_OFFICE].height) / 2.0f - 1075.0f);
-        s->enemyCharX = (SCREEN_CENTER_X + (ScreenTextures[TEX_IN_OFFICE].width) / 2.0f - 700.0f);
-        s->enemyCharY = (SCREEN_CENTER_Y + (ScreenTextures[TEX_IN_OFFICE].height) / 2.0f - 1295.0f);
-        s->playerScale = {700.0f,700.0f};
-        s->enemyScale = {300.0f,500.0f};
-
-        // ==================== MEN'S BATHROOM SCENE ====================
-        // mens bathroom - nothing here, just exists for realism
-        // maybe we could add a secret item here later
-        s = &gameScenes[TEX_BATH_MEN];
-        s->sceneName = "Men's Bathroom";
-        s->textureIndex = TEX_BATH_MEN;
-        s->minimapCoords = {0.85f, 0.325f};
-        s->minimapRotation = 0.0f;
-        s->sceneArrows = {{{885, 855, 150, 150}, DOWN, TEX_EAST_HALLWAY_TOWARD, true, "Exit Bathroom", ""}};
-
-        // ==================== WOMEN'S BATHROOM SCENE ====================
-        // womens bathroom - also nothing here
-        s = &gameScenes[TEX_BATH_WOM];
-        s->sceneName = "Women's Bathroom";
-        s->textureIndex = TEX_BATH_WOM;
-        s->environmentTexture = "../assets/images/environments/Building1/Class-Office/BathroomG.png";
-        s->minimapCoords = {0.8f, 0.6f};
-        s->minimapRotation = 180.0f;
-        s->sceneArrows = {{{885, 855, 150, 150}, DOWN, TEX_EAST_HALLWAY_TOWARD, true, "Exit Bathroom", ""}};
-
-        // ==================== OUTSIDE SCENE ====================
-        // outside area - final scene after you exit the building
-        s = &gameScenes[TEX_OUTSIDE];
-        s->sceneName = "Outside";
-        s->textureIndex = TEX_OUTSIDE;
-        s->minimapCoords = {0.5f, 0.9f};
-        s->minimapRotation = 180.0f;
-        
-        
+    // The right enemy texture based on which encounter this is
+    switch (activeEncounterID) 
+    {
+        case 0:
+            textures.push_back({"../assets/images/characters/npc/Enemies/Professor1.png"}); // zombie professor
+            break;
+        case 1:
+            textures.push_back({"../assets/images/characters/npc/Enemies/Sorority1.png"}); // zombie sorority girl
+            break;
+        case 2:
+        default:
+            textures.push_back({"../assets/images/characters/npc/Enemies/FratBro1.png"}); // zombie frat bro
+            break;
     }
-    // if we had time we would add more character types here with different maps
+    return textures;
+}
+
+/**
+ * @brief What entering a game state is going to declare (the pause menu keeps what it paused).
+ * @param state The game state about to be entered.
+ * @return std::vector<TextureSet::Source> The texture list, empty if there is nothing to prepare.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::vector<TextureSet::Source> GameStateTextureSources(GameState state)
+{
+    if (state == GameState::COMBAT) return CombatTextureSources();
+    if (state != GameState::EXPLORATION || !entities[0]) return {};
+    ChangeDirectory(GetApplicationDirectory());
+    const Building* building = sceneLibrary.building(SCENE_BUILDING(currentSceneIndex)); // blob read on this thread, its tiny
+    return building ? ExplorationTextureSources(*building) : std::vector<TextureSet::Source>{};
+}
+
+/**
+ * @brief What entering a screen is going to declare (gameplay starts in the fight the save was in, or exploring).
+ * @param screen The screen about to be entered.
+ * @return std::vector<TextureSet::Source> The texture list, empty if there is nothing to prepare.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::vector<TextureSet::Source> ScreenTextureSources(ScreenState screen)
+{
+    switch (screen) {
+    case ScreenState::MAIN_MENU: return MenuTextureSources();
+    case ScreenState::CHARACTER_SELECT: return CharacterSelectTextureSources();
+    case ScreenState::INTRO_CRAWL: return {};
+    case ScreenState::GAMEPLAY: return GameStateTextureSources(activeEncounterID != -1 ? GameState::COMBAT : GameState::EXPLORATION);
+    }
+    return {};
+}
+
+/**
+ * @brief Starts fading out towards a screen or game state and prefetches its textures. A transition already fading out wins
+ *        (nothing can ask twice, input is off while it fades), one fading in turns around from where it is.
+ * @param sources The textures the target is going to declare.
+ * @param toGameState Whether the target is gameState instead of screen.
+ * @param screen Target screen.
+ * @param gameState Target game state.
+ * @return bool True if the transition started.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool BeginTransition(const std::vector<TextureSet::Source>& sources, bool toGameState, ScreenState screen, GameState gameState)
+{
+    if (transition.phase == ScreenTransition::Phase::FadeOut) return false;
+    ScreenTextures.prefetch(sources);
+    transition.phase = ScreenTransition::Phase::FadeOut;
+    transition.toGameState = toGameState;
+    transition.screen = screen;
+    transition.gameState = gameState;
+    return true;
 }
 
 //======================= SOUND INITIALIZATION =======================
@@ -682,14 +812,12 @@ void InitGameScenes(Character* playerCharacter)
  */
 void InitGameSounds() 
 {
-    // create array to hold all our sounds
-    gameSounds = new Sound[TOTAL_SOUNDS];
-    // load each sound from file
-    gameSounds[SND_SELECT] = LoadSound("../assets/sfx/select.wav"); // UI click sound
-    gameSounds[SND_HIT] = LoadSound("../assets/sfx/hitHurt.wav"); // sound when someone gets hit
-    gameSounds[SND_HEAL] = LoadSound("../assets/sfx/heal.wav"); // healing sound
-    gameSounds[SND_ZOM_DEATH] = LoadSound("../assets/sfx/explosion.wav"); // zombie death sound
-    gameSounds[SND_ZOM_GROAN] = LoadSound("../assets/sfx/zombieGroan.wav"); // creepy zombie noise
+    // load each sound from file (the handles unload the old ones if there were any)
+    gameSounds[SND_SELECT].reset(LoadSound("../assets/sfx/select.wav"), MemOwner::Shared); // UI click sound
+    gameSounds[SND_HIT].reset(LoadSound("../assets/sfx/hitHurt.wav"), MemOwner::Shared); // sound when someone gets hit
+    gameSounds[SND_HEAL].reset(LoadSound("../assets/sfx/heal.wav"), MemOwner::Shared); // healing sound
+    gameSounds[SND_ZOM_DEATH].reset(LoadSound("../assets/sfx/explosion.wav"), MemOwner::Shared); // zombie death sound
+    gameSounds[SND_ZOM_GROAN].reset(LoadSound("../assets/sfx/zombieGroan.wav"), MemOwner::Shared); // creepy zombie noise
     
 }
 
@@ -770,23 +898,22 @@ void playerSelectStyles() {
 }
 
 /**
- * @brief Sets the GUI styles for the gameplay screen and also loads the nerd font for icons. The nerd font is this cool font that has icons built into it like swords and shields and stuff. Without it we wouldnt have the fancy icons in combat. Uses player select styles as base cause they already look pretty good.
+ * @brief Sets the GUI styles for the gameplay screen and also loads the nerd font for icons (the first time, it stays loaded after that). The nerd font is this cool font that has icons built into it like swords and shields and stuff. Without it we wouldnt have the fancy icons in combat. Uses player select styles as base cause they already look pretty good.
  * @return void
  * @version 1.0
  * @author Edwin Baiden
  */
 void gamePlayStyles() {
-    CleanupNerdFont(); // get rid of old font if theres one loaded already
-    nerdFont = new Font(); // make a new font pointer
+    playerSelectStyles(); // use the green theme for gameplay too
+    if (nerdFont) return; // loaded once, every gameplay state uses the same one
     // these are the codepoints (basically character codes) for the icons we need
     // nerd fonts have alot of icons
     int codepoints[11] = {ICON_SWORD, ICON_BOW_ARROW, ICON_POISON, ICON_FIRE, ICON_ARROW_DOWN, 
                           ICON_ARROW_UP, ICON_PLUS, ICON_SNAIL, ICON_LIGHTNING, 
                           ICON_SHIELD, ICON_PAUSE};
     ChangeDirectory(GetApplicationDirectory()); // gotta change directory again (cause MacOS is picky about file paths)
-    *nerdFont = LoadFontEx("../assets/fonts/JetBrainsMonoNLNerdFontMono-Bold.ttf", 32, codepoints, 11);
+    nerdFont.reset(LoadFontEx("../assets/fonts/JetBrainsMonoNLNerdFontMono-Bold.ttf", 32, codepoints, 11), MemOwner::Shared);
     SetTextureFilter(nerdFont->texture, TEXTURE_FILTER_BILINEAR); // makes the font look smooth instead of pixely
-    playerSelectStyles(); // use the green theme for gameplay too
 }
 
 
@@ -848,36 +975,136 @@ void getIntroCrawlText(std::stringstream *ss, int chosenCharacterIdx) {
  * @author Edwin Baiden
  */
 void DrawStatusPanel(const Rectangle &panel, const StatusEffects &entityStatEff, const Font &fnt) {
-    // lil struct to hold info about each status we need to draw
-    struct StatusType { const char *Effect; std::string Icon; Color GoodOrBadEff; };
-    std::vector<StatusType> activeStatEffects; // list of currently active effects
-
-    // Check each possible status effect and add to the list if its active
-    // RED = bad stuff happening to you
-    if (entityStatEff.isPoisoned) activeStatEffects.push_back({"POISONED", CodepointToUTF8(ICON_POISON, &byteSize), RED});
-    if (entityStatEff.isBurning) activeStatEffects.push_back({"BURNING", CodepointToUTF8(ICON_FIRE, &byteSize), RED});
-    if (entityStatEff.isWeakened) activeStatEffects.push_back({"WEAKENED", CodepointToUTF8(ICON_ARROW_DOWN, &byteSize), RED});
-    if (entityStatEff.isSlowed) activeStatEffects.push_back({"SLOWED", CodepointToUTF8(ICON_SNAIL, &byteSize), RED}); // snail = slow
-    // GREEN = good stuff
-    if (entityStatEff.isStrengthened) activeStatEffects.push_back({"STRENGTHENED", CodepointToUTF8(ICON_ARROW_UP, &byteSize), GREEN});
-    if (entityStatEff.isRegenerating) activeStatEffects.push_back({"REGENERATING", CodepointToUTF8(ICON_PLUS, &byteSize), GREEN});
-    if (entityStatEff.isFast) activeStatEffects.push_back({"FAST", CodepointToUTF8(ICON_LIGHTNING, &byteSize), GREEN});
-    if (entityStatEff.defending) activeStatEffects.push_back({"DEFENDING", CodepointToUTF8(ICON_SHIELD, &byteSize), GREEN});
-
-    // now draw each active status effect
-    for (size_t i = 0; i < activeStatEffects.size(); ++i) {
+    // lil table with how to draw each status, indexed by StatusEffectId so the bit number is the row
+    // RED = bad stuff happening to you, GREEN = good stuff
+    struct StatusType { const char *Effect; int Icon; Color GoodOrBadEff; };
+    static const StatusType statusTypes[SE_COUNT] = {
+        {"POISONED",     ICON_POISON,     RED},
+        {"BURNING",      ICON_FIRE,       RED},
+        {"WEAKENED",     ICON_ARROW_DOWN, RED},
+        {"SLOWED",       ICON_SNAIL,      RED}, // snail = slow
+        {"STRENGTHENED", ICON_ARROW_UP,   GREEN},
+        {"REGENERATING", ICON_PLUS,       GREEN},
+        {"FAST",         ICON_LIGHTNING,  GREEN},
+        {"DEFENDING",    ICON_SHIELD,     GREEN},
+    };
+
+    // walk the set bits only (lowest bit first), nothing gets allocated per frame
+    int row = 0;
+    for (unsigned bits = entityStatEff.active; bits != 0; bits &= bits - 1, ++row) {
+        const StatusType &status = statusTypes[__builtin_ctz(bits)];
+        float rowY = panel.y + 8.0f + (row * 28.0f);
+
         // Draw the status effect name text on the left side
-        DrawTextEx(GetFontDefault(), activeStatEffects[i].Effect,
-                   {panel.x + 8.0f, 
-                    panel.y + 8.0f + (i * 28.0f) + ((28.0f - MeasureTextEx(GetFontDefault(), activeStatEffects[i].Effect, 24.0f, 1.0f).y) / 2.0f)}, // centered vertically in the row
-                   24.0f, 1.0f, activeStatEffects[i].GoodOrBadEff);
-        
+        DrawTextEx(GetFontDefault(), status.Effect,
+                   {panel.x + 8.0f,
+                    rowY + ((28.0f - MeasureTextEx(GetFontDefault(), status.Effect, 24.0f, 1.0f).y) / 2.0f)}, // centered vertically in the row
+                   24.0f, 1.0f, status.GoodOrBadEff);
+
         // Draw the icon on the right side of the panel
-        DrawTextEx(fnt, activeStatEffects[i].Icon.c_str(),
-                   {panel.x + panel.width - 8.0f - MeasureTextEx(fnt, activeStatEffects[i].Icon.c_str(), 44.0f, 1.0f).x, // right aligned
-                    panel.y + 8.0f + (i * 28.0f) + ((28.0f - MeasureTextEx(fnt, activeStatEffects[i].Icon.c_str(), 44.0f, 1.0f).y) / 2.0f)},
-                   44.0f, 1.0f, activeStatEffects[i].GoodOrBadEff);
+        const char *icon = CodepointToUTF8(status.Icon, &byteSize); // raylib static buffer, used right away
+        Vector2 iconSize = MeasureTextEx(fnt, icon, 44.0f, 1.0f);
+        DrawTextEx(fnt, icon,
+                   {panel.x + panel.width - 8.0f - iconSize.x, // right aligned
+                    rowY + ((28.0f - iconSize.y) / 2.0f)},
+                   44.0f, 1.0f, status.GoodOrBadEff);
+    }
+}
+
+//======================= MEMORY GAUGES =======================
+/**
+ * @brief Tells the memory ledger about the heap the screens hold that the resource handles dont cover, polled as gauges
+ *        (memoryLedger.h). Called once from init().
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void RegisterMemoryGauges()
+{
+    memAddGauge(MemOwner::Shared, "entity pool", [] { return entityPool.capacity() * ENTITY_SLOT_SIZE; });
+    memAddGauge(MemOwner::Shared, "world snapshots", [] { return sizeof(worldHistory) + sizeof(quickSave); });
+    memAddGauge(MemOwner::MainMenu, "save slot index", [] { return sizeof(saveListing); }); // thumbnails included
+    memAddGauge(MemOwner::IntroCrawl, "intro crawl text", [] {
+        return scrollIntroCrawl ? (std::size_t)std::max<std::streamoff>(0, scrollIntroCrawl->tellp()) : (std::size_t)0;
+    });
+    memAddGauge(MemOwner::Exploration, "loaded buildings", [] { return sceneLibrary.heapBytes(); });
+    memAddGauge(MemOwner::Exploration, "route tables", [] {
+        return objectiveRoute.capacity() * sizeof(int) + visitedRooms.size() * (sizeof(int) + sizeof(std::bitset<SCENE_MAX_PER_BUILDING>) + 32);
+    });
+    memAddGauge(MemOwner::Combat, "fight (log, journal)", [] { return gameManager ? gameManager->heapBytes() : (std::size_t)0; });
+}
+
+//======================= FRAME ALLOCATIONS =======================
+/**
+ * @brief Closes the frame's allocation count (frameMemory.h). Looking at a room or at the player's turn of a fight must not
+ *        allocate, so once nothing has happened for a while (no input, no change of room/turn/log, no fade, no save finishing)
+ *        a frame that allocated anyway is logged, once per quiet stretch. With "make TRACK_ALLOCS=strict" the game stops
+ *        there instead. Without TRACK_ALLOCS nothing is counted and this only keeps the frame bookkeeping going.
+ *        Called at the end of render(), right before EndDrawing (which polls the input of the next frame).
+ * @param screen The screen that was drawn.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void WatchFrameAllocations(ScreenState screen)
+{
+    static ScreenState lastScreen = ScreenState::MAIN_MENU;
+    static bool lastOverlay = false;
+    static bool reported = false; // this quiet stretch already logged
+
+    const bool playing = screen == ScreenState::GAMEPLAY && gameManager && gameManager->isSteadyState();
+    const std::uint64_t stamp = gameManager ? gameManager->stateStamp() : 0;
+    const Vector2 wheel = GetMouseWheelMoveV();
+    // GetKeyPressed() takes keys out of raylib's queue, update() has run by now so nothing else wants them
+    if (!playing || transition.phase != ScreenTransition::Phase::None || screen != lastScreen || stamp != lastStateStamp ||
+        memoryOverlay != lastOverlay || GetKeyPressed() != 0 || wheel.x != 0.0f || wheel.y != 0.0f ||
+        IsMouseButtonPressed(MOUSE_BUTTON_LEFT) || IsMouseButtonReleased(MOUSE_BUTTON_LEFT) ||
+        IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) || IsMouseButtonReleased(MOUSE_BUTTON_RIGHT))
+        frameMarkBusy();
+    lastScreen = screen;
+    lastStateStamp = stamp;
+    lastOverlay = memoryOverlay;
+
+    lastFrame = frameEnd();
+    if (!lastFrame.steady) {
+        reported = false;
+        return;
     }
+    ++steadyFrames;
+    if (lastFrame.allocs.count == 0) return;
+
+    ++steadyAllocFrames;
+    if (reported) return;
+    reported = true;
+#ifdef TLL_ALLOC_STRICT
+    TraceLog(LOG_FATAL, "Frame allocations: a steady %s frame allocated %d times (%d bytes)",
+             gameManager->getCurrentGameState() == GameState::COMBAT ? "combat" : "exploration",
+             (int)lastFrame.allocs.count, (int)lastFrame.allocs.bytes);
+#else
+    TraceLog(LOG_ERROR, "Frame allocations: a steady %s frame allocated %d times (%d bytes)",
+             gameManager->getCurrentGameState() == GameState::COMBAT ? "combat" : "exploration",
+             (int)lastFrame.allocs.count, (int)lastFrame.allocs.bytes);
+#endif
+}
+
+/**
+ * @brief One line under the memory overlay: what the last frame allocated, the frame arena's high water mark and how many
+ *        steady frames allocated so far (counts only in TRACK_ALLOCS builds).
+ * @param x Left edge in window pixels.
+ * @param y Top edge in window pixels.
+ * @param fontSize Text size.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void DrawFrameAllocations(int x, int y, int fontSize)
+{
+    const char* text = ALLOC_TRACKING
+        ? TextFormat("FRAME  allocs %d (%d B)  arena peak %d B  steady frames that allocated: %d%s", (int)lastFrame.allocs.count,
+                     (int)lastFrame.allocs.bytes, (int)frameArena().peak(), steadyAllocFrames, lastFrame.steady ? "  [steady]" : "")
+        : TextFormat("FRAME  arena peak %d B  (allocations counted with make TRACK_ALLOCS=1)", (int)frameArena().peak());
+    DrawRectangle(x - 6, y - 4, MeasureText(text, fontSize) + 12, fontSize + 8, Fade(BLACK, 0.75f));
+    DrawText(text, x, y, fontSize, steadyAllocFrames > 0 ? RED : RAYWHITE);
 }
 
 //=================== SCREENMANAGER CLASS ===================
@@ -906,16 +1133,209 @@ ScreenManager::ScreenManager(ScreenState initial) : currentScreen(initial), scal
  * @author Edwin Baiden
  */
 ScreenManager::~ScreenManager() {
+    datWatcher.stop(); // stop the hot reload thread first
+    saveService.stop(); // finishes writing a save that is still in flight (quit right after "Save & Exit")
+    memRelease(MemOwner::Shared, memFootprint(target));
+    memRelease(MemOwner::Shared, memFootprint(thumbnailTarget));
     UnloadRenderTexture(target); // unload the render texture we use for scaling
+    UnloadRenderTexture(thumbnailTarget); // and the one save thumbnails are shrunk in
     exitScreen(currentScreen); // clean up whatever screen were on
     
     // Clean up persistent resources that last the entire game session
     // these are things that exist across multiple screens
-    CleanupGameSounds();
+    ReleaseScreenResources();
     CleanupEntities();
-    CleanupStatLines();
-    CleanupNerdFont();
-    CleanupIntroCrawl();
+}
+
+/**
+ * @brief Hot reload. Picks up the files the dat/ watcher saw change and reloads only those. Called once per frame at the
+ *        top of update() so nothing this frame has used the old data yet. Every reload parses into a fresh copy first and
+ *        only swaps it in if that worked, so a half saved file never leaves the game with broken data.
+ *          - Stats CSV / override CSV: the override wins if its there, then the edited CSV, then the compiled in stats.
+ *            Characters that already exist keep their stats, the next one created (enemy, new game) uses the new ones.
+ *          - *_Intro.txt: the intro crawl text is rebuilt if its on screen (otherwise its read fresh next time anyway).
+ *          - scenes/building<N>.json: a loaded building is read again (layout seed applied) and swapped in, buildings not loaded
+ *            yet read the new file when the player gets there. The building the player is in waits for exploration (a fight
+ *            or the pause menu has other textures up) and reloads its room textures with it, edits that delete the room the
+ *            player stands in are refused. Nothing is swapped during a transition, it waits for the next frame.
+ * @param screen The screen were on.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void ApplyDataReloads(ScreenState screen) {
+    bool statsChanged = false, introChanged = false;
+    for (const std::string& name : datWatcher.takeChanges()) {
+        TraceLog(LOG_INFO, "Hot reload: dat/%s changed", name.c_str());
+        int number = 0;
+        char ext[8] = {};
+        if (name == "Character_Starting_Stats.csv" || name == "Character_Starting_Stats.override.csv") statsChanged = true;
+        else if (name.size() > 10 && name.compare(name.size() - 10, 10, "_Intro.txt") == 0) introChanged = true;
+        else if (std::sscanf(name.c_str(), "scenes/building%d.%7s", &number, ext) == 2 && std::strcmp(ext, "json") == 0 &&
+                 number >= 1 && number <= SCENE_MAX_BUILDINGS)
+            buildingReloads.set(number - 1); // the .tlb the reload writes back is not a change of its own
+    }
+
+    if (statsChanged || introChanged) frameMarkBusy(); // reloading allocates, not a steady frame
+
+    // edited buildings, swapped only where nothing holds on to the old version
+    if (buildingReloads.any() && transition.phase == ScreenTransition::Phase::None) {
+        const bool exploring = screen == ScreenState::GAMEPLAY && gameManager &&
+                               gameManager->getCurrentGameState() == GameState::EXPLORATION;
+        for (int index = 0; index < SCENE_MAX_BUILDINGS; ++index) {
+            if (!buildingReloads.test(index)) continue;
+            const bool onScreen = currentBuilding && currentBuilding->index == index;
+            if (onScreen && screen == ScreenState::GAMEPLAY && !exploring) continue; // after the fight / pause menu
+            buildingReloads.reset(index);
+            frameMarkBusy();
+
+            const bool routed = sceneRouter.building() && sceneRouter.building()->index == index; // checked while the old version is alive
+            const int keepRoom = entities[0] && SCENE_BUILDING(currentSceneIndex) == index ? SCENE_ROOM(currentSceneIndex) : -1;
+            ChangeDirectory(GetApplicationDirectory()); // the scene directory is relative to the executable
+            if (!sceneLibrary.reload(index, keepRoom)) {
+                TraceLog(LOG_WARNING, "Hot reload: keeping building %d, %s", index + 1, sceneLibrary.error().c_str());
+                continue;
+            }
+            TraceLog(LOG_INFO, "Hot reload: building %d updated", index + 1);
+            if (routed) sceneRouter.build(*sceneLibrary.building(index)); // room graph of the new version
+            if (!onScreen) continue;
+            if (exploring) InitGameScenes(entities[0]); // only the room textures whose files changed get loaded
+            else currentBuilding = nullptr; // not playing, gameplay loads it again when it starts
+        }
+    }
+
+    if (statsChanged) {
+        // loadOverride keeps the old rows if the file cant be read or has the wrong columns
+        if (!startingStats.loadOverride(STATS_OVERRIDE_PATH) && !startingStats.loadOverride(STATS_CSV_RUNTIME_PATH))
+            startingStats.useBuiltin();
+    }
+
+    if (introChanged && screen == ScreenState::INTRO_CRAWL && scrollIntroCrawl) {
+        std::stringstream fresh;
+        getIntroCrawlText(&fresh, introCrawlCharacter);
+        scrollIntroCrawl->swap(fresh); // keeps scrolling from the same spot
+    }
+}
+
+/**
+ * @brief Brings the load menu info of the slot being played up to date with a snapshot that is about to be saved
+ *        (the thumbnail is kept, CaptureSaveThumbnail refreshes it on room changes).
+ * @param snapshot The SaveData that is being saved.
+ * @return const SlotInfo& currentSlotInfo, to hand to the save service together with the snapshot.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+const SlotInfo& FillSlotInfo(const SaveData& snapshot) {
+    currentSlotInfo.archetype = snapshot.archetype;
+    std::memcpy(currentSlotInfo.name, snapshot.name, SAVE_NAME_MAX);
+    // in a fight the player is shown where they walked in
+    const int scene = snapshot.activeEncounterID != -1 ? snapshot.savedPlayerSceneIndex : snapshot.currentSceneIndex;
+    std::memset(currentSlotInfo.sceneName, 0, SAVE_SCENE_NAME_MAX);
+    std::strncpy(currentSlotInfo.sceneName, SceneName(scene), SAVE_SCENE_NAME_MAX - 1);
+    currentSlotInfo.health = snapshot.health;
+    currentSlotInfo.maxHealth = snapshot.maxHealth;
+    currentSlotInfo.playtimeSeconds = (std::uint32_t)playtimeSeconds;
+    currentSlotInfo.savedAt = (std::int64_t)std::time(nullptr);
+    return currentSlotInfo;
+}
+
+/**
+ * @brief Autosave. Snapshots the game state and hands it to the save service, which only appends what changed since the
+ *        last autosave to the autosave journal (a few bytes), so its fine to call on every room change, pickup and fight.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void AutosaveProgress() {
+    if (!asPlayer(entities[0]) || scriptedRun) return; // nothing to save yet (or the allocation check is playing)
+    SaveData snapshot;
+    packSaveData(entities, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems, snapshot);
+    saveService.autosave(snapshot, FillSlotInfo(snapshot));
+}
+
+/**
+ * @brief Migrates the single save from before save slots (savegame.tls, or the even older savegame.json) into slot 1.
+ *        Only runs while every slot is empty, so it happens once. The old files are left alone.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void MigrateLegacySave() {
+    SaveIndex index = saveService.listing();
+    for (const SlotInfo& info : index.slots)
+        if (info.used) return; // already using slots
+
+    SaveData data;
+    if (!readSaveState(SAVE_PATH, data) &&
+        !(std::filesystem::exists(SAVE_JSON_PATH) && importSaveJson(SAVE_JSON_PATH) && readSaveState(SAVE_PATH, data)))
+        return; // no old save either
+
+    SlotInfo info{}; // no thumbnail, it gets one the next time the slot is saved
+    info.archetype = data.archetype;
+    std::memcpy(info.name, data.name, SAVE_NAME_MAX);
+    const int scene = data.activeEncounterID != -1 ? data.savedPlayerSceneIndex : data.currentSceneIndex;
+    std::strncpy(info.sceneName, SceneName(scene), SAVE_SCENE_NAME_MAX - 1);
+    info.health = data.health;
+    info.maxHealth = data.maxHealth;
+    info.savedAt = (std::int64_t)std::time(nullptr);
+    saveService.selectSlot(0);
+    saveService.submit(data, info);
+    TraceLog(LOG_INFO, "Migrated %s to save slot 1", SAVE_PATH);
+}
+
+/**
+ * @brief Loads a save slot and goes to gameplay. The slot being played might still be writing, so it comes straight from
+ *        the save service's last snapshot, any other slot is read from its file (plus its autosave journal).
+ * @param slot Slot to load (0 based).
+ * @return bool True if the slot was loaded.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool LoadSaveSlot(int slot) {
+    SaveData data;
+    if (!(slot == saveService.activeSlot() && saveService.latest(data)) && !readSaveState(saveService.slotPath(slot), data)) {
+        TraceLog(LOG_WARNING, "Save slot %d could not be read", slot + 1);
+        return false;
+    }
+    if (!isPlayerSave(data)) {
+        TraceLog(LOG_WARNING, "Save slot %d does not hold a player", slot + 1);
+        return false; // checked before the running game is thrown away
+    }
+    entityPool.clear();
+    entities[0] = entities[1] = nullptr;
+    unpackSaveData(data, entityPool, entities, startingStats, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems);
+
+    if (slot != saveService.activeSlot()) saveService.selectSlot(slot);
+    currentSlotInfo = saveListing.slots[slot];
+    playtimeSeconds = (float)currentSlotInfo.playtimeSeconds;
+    thumbnailStale = true;
+    worldHistory.clear(); // snapshots belong to the session they were taken in
+    visitedRooms.clear(); // fast travel starts over with the room the save is in
+    hasQuickSave = false;
+    return true;
+}
+
+/**
+ * @brief Shrinks the frame that was just drawn into the slot thumbnail (on the GPU, only the small image is read back).
+ *        Called right after the frame is finished, only when the room changed.
+ * @param frame The render texture the game was drawn to.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void CaptureSaveThumbnail(const RenderTexture2D& frame) {
+    BeginTextureMode(thumbnailTarget);
+    DrawTexturePro(frame.texture, {0.0f, 0.0f, (float)frame.texture.width, -(float)frame.texture.height},
+                   {0.0f, 0.0f, (float)SAVE_THUMB_WIDTH, (float)SAVE_THUMB_HEIGHT}, {0.0f, 0.0f}, 0.0f, WHITE);
+    EndTextureMode();
+
+    Image thumb = LoadImageFromTexture(thumbnailTarget.texture);
+    ImageFlipVertical(&thumb); // render textures are upside down
+    ImageFormat(&thumb, PIXELFORMAT_UNCOMPRESSED_R8G8B8);
+    if (thumb.data && thumb.width == SAVE_THUMB_WIDTH && thumb.height == SAVE_THUMB_HEIGHT)
+        std::memcpy(currentSlotInfo.thumbnail, thumb.data, SAVE_THUMB_BYTES);
+    UnloadImage(thumb);
+    thumbnailStale = false;
 }
 
 /**
@@ -925,11 +1345,24 @@ ScreenManager::~ScreenManager() {
  * @author Edwin Baiden
  */
 void ScreenManager::init() {
+    platformSetLogSink(ForwardCoreLog); // characters, combat and saves log through raylib too
     ChangeDirectory(GetApplicationDirectory()); // directory stuff (cause MacOS is picky about file paths)
     target = LoadRenderTexture(GAME_SCREEN_WIDTH, GAME_SCREEN_HEIGHT); // Create render texture for resolution scaling
+    memCharge(MemOwner::Shared, memFootprint(target)); // raw raylib struct, not a handle (released in the destructor)
     InitGameSounds(); // Load all game sounds so we can hear things
     SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR); // makes scaling look smooth
+    // watch dat/ and dat/scenes/ so stats, intro text and buildings can be edited while the game runs (Linux only, does nothing elsewhere)
+    if (datWatcher.start(std::string(GetApplicationDirectory()) + "../dat", {"scenes"}))
+        TraceLog(LOG_INFO, "Hot reload: watching dat/ and dat/scenes/");
+    thumbnailTarget = LoadRenderTexture(SAVE_THUMB_WIDTH, SAVE_THUMB_HEIGHT); // save slot thumbnails get shrunk in here
+    memCharge(MemOwner::Shared, memFootprint(thumbnailTarget));
+    SetTextureFilter(thumbnailTarget.texture, TEXTURE_FILTER_BILINEAR);
+    saveService.start(std::string(GetApplicationDirectory()) + SAVE_DIR); // saves are written on a worker thread
+    MigrateLegacySave(); // the save from before slots becomes slot 1
+    RegisterMemoryGauges(); // heap the resource handles dont cover
     enterScreen(currentScreen); // Enter the initial screen and load its stuff
+    transition.phase = ScreenTransition::Phase::FadeIn; // and fade in from black
+    transition.fade = 1.0f;
 }
 
 /**
@@ -946,6 +1379,53 @@ void ScreenManager::changeScreen(ScreenState newScreen) {
     enterScreen(currentScreen); // Setup new screen and load its stuff
 }
 
+/**
+ * @brief Changes screens behind a fade. The new screen's textures are decoded in the background while the current one fades out,
+ *        updateTransition swaps them once its black and they are all uploaded (see TRANSITION FUNCTIONS).
+ * @param newScreen The ScreenState to transition to.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void ScreenManager::requestScreen(ScreenState newScreen) {
+    if (newScreen == currentScreen) return;
+    BeginTransition(ScreenTextureSources(newScreen), false, newScreen, GameState::EXPLORATION);
+}
+
+/**
+ * @brief Runs the transition in progress: fades out while uploading at most TRANSITION_UPLOADS_PER_FRAME prefetched textures a frame,
+ *        swaps to the target once the screen is black and everything is on the GPU, then fades back in.
+ *        A slow disk just keeps it black a little longer.
+ * @param dt Delta time in seconds.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void ScreenManager::updateTransition(float dt) {
+    switch (transition.phase) {
+    case ScreenTransition::Phase::None:
+        break;
+
+    case ScreenTransition::Phase::FadeOut: {
+        transition.fade = std::min(1.0f, transition.fade + dt / TRANSITION_FADE_TIME);
+        const bool resident = ScreenTextures.pump(TRANSITION_UPLOADS_PER_FRAME);
+        if (transition.fade < 1.0f || !resident) break;
+
+        transition.phase = ScreenTransition::Phase::FadeIn;
+        if (!transition.toGameState)
+            changeScreen(transition.screen);
+        else if (gameManager && currentScreen == ScreenState::GAMEPLAY)
+            gameManager->changeGameState(transition.gameState);
+        break;
+    }
+
+    case ScreenTransition::Phase::FadeIn:
+        transition.fade = std::max(0.0f, transition.fade - dt / TRANSITION_FADE_TIME);
+        if (transition.fade <= 0.0f) transition.phase = ScreenTransition::Phase::None;
+        break;
+    }
+}
+
 /**
  * @brief Returns the current screen state. Just a getter function nothing special.
  * @return ScreenState The current screen state enum value (which screen were on rn).
@@ -956,6 +1436,78 @@ ScreenState ScreenManager::getCurrentScreen() const {
     return currentScreen; // here you go
 }
 
+/**
+ * @brief The zero allocation check "make alloc-check" runs (TRACK_ALLOCS build, hidden window, no input). Starts a new game
+ *        in the first room and draws frames frames of it, then starts a fight there and draws frames frames of it (the
+ *        enemy's opening move if it wins initiative, then the player's turn, which waits for input forever). Once each phase
+ *        settles (ALLOC_SETTLE_FRAMES) every frame is steady, and WatchFrameAllocations counts the ones that allocated.
+ *        Nothing is saved, the slots belong to the player.
+ * @param frames Frames per phase, has to be well over ALLOC_SETTLE_FRAMES for the steady frames to say anything.
+ * @return int Exit code: 0 = every steady frame was allocation free, 1 = some allocated, 2 = the check could not run
+ *         (not a tracking build, no player/room/fight, or a phase never settled).
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+int ScreenManager::runAllocationCheck(int frames) {
+    if (!ALLOC_TRACKING) {
+        TraceLog(LOG_ERROR, "Allocation check: this build does not count allocations (make alloc-check builds one that does)");
+        return 2;
+    }
+    scriptedRun = true;
+    SetTargetFPS(0); // no need to wait for vsync, every frame gets the same dt anyway
+    const float dt = 1.0f / 30.0f;
+
+    // same reset as START, without the character select and the intro crawl
+    CleanupEntities();
+    CreateCharacter(entityPool, entities, startingStats, "Student", "Steve");
+    loadedFromSave = false;
+    activeEncounterID = -1;
+    currentSceneIndex = savedPlayerSceneIndex = SCENE_START_ID;
+    battleWon.clear();
+    collectedItems.reset();
+    changeScreen(ScreenState::GAMEPLAY);
+
+    struct Phase { const char* name; int steady; int allocated; };
+    Phase phases[2] = {{"exploration", 0, 0}, {"combat", 0, 0}};
+    for (int p = 0; p < 2; ++p) {
+        if (!gameManager) {
+            TraceLog(LOG_ERROR, "Allocation check: gameplay did not start");
+            scriptedRun = false;
+            return 2;
+        }
+        if (p == 1) { // a fight right here (the encounter picks the enemy, the player is where they walked in)
+            activeEncounterID = 0;
+            savedPlayerSceneIndex = currentSceneIndex;
+            gameManager->changeGameState(GameState::COMBAT);
+            if (gameManager->getCurrentGameState() != GameState::COMBAT) {
+                TraceLog(LOG_ERROR, "Allocation check: the fight did not start");
+                scriptedRun = false;
+                return 2;
+            }
+        }
+        const int steadyBefore = steadyFrames, allocatedBefore = steadyAllocFrames;
+        for (int f = 0; f < frames && !WindowShouldClose(); ++f) {
+            update(dt);
+            render();
+        }
+        phases[p].steady = steadyFrames - steadyBefore;
+        phases[p].allocated = steadyAllocFrames - allocatedBefore;
+        TraceLog(LOG_INFO, "Allocation check: %s: %d steady frames, %d allocated", phases[p].name, phases[p].steady, phases[p].allocated);
+    }
+    scriptedRun = false;
+
+    int result = 0;
+    for (const Phase& phase : phases) {
+        if (phase.allocated > 0) result = 1;
+        else if (phase.steady == 0 && result == 0) {
+            TraceLog(LOG_ERROR, "Allocation check: %s never settled, nothing was checked (more frames?)", phase.name);
+            result = 2;
+        }
+    }
+    TraceLog(result == 0 ? LOG_INFO : LOG_ERROR, "Allocation check: %s", result == 0 ? "passed" : "FAILED");
+    return result;
+}
+
 /**
  * @brief Converts the actual mouse position to virtual (game resolution) coordinates. This is needed because the game renders at a fixed resolution that gets scaled to fit the window. Without this clicks would be in the wrong spot and players would be confused.
  * @return Vector2 The mouse position in virtual/game coordinates (where the mouse ACTUALLY is in game terms).
@@ -979,13 +1531,29 @@ Vector2 ScreenManager::GetVirtualMousePosition() {
  * @author Edwin Baiden
  */
 void ScreenManager::update(float dt) {
-    UpdateMusicStream(backgroundMusic); // keep the music playing smoothly
+    frameBegin(); // empties the frame arena, allocations are counted from here until render() is done
+    ApplyDataReloads(currentScreen); // safe point for hot reload, nothing has touched the data this frame yet
+    if (saveService.poll() > 0) frameMarkBusy(); // ran the callbacks of saves that finished writing
+    if (backgroundMusic) UpdateMusicStream(*backgroundMusic); // keep the music playing smoothly
     // Calculate scale and offset for resolution-independent rendering
     // this math figures out how to fit the game in the window
     scale = std::min((float)GetScreenWidth() / GAME_SCREEN_WIDTH, (float)GetScreenHeight() / GAME_SCREEN_HEIGHT);
     offset = {((float)GetScreenWidth() - ((float)GAME_SCREEN_WIDTH * scale)) * 0.5f,
               ((float)GetScreenHeight() - ((float)GAME_SCREEN_HEIGHT * scale)) * 0.5f};
 
+    // memory counters (gauges polled and budgets checked every MEM_SAMPLE_SECONDS), overlay and dump hotkeys
+    memSample(dt);
+    if (IsKeyPressed(KEY_MEMORY_OVERLAY)) memoryOverlay = !memoryOverlay;
+    if (IsKeyPressed(KEY_MEMORY_DUMP)) {
+        const std::string dumpPath = std::string(GetApplicationDirectory()) + MEM_DUMP_PATH;
+        if (memDump(dumpPath)) TraceLog(LOG_INFO, "Memory: counters written to %s", dumpPath.c_str());
+        else TraceLog(LOG_WARNING, "Memory: could not write %s", dumpPath.c_str());
+    }
+
+    // fading out to another screen/game state: nothing moves or takes input until the next one is in
+    updateTransition(dt);
+    if (transition.phase == ScreenTransition::Phase::FadeOut) return;
+
     // do different stuff depending on which screen were on
     switch (currentScreen) {
     case ScreenState::MAIN_MENU:
@@ -994,8 +1562,6 @@ void ScreenManager::update(float dt) {
         break;
 
     case ScreenState::CHARACTER_SELECT: {
-        if (!characterCards || !CharSelectionStuff) break; // safety check
-
         // Update character card textures (make sure they have the right images)
         for (int i = 0; i < MAX_CHAR_CARDS; ++i)
             characterCards[i].texture = ScreenTextures[i + 1]; // +1 cause index 0 is background
@@ -1080,10 +1646,12 @@ void ScreenManager::update(float dt) {
         introCrawlYPos -= INTRO_CRAWL_SPEED * dt;
         // when text goes off screen or player presses enter, move to gameplay
         if (introCrawlYPos <= INTRO_CRAWL_END_Y || IsKeyPressed(KEY_ENTER))
-            changeScreen(ScreenState::GAMEPLAY);
+            requestScreen(ScreenState::GAMEPLAY);
         break;
 
     case ScreenState::GAMEPLAY:
+        // the pause menu doesnt count towards the playtime the load menu shows
+        if (gameManager->getCurrentGameState() != GameState::PAUSE_MENU) playtimeSeconds += dt;
         // gameplay has its own manager so just let it do its thing
         gameManager->update(dt);
         break;
@@ -1106,6 +1674,10 @@ void ScreenManager::render() {
     SetMouseOffset(-offset.x, -offset.y);
     SetMouseScale(1.0f / scale, 1.0f / scale);
 
+    // buttons dont react while fading out (the screen they would act on is on its way out)
+    const bool fadingOut = transition.phase == ScreenTransition::Phase::FadeOut;
+    if (fadingOut) GuiLock();
+
     // Begin rendering to the render texture (not directly to screen)
     BeginTextureMode(target);
     ClearBackground(BLACK); // start with black background
@@ -1120,30 +1692,91 @@ void ScreenManager::render() {
         DrawTexture(ScreenTextures[1], CENTERED_X(ScreenTextures[1].width), -150, WHITE);
 
         endScreenPhase = 0;
-        // START/RESTART button - if we loaded from save it says RESTART instead
-        if (GuiButton(ScreenRects[0], !loadedFromSave ? "START" : "RESTART"))
+        bool hasSaves = false; // any slot used
+        for (const SlotInfo& info : saveListing.slots) hasSaves |= info.used != 0;
+
+        // Load menu - one row per slot, all from the slot index (thumbnails are ScreenTextures[2..])
+        if (loadMenuOpen)
         {
-            changeScreen(ScreenState::CHARACTER_SELECT);
-            // Reset all game state for new game (fresh start)
-            loadedFromSave = false;
-            activeEncounterID = -1;
-            currentSceneIndex = TEX_ENTRANCE;
-            savedPlayerSceneIndex = TEX_ENTRANCE;
-            battleWon.clear(); // forget all won battles
-            collectedItems.clear(); // forget all collected items
-            // Clean up existing entities if any (delete old characters)
-            if (entities)
+            for (int slot = 0; slot < SAVE_SLOT_COUNT; ++slot)
             {
-                for (int i = 0; i < 2; ++i)
+                const SlotInfo& info = saveListing.slots[slot];
+                const Rectangle row = ScreenRects[R_MENU_SLOT_FIRST + slot];
+                int prevStateSlot = GuiGetState();
+                if (!info.used) GuiDisable(); // nothing to load in an empty slot
+                if (GuiButton(row, "") && LoadSaveSlot(slot))
                 {
-                    if (entities[i])
-                    {
-                       delete entities[i];
-                        entities[i] = nullptr;
-                    }
-                    
+                    loadedFromSave = true;
+                    GuiSetState(prevStateSlot);
+                    requestScreen(ScreenState::GAMEPLAY); // jump straight to gameplay (the list stays up while it fades)
+                    break;
                 }
+                GuiSetState(prevStateSlot);
+
+                const float textX = row.x + SAVE_THUMB_WIDTH * SLOT_THUMB_SCALE + 40.0f;
+                if (!info.used)
+                {
+                    DrawText(TextFormat("Slot %d - Empty", slot + 1), (int)textX, (int)row.y + 55, 40, GRAY);
+                    continue;
+                }
+                DrawTextureEx(ScreenTextures[2 + slot], {row.x + 20.0f, row.y + (SLOT_ROW_HEIGHT - SAVE_THUMB_HEIGHT * SLOT_THUMB_SCALE) * 0.5f}, 0.0f, SLOT_THUMB_SCALE, WHITE);
+
+                char savedAt[32] = "";
+                std::time_t when = (std::time_t)info.savedAt;
+                if (const std::tm* local = std::localtime(&when)) std::strftime(savedAt, sizeof(savedAt), "%Y-%m-%d %H:%M", local);
+                const unsigned played = info.playtimeSeconds;
+                DrawText(TextFormat("Slot %d - %s the %s", slot + 1, info.name, archetypeInfo((Archetype)info.archetype).className),
+                         (int)textX, (int)row.y + 20, 36, WHITE);
+                DrawText(TextFormat("%s   HP %d/%d", info.sceneName, (int)info.health, (int)info.maxHealth), (int)textX, (int)row.y + 65, 28, LIGHTGRAY);
+                DrawText(TextFormat("Played %u:%02u:%02u   Saved %s", played / 3600, played / 60 % 60, played % 60, savedAt),
+                         (int)textX, (int)row.y + 100, 28, LIGHTGRAY);
             }
+            if (GuiButton(ScreenRects[R_MENU_SLOT_BACK], "BACK")) loadMenuOpen = false;
+            break;
+        }
+
+        // Every slot is used: the new game would go over the save played longest ago, the player has to say so first
+        // (the first autosave would replace that save for good)
+        int newGameSlot = -1;
+        if (overwriteSlot >= 0)
+        {
+            const SlotInfo& info = saveListing.slots[overwriteSlot];
+            const int choice = GuiMessageBox(ScreenRects[R_MENU_OVERWRITE], "Every save slot is used",
+                TextFormat("Start the new game in Slot %d?\n%s the %s will be lost.", overwriteSlot + 1, info.name,
+                           archetypeInfo((Archetype)info.archetype).className),
+                "OVERWRITE;CANCEL");
+            if (choice == 1) newGameSlot = overwriteSlot;
+            if (choice >= 0) overwriteSlot = -1; // answered (0 = closed with the X)
+            if (newGameSlot < 0) break; // the other buttons wait until the box is answered
+        }
+        // START/RESTART button - if theres a save it says RESTART instead
+        else if (GuiButton(ScreenRects[0], !hasSaves ? "START" : "RESTART"))
+        {
+            // New game goes to the first free slot, only over the one saved longest ago once the player agreed
+            const int slot = pickNewGameSlot(saveListing);
+            if (saveListing.slots[slot].used) overwriteSlot = slot;
+            else newGameSlot = slot;
+        }
+
+        if (newGameSlot >= 0)
+        {
+            requestScreen(ScreenState::CHARACTER_SELECT);
+            saveService.selectSlot(newGameSlot);
+            currentSlotInfo = SlotInfo{};
+            playtimeSeconds = 0.0f;
+            thumbnailStale = true;
+            worldHistory.clear();
+            visitedRooms.clear();
+            hasQuickSave = false;
+            // Reset all game state for new game (fresh start)
+            loadedFromSave = false;
+            activeEncounterID = -1;
+            currentSceneIndex = SCENE_START_ID;
+            savedPlayerSceneIndex = SCENE_START_ID;
+            battleWon.clear(); // forget all won battles
+            collectedItems.reset(); // forget all collected items
+            // Clean up existing entities if any (new session, old characters go back to the pool)
+            CleanupEntities();
         }
         
         // EXIT button - closes the whole game
@@ -1151,15 +1784,16 @@ void ScreenManager::render() {
         {
             exitScreen(currentScreen);
             loadedFromSave = false;
+            ReleaseScreenResources(); // unload while the window is still there
             CloseWindow(); // goodbye
         }
         
-        // RELOAD SAVED GAME button - only works if theres actually a save
+        // RELOAD SAVED GAME button - only works if theres actually a save, opens the slot list
         int prevStateMM = GuiGetState();
-        if (!loadedFromSave) GuiDisable(); // gray it out if no save exists
+        if (!hasSaves) GuiDisable(); // gray it out if no save exists
         if(GuiButton(ScreenRects[1], "RELOAD SAVED GAME"))
         {
-            changeScreen(ScreenState::GAMEPLAY); // jump straight to gameplay
+            loadMenuOpen = true;
         }
         GuiSetState(prevStateMM); // restore button state
         break;
@@ -1192,7 +1826,7 @@ void ScreenManager::render() {
             if (i == 0 && GuiButton(characterCards[i].currentAnimationPos, ""))
             {
                 CharSelectionStuff[0] = (CharSelectionStuff[0] == i) ? -1 : i; // Toggle selection (click again to deselect)
-                PlaySound(gameSounds[SND_SELECT]); // click noise
+                PlaySound(*gameSounds[SND_SELECT]); // click noise
             }
 
             // Draw fancy yellow selection highlight around selected card
@@ -1232,15 +1866,16 @@ void ScreenManager::render() {
 
             // only show stats for Student cause thats all we have data for
             if (CharSelectionStuff[1] == 0) {
-                DrawText(TextFormat("Health: %d", getStatForCharacterID(allStatLines, "Student", CSVStats::MAX_HEALTH)),
+                const StatRow &studentStats = startingStats.row("Student"); // one lookup, no parsing
+                DrawText(TextFormat("Health: %d", studentStats.get(CSVStats::MAX_HEALTH)),
                         (int)(ScreenRects[R_INFO_BOX].x + 20), (int)(ScreenRects[R_INFO_BOX].y + 50), 20, WHITE);
-                DrawText(TextFormat("Armor: %d", getStatForCharacterID(allStatLines, "Student", CSVStats::ARMOR)),
+                DrawText(TextFormat("Armor: %d", studentStats.get(CSVStats::ARMOR)),
                         (int)(ScreenRects[R_INFO_BOX].x + 20), (int)(ScreenRects[R_INFO_BOX].y + 80), 20, WHITE);
-                DrawText(TextFormat("Dexterity: %d", getStatForCharacterID(allStatLines, "Student", CSVStats::DEX)),
+                DrawText(TextFormat("Dexterity: %d", studentStats.get(CSVStats::DEX)),
                         (int)(ScreenRects[R_INFO_BOX].x + 20), (int)(ScreenRects[R_INFO_BOX].y + 110), 20, WHITE);
-                DrawText(TextFormat("Constitution: %d", getStatForCharacterID(allStatLines, "Student", CSVStats::CON)),
+                DrawText(TextFormat("Constitution: %d", studentStats.get(CSVStats::CON)),
                         (int)(ScreenRects[R_INFO_BOX].x + 20), (int)(ScreenRects[R_INFO_BOX].y + 140), 20, WHITE);
-                DrawText(TextFormat("Initiative: %d", getStatForCharacterID(allStatLines, "Student", CSVStats::INITIATIVE)),
+                DrawText(TextFormat("Initiative: %d", studentStats.get(CSVStats::INITIATIVE)),
                         (int)(ScreenRects[R_INFO_BOX].x + 20), (int)(ScreenRects[R_INFO_BOX].y + 170), 20, WHITE);
             } else {
                 // other characters just say not available cause we didnt implement them
@@ -1254,16 +1889,14 @@ void ScreenManager::render() {
 
         if (GuiButton(ScreenRects[R_PLAY_BTN], "Play Game") && CharSelectionStuff[0] != -1) {
             // Create the player entity with the selected character type
-            entities = new Character*[2]{nullptr, nullptr};
-            CreateCharacter(entities, allStatLines, "Student", "Steve"); // player is named Steve
+            CreateCharacter(entityPool, entities, startingStats, "Student", "Steve"); // player is named Steve
             // Setup the intro crawl text
-            scrollIntroCrawl = new std::stringstream();
-            getIntroCrawlText(scrollIntroCrawl, CharSelectionStuff[0]);
+            scrollIntroCrawl = std::make_unique<std::stringstream>();
+            introCrawlCharacter = CharSelectionStuff[0];
+            getIntroCrawlText(scrollIntroCrawl.get(), introCrawlCharacter);
             introCrawlYPos = INTRO_CRAWL_START_Y; // start text at the bottom of screen
 
-            EndTextureMode(); // gotta end this before changing screens
-            changeScreen(ScreenState::INTRO_CRAWL); // go to the star wars text
-            return; // bail out of this function
+            requestScreen(ScreenState::INTRO_CRAWL); // go to the star wars text
         }
         GuiSetState(prevState); // restore button state
         break;
@@ -1289,19 +1922,22 @@ void ScreenManager::render() {
 
     case ScreenState::GAMEPLAY:
         // gameplay handles its own rendering through the game manager
-        gameManager->update(GetFrameTime()); // also update while were at it
+        if (!fadingOut) gameManager->update(GetFrameTime()); // also update while were at it
         gameManager->render(); // let the game manager do the drawing
-        // Check if we need to go back to main menu
+        // Check if we need to go back to main menu (the game manager goes when the screen is exited)
         if (gameManager->backToMainMenu) {
             gameManager->backToMainMenu = false;
-            delete gameManager;
-            gameManager = nullptr;
-            changeScreen(ScreenState::MAIN_MENU);
+            requestScreen(ScreenState::MAIN_MENU);
         }
         break;
     }
 
     EndTextureMode(); // done rendering to texture
+    if (fadingOut) GuiUnlock();
+
+    // Room changed: shrink this frame into the save slot thumbnail (exploration only, no combat or pause menu on it)
+    if (thumbnailStale && currentScreen == ScreenState::GAMEPLAY && gameManager && gameManager->getCurrentGameState() == GameState::EXPLORATION)
+        CaptureSaveThumbnail(target);
 
     // Now draw the render texture scaled to fit the actual window
     BeginDrawing();
@@ -1310,8 +1946,15 @@ void ScreenManager::render() {
                    {0.0f, 0.0f, (float)target.texture.width, -(float)target.texture.height}, // negative height cause render textures are upside down
                    {offset.x, offset.y, (float)GAME_SCREEN_WIDTH * scale, (float)GAME_SCREEN_HEIGHT * scale},
                    {0.0f, 0.0f}, 0.0f, WHITE);
+    // the transition fade goes over the whole window (not into the render texture, the save thumbnail is taken from that)
+    if (transition.fade > 0.0f) DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, transition.fade));
+    if (memoryOverlay) {
+        memDrawOverlay(16, 16, 20); // window space, stays readable at any window size
+        DrawFrameAllocations(16, GetScreenHeight() - 36, 20);
+    }
     SetMouseOffset(0, 0);
     SetMouseScale(1.0f, 1.0f);
+    WatchFrameAllocations(currentScreen); // before EndDrawing, that already polls the next frame's input
     EndDrawing();
 }
 
@@ -1325,75 +1968,84 @@ void ScreenManager::render() {
 void ScreenManager::enterScreen(ScreenState s) {
     switch (s) {
     case ScreenState::MAIN_MENU: {
+        UseMemoryOwner(MemOwner::MainMenu); // whatever loads from here on is the menu's
         startMenuStyles(); // set up the menu button styles
 
         
-        // Load menu textures (just 2: background and title)
-        numScreenTextures = 2;
-        ScreenTextures = new Texture2D[numScreenTextures];
-        ScreenTextures[0] = LoadTexture("../assets/images/UI/startMenuBg.png"); // cool background
-        ScreenTextures[1] = LoadTexture("../assets/images/UI/gameTitle.png"); // game logo
-
-        // Setup where the menu buttons go
-        numScreenRects = 3;
-        ScreenRects = new Rectangle[numScreenRects];
-        ScreenRects[0] = {CENTERED_X(MAIN_BUTTON_WIDTH), SCREEN_CENTER_Y + MAIN_BUTTON_OFFSET_Y, MAIN_BUTTON_WIDTH, MAIN_BUTTON_HEIGHT}; // start button
-        ScreenRects[1] = {CENTERED_X(MAIN_BUTTON_WIDTH), SCREEN_CENTER_Y + MAIN_BUTTON_OFFSET_Y + MAIN_BUTTON_SPACING, MAIN_BUTTON_WIDTH, MAIN_BUTTON_HEIGHT}; // load button
-        ScreenRects[2] = {CENTERED_X(MAIN_BUTTON_WIDTH), SCREEN_CENTER_Y + MAIN_BUTTON_OFFSET_Y + 2 * MAIN_BUTTON_SPACING, MAIN_BUTTON_WIDTH, MAIN_BUTTON_HEIGHT}; // exit button
-        
-        // Load character stats from CSV and try to load any saved game
-        allStatLines = storeAllStatLines(openStartingStatsCSV());
-        loadedFromSave = LoadProgress(entities, allStatLines, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems);
-
-        if (!musicLoaded) 
-        {
-            backgroundMusic = LoadMusicStream("../assets/sfx/gamePlayMusic.mp3");
-            backgroundMusic.looping = true;
-            musicLoaded = true; // Set flag to true so we don't load it again
+        // The load menu only needs the slot index (includes saves that are still being written)
+        saveListing = saveService.listing();
+        loadMenuOpen = false;
+        overwriteSlot = -1;
+
+        // Load menu textures (background, title, then one thumbnail per slot - empty slots get none)
+        // a thumbnail is keyed by its slot's save generation, so it is only uploaded again after that slot was saved
+        Image thumbs[SAVE_SLOT_COUNT];
+        std::vector<TextureSet::Source> textures = MenuTextureSources();
+        for (int slot = 0; slot < SAVE_SLOT_COUNT; ++slot) {
+            const SlotInfo& info = saveListing.slots[slot];
+            if (!info.used) { textures.push_back({}); continue; }
+            thumbs[slot] = {(void*)info.thumbnail, SAVE_THUMB_WIDTH, SAVE_THUMB_HEIGHT, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8}; // points into saveListing, nothing to unload
+            textures.push_back({TextFormat("thumbnail:%d:%u", slot, info.generation), &thumbs[slot]});
         }
+        UseScreenTextures("Main menu", textures);
 
-        if (!IsMusicStreamPlaying(backgroundMusic)) 
-        {
-            PlayMusicStream(backgroundMusic);
+        // Setup where the menu buttons go (start, load, exit, then the load menu rows and its back button)
+        UseScreenLayout(MENU_LAYOUT);
+        
+        // Stats are built in, just check once for a balancing override CSV
+        static bool statOverrideChecked = false;
+        if (!statOverrideChecked) {
+            startingStats.loadOverride(STATS_OVERRIDE_PATH);
+            statOverrideChecked = true;
         }
+
+        if (!backgroundMusic) 
+            UseBackgroundMusic("../assets/sfx/gamePlayMusic.mp3"); // loaded once, keeps playing into the game
+        else if (!IsMusicStreamPlaying(*backgroundMusic)) 
+            PlayMusicStream(*backgroundMusic);
         break;
     }
 
     case ScreenState::CHARACTER_SELECT: {
+        UseMemoryOwner(MemOwner::CharacterSelect);
         playerSelectStyles(); // green button theme
         
-        // Allocate space for the character cards
-        characterCards = new charCard[MAX_CHAR_CARDS];
+        // Fresh character cards (positions get set up in update())
+        characterCards = {};
 
         // CharSelectionStuff array: [0]=which is selected, [1]=which is hovered, [2]=initialized yet?
-        CharSelectionStuff = new int[3]{-1, -1, 0}; // start with nothing selected
+        CharSelectionStuff[0] = -1; // start with nothing selected
+        CharSelectionStuff[1] = -1;
+        CharSelectionStuff[2] = 0;
 
-        // Load textures (background + 4 character portraits)
-        numScreenTextures = 5;
-        ScreenTextures = new Texture2D[numScreenTextures];
-        ScreenTextures[0] = LoadTexture("../assets/images/UI/startMenuBg.png"); // same background as menu
-        ScreenTextures[1] = LoadTexture("../assets/images/characters/pc/Student-Fighter/rotations/south.png"); // student facing forward
-        ScreenTextures[2] = LoadTexture("../assets/images/characters/pc/Rat-Assassin/rotations/south.png"); // rat (not playable yet)
-        ScreenTextures[3] = LoadTexture("../assets/images/characters/pc/Professor-Mage/rotations/south.png"); // professor (not playable)
-        ScreenTextures[4] = LoadTexture("../assets/images/characters/pc/Attila-Brawler/rotations/south.png"); // attila (also not playable)
+        // Textures (background + 4 character portraits), the background is the menu's so it stays loaded
+        UseScreenTextures("Character select", CharacterSelectTextureSources());
 
         // rectangles will be set up in update()
-        numScreenRects = 5;
-        ScreenRects = new Rectangle[numScreenRects]{};
+        UseScreenRects(5);
         break;
     }
 
     case ScreenState::INTRO_CRAWL:
-        // nothing special to load, text was set up in character select
+        // nothing to load, text was set up in character select (the textures of character select go)
+        UseMemoryOwner(MemOwner::IntroCrawl);
+        UseScreenTextures("Intro crawl", {});
+        UseScreenRects(0);
         break;
 
     case ScreenState::GAMEPLAY: {
         gamePlayStyles(); // load the nerd font and set styles
         
         // only setup gameplay if we have a player character
-        if(entities && entities[0])
+        if(entities[0])
         { 
-            InitGameScenes(entities[0]); // build the whole game world
+            // the building the player is in gets loaded here (once, sceneLibrary keeps it), its textures when exploration starts
+            ChangeDirectory(GetApplicationDirectory());
+            if (!sceneLibrary.scene(currentSceneIndex)) {
+                TraceLog(LOG_WARNING, "Scene %d does not exist (%s), starting at the entrance.", currentSceneIndex, sceneLibrary.error().c_str());
+                currentSceneIndex = savedPlayerSceneIndex = SCENE_START_ID;
+                activeEncounterID = -1;
+            }
             if (loadedFromSave) 
             {
                 TraceLog(LOG_INFO, "Loading saved game state."); // debug message
@@ -1420,29 +2072,22 @@ void ScreenManager::enterScreen(ScreenState s) {
  */
 void ScreenManager::exitScreen(ScreenState s) {
     switch (s) {
+    // Textures and rects stay until the next screen declares its own (only the difference gets loaded)
     case ScreenState::MAIN_MENU:
     case ScreenState::CHARACTER_SELECT:
-    case ScreenState::INTRO_CRAWL: {
-        // Clean up intro crawl text if were leaving that screen
-        if (scrollIntroCrawl && s == ScreenState::INTRO_CRAWL) {
-            CleanupIntroCrawl();
-        }
-    }
-    // NOTE: no break here, we fall through to cleanup textures etc for all screens
+        break;
+
+    case ScreenState::INTRO_CRAWL:
+        scrollIntroCrawl.reset(); // the text is only needed while it scrolls
+        break;
+
     case ScreenState::GAMEPLAY: {
         // Clean up game manager if leaving gameplay
-        if (s == ScreenState::GAMEPLAY && gameManager) {
+        if (gameManager) {
             gameManager->exitGameState(gameManager->getCurrentGameState());
             delete gameManager;
             gameManager = nullptr;
         }
-
-        // Clean up all the screen-specific resources
-        CleanupScreenTextures();
-        CleanupScreenRects();
-        CleanupCharacterCards();
-        CleanupCharSelectionStuff();
-        //CleanupStatLines(); // Keep stat lines cause we might need them for save/load
         break;
     }
     }
@@ -1467,6 +2112,7 @@ void ScreenManager::exitScreen(ScreenState s) {
 GameManager::GameManager(GameState initial) : currentGameState(initial), nextGameState(initial), prevGameState(initial) 
 {
     ChangeDirectory(GetApplicationDirectory()); // MacOS file path stuff
+    sceneLibrary.setLoadHook(ApplySceneLayout); // every building gets the shipped layout before anyone looks at it
 }
 
 /**
@@ -1496,6 +2142,21 @@ void GameManager::changeGameState(GameState newState)
     enterGameState(currentGameState); // setup new state
 }
 
+/**
+ * @brief Changes game states behind a fade (exploration into a fight and back). The fight's textures are decoded in the background
+ *        while the room fades out, and walking in on a zombie plays its groan as the stinger. The pause menu does not use this.
+ * @param newState The GameState to transition to.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void GameManager::requestGameState(GameState newState)
+{
+    if (newState == currentGameState) return;
+    if (BeginTransition(GameStateTextureSources(newState), true, ScreenState::GAMEPLAY, newState) && newState == GameState::COMBAT)
+        PlaySound(*gameSounds[SND_ZOM_GROAN]);
+}
+
 /**
  * @brief Returns the current game state. Simple getter.
  * @return GameState The current game state enum value.
@@ -1506,6 +2167,52 @@ GameState GameManager::getCurrentGameState() const {
     return currentGameState;
 }
 
+/**
+ * @brief Heap the current fight holds (the combat handler with its journal buffer, and the log lines). Memory ledger gauge.
+ * @return std::size_t Bytes, 0 outside of combat.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::size_t GameManager::heapBytes() const {
+    if (!combatHandler) return 0;
+    std::size_t bytes = sizeof(CombatHandler) + combatHandler->log.capacity() * sizeof(std::string);
+    for (const std::string& line : combatHandler->log) bytes += line.capacity();
+    return bytes;
+}
+
+/**
+ * @brief Whether the game is sitting in a state whose frames must not allocate: exploring a room, or the player's turn
+ *        of a fight that is still going (the enemy's turn searches a move, the end of a fight writes the journal).
+ * @return bool true for exploration and the player's turn.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool GameManager::isSteadyState() const {
+    if (currentGameState == GameState::EXPLORATION) return sceneTransitionTimer <= 0.0f;
+    return currentGameState == GameState::COMBAT && combatHandler && combatHandler->playerTurn &&
+           !combatHandler->gameOverState && !combatHandler->victoryState;
+}
+
+/**
+ * @brief A number that changes whenever something the frames draw changes: game state, room, fast travel map, whose turn,
+ *        combat log length, menus. Frames after a change may allocate once (a new log line, a new room), the allocation
+ *        check waits until the stamp holds still.
+ * @return std::uint64_t The stamp (only compared, the value means nothing).
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+std::uint64_t GameManager::stateStamp() const {
+    std::uint64_t stamp = (std::uint64_t)currentGameState;
+    stamp = stamp * 31 + (std::uint64_t)currentSceneIndex;
+    stamp = stamp * 31 + (fastTravelOpen ? 1 : 0);
+    if (combatHandler) {
+        stamp = stamp * 31 + (combatHandler->playerTurn ? 1 : 0);
+        stamp = stamp * 31 + (combatHandler->showAttackMenu ? 1 : 0) + (combatHandler->showItemMenu ? 2 : 0);
+        stamp = stamp * 31 + combatHandler->log.size();
+    }
+    return stamp;
+}
+
 /**
  * @brief Handles entering a new game state by loading resources and setting up the state. Different states need different stuff - exploration needs room textures, combat needs enemy sprites and health bars and stuff.
  * @param state The GameState being entered.
@@ -1523,106 +2230,31 @@ void GameManager::enterGameState(GameState state) {
 
     switch (state) {
     case GameState::EXPLORATION: {
-        // Clean up any leftover resources from before
-        CleanupScreenTextures();
-        CleanupScreenRects();
-        
-        // Initialize all the game scenes (rooms and stuff)
-        if (entities && entities[0]) {
+        UseMemoryOwner(MemOwner::Exploration);
+        // Load the textures of the building were in (the rooms themselves are already loaded, textures
+        // the state before also had stay loaded)
+        if (entities[0]) {
             InitGameScenes(entities[0]);
         }
 
-        // Setup all the rectangles we need for exploration UI
-        numScreenRects = 25; // we use alot of rectangles
-        ScreenRects = new Rectangle[numScreenRects];
-        // Pause button goes in the top-right corner
-        ScreenRects[R_EXP_PAUSE_BTN] = {(float)GAME_SCREEN_WIDTH - 75 - 10, 50, 75, 75};
-        // Pause menu overlay (dark transparent background)
-        ScreenRects[R_EXP_PAUSE_BG_OVERLAY] = {0, 0, (float)GAME_SCREEN_WIDTH, (float)GAME_SCREEN_HEIGHT};
-        // Pause menu panel
-        ScreenRects[R_EXP_PAUSE_PANEL] = {PAUSE_PANEL_X, PAUSE_PANEL_Y, PAUSE_PANEL_WIDTH, PAUSE_PANEL_HEIGHT};
-        ScreenRects[R_EXP_BTN_RESUME] = {PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f, PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT};
-        ScreenRects[R_EXP_BTN_SAVE_EXIT] = {PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f + PAUSE_BTN_HEIGHT + PAUSE_BTN_SPACING, PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT};
-        ScreenRects[R_EXP_BTN_QUIT_NO_SAVE] = {PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f + 2 * (PAUSE_BTN_HEIGHT + PAUSE_BTN_SPACING), PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT};
+        // Pause button and pause menu
+        UseScreenLayout(EXPLORATION_LAYOUT);
     
         sceneTransitionTimer = 0.5f; // little delay before you can click again after changing rooms
+        recordWorldSnapshot(); // first room (new game, load, or back from a fight)
         break;
     }
 
     case GameState::COMBAT: {
         // Combat needs alot of setup cause theres alot going on
-        
-        // Clean up first
-        CleanupScreenTextures();
-        CleanupScreenRects();
-        UnloadMusicStream(backgroundMusic); // stop exploration music
-        musicLoaded = false; // Reset flag so we can load new music
-        
-        
-        // Make sure we have the stat lines loaded for creating enemies
-        if (!allStatLines) {
-            TraceLog(LOG_INFO, "Reloading stat lines for combat");
-            allStatLines = storeAllStatLines(openStartingStatsCSV());
-        }
-
-        // Make sure we have somewhere to put our entities
-        if (!entities) {
-            TraceLog(LOG_INFO, "Allocating entities array for combat");
-            entities = new Character*[2]{nullptr, nullptr};
-        }
+        UseMemoryOwner(MemOwner::Combat);
 
-        // Load the combat textures (background, player sprite, enemy sprite)
-        numScreenTextures = 3;
-        ScreenTextures = new Texture2D[numScreenTextures];
-        ScreenTextures[0] = LoadTexture(gameScenes[currentSceneIndex].environmentTexture.c_str()); // room background
-        ScreenTextures[1] = LoadTexture("../assets/images/characters/pc/Student-Fighter/rotations/north-west.png"); // player fighting pose
-        
-        // Load the right enemy texture based on which encounter this is
-        switch (activeEncounterID) 
-        {
-            case 0:
-                ScreenTextures[2] = LoadTexture("../assets/images/characters/npc/Enemies/Professor1.png"); // zombie professor
-                break;
-            case 1:
-                ScreenTextures[2] = LoadTexture("../assets/images/characters/npc/Enemies/Sorority1.png"); // zombie sorority girl
-                break;
-            case 2:
-            default:
-                ScreenTextures[2] = LoadTexture("../assets/images/characters/npc/Enemies/FratBro1.png"); // zombie frat bro
-                break;
-        }
+        // The combat textures (background, player sprite, enemy sprite) replace the exploration ones
+        UseScreenTextures("Combat", CombatTextureSources());
         TraceLog(LOG_INFO, "Combat screen textures loaded.");
 
-        // Setup ALL the combat UI rectangles (theres alot)
-        numScreenRects = 25;
-        ScreenRects = new Rectangle[numScreenRects];
-        ScreenRects[R_PLAYER_NAME] = {0, 0, 450, 50}; // player name bar at top left
-        ScreenRects[R_ENEMY_NAME] = {(float)GAME_SCREEN_WIDTH - 450, 0, 450, 50}; // enemy name bar at top right
-        ScreenRects[R_PLAYER_PANEL] = {0, 50, 450, 832}; // big panel for player info
-        ScreenRects[R_ENEMY_PANEL] = {(float)GAME_SCREEN_WIDTH - 450, 50, 450, 832}; // big panel for enemy info
-        ScreenRects[R_PLAYER_HP_BG] = {20, 150, 410, 30}; // health bar background
-        ScreenRects[R_PLAYER_HP_FG] = {20, 150, 410, 30}; // health bar foreground (shrinks when hurt)
-        ScreenRects[R_ENEMY_HP_BG] = {(float)GAME_SCREEN_WIDTH - 430, 150, 410, 30};
-        ScreenRects[R_ENEMY_HP_FG] = {(float)GAME_SCREEN_WIDTH - 430, 150, 410, 30};
-        ScreenRects[R_PLAYER_STATUS] = {20, 250, 410, 500}; // status effects panel
-        ScreenRects[R_ENEMY_STATUS] = {(float)GAME_SCREEN_WIDTH - 430, 250, 410, 500};
-        ScreenRects[R_BOTTOM_PANEL] = {0, (float)GAME_SCREEN_HEIGHT - 200, (float)GAME_SCREEN_WIDTH, 215}; // action buttons panel
-        ScreenRects[R_BTN_ATTACK] = {20, (float)GAME_SCREEN_HEIGHT - 180, 400, 80}; // ATTACK button
-        ScreenRects[R_BTN_DEFEND] = {20, (float)GAME_SCREEN_HEIGHT - 80, 400, 80}; // DEFEND button
-        ScreenRects[R_BTN_USE_ITEM] = {570, (float)GAME_SCREEN_HEIGHT - 180, 400, 80}; // USE ITEM button
-        ScreenRects[R_LOG_BOX] = {(float)GAME_SCREEN_WIDTH - 800, (float)GAME_SCREEN_HEIGHT - 180, 780, 175}; // combat log
-        // popup menus start empty, we set them when needed
-        ScreenRects[R_ATTACK_MENU] = {0};
-        ScreenRects[R_MELEE_BTN] = {0};
-        ScreenRects[R_RANGED_BTN] = {0};
-        ScreenRects[R_ITEM_MENU] = {0};
-        // pause button
-        ScreenRects[R_PAUSE_BTN] = {(float)GAME_SCREEN_WIDTH - 450 - 75 - 10, 50 - 37.5f, 75, 75};
-        ScreenRects[R_PAUSE_BG_OVERLAY] = {0, 0, (float)GAME_SCREEN_WIDTH, (float)GAME_SCREEN_HEIGHT};
-        ScreenRects[R_PAUSE_PANEL] = {PAUSE_PANEL_X, PAUSE_PANEL_Y, PAUSE_PANEL_WIDTH, PAUSE_PANEL_HEIGHT};
-        ScreenRects[R_BTN_RESUME] = {PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f, PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT};
-        ScreenRects[R_BTN_SAVE_EXIT] = {PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f + PAUSE_BTN_HEIGHT + PAUSE_BTN_SPACING, PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT};
-        ScreenRects[R_BTN_QUIT_NO_SAVE] = {PAUSE_BTN_X, PAUSE_PANEL_Y + 60.0f + 2 * (PAUSE_BTN_HEIGHT + PAUSE_BTN_SPACING), PAUSE_BTN_WIDTH, PAUSE_BTN_HEIGHT};
+        // All the combat UI rectangles (theres alot, popup menus start empty and get placed when they open)
+        UseScreenLayout(COMBAT_LAYOUT);
         TraceLog(LOG_INFO, "Combat screen rectangles initialized.");
 
         // Debug logging to help figure out whats going on
@@ -1635,37 +2267,13 @@ void GameManager::enterGameState(GameState state) {
         
         // Create the enemy based on which encounter this is
         // (unless we loaded from save, then the enemy already exists)
-        if (activeEncounterID == 0 && !loadedFromSave) 
+        // the stats come from the room's enemy (the building file, or the layout seed), the name and sprite from the encounter
+        if (!loadedFromSave)
         {
-            // encounter 0 = professor zombie
-            if (entities && entities[1]) { delete entities[1]; entities[1] = nullptr; } // delete old enemy if any
-            if (allStatLines) {
-                CreateCharacter(entities, allStatLines, "Zombie_Prof", "Professor");
-                TraceLog(LOG_INFO, "Created enemy: Professor");
-            } else {
-                TraceLog(LOG_ERROR, "Cannot create enemy: allStatLines is null");
-            }
-        } else if (activeEncounterID == 1 && !loadedFromSave) 
-        {
-            // encounter 1 = sorority zombie
-            if (entities && entities[1]) { delete entities[1]; entities[1] = nullptr; }
-            if (allStatLines) {
-                CreateCharacter(entities, allStatLines, "Zombie_Standard", "Sorority");
-                TraceLog(LOG_INFO, "Created enemy: Sorority");
-            } else {
-                TraceLog(LOG_ERROR, "Cannot create enemy: allStatLines is null");
-            }
-        } 
-        else if (!loadedFromSave)
-        {
-            // encounter 2 (or anything else) = frat bro zombie
-            if (entities && entities[1]) { delete entities[1]; entities[1] = nullptr; }
-            if (allStatLines) {
-                CreateCharacter(entities, allStatLines, "Zombie_Standard", "Frat Bro");
-                TraceLog(LOG_INFO, "Created enemy: Frat Bro");
-            } else {
-                TraceLog(LOG_ERROR, "Cannot create enemy: allStatLines is null");
-            }
+            // (CreateCharacter despawns any old enemy still in slot 1)
+            const EncounterEnemy enemy = encounterEnemy(CurrentScene(), activeEncounterID);
+            CreateCharacter(entityPool, entities, startingStats, enemy.statID, enemy.name);
+            TraceLog(LOG_INFO, "Created enemy: %s (%s)", enemy.name, enemy.statID);
         } else 
         {
             // Enemy was loaded from save file so we dont need to create one
@@ -1674,7 +2282,7 @@ void GameManager::enterGameState(GameState state) {
         }
         
         // Make sure enemy actually got created
-        if (!entities || !entities[1]) {
+        if (!entities[1]) {
             TraceLog(LOG_ERROR, "Enemy creation failed; aborting COMBAT setup");
             // Fall back to exploration cause we cant fight nothing
             nextGameState = GameState::EXPLORATION;
@@ -1711,19 +2319,21 @@ void GameManager::enterGameState(GameState state) {
         combatHandler->log.clear(); // clear combat log
         combatHandler->logScrollOffset = 0.0f;
         AddNewLogEntry(combatHandler->log, "A wild " + entities[1]->getName() + " appears!");
-        combatHandler->enemyActionDelay = 1.0f; // enemy waits a sec before attacking (so player can see whats happening)
 
-        // Load and start playing combat music
-        if (!musicLoaded) 
-        {
-            backgroundMusic = LoadMusicStream("../assets/sfx/battleMusicLoop.mp3");
-            backgroundMusic.looping = true;
-            musicLoaded = true; // Set flag to true so we don't load it again
-        }
-        if (!IsMusicStreamPlaying(backgroundMusic)) 
+        // Every fight gets its own seed so it can be replayed from its journal later
         {
-            PlayMusicStream(backgroundMusic);
+            std::uint32_t fightSeed = new_rng_seed();
+            seed_rng(fightSeed);
+            combatHandler->journal.begin(fightSeed, *entities[0], *entities[1]);
         }
+        combatHandler->enemyActionDelay = 1.0f; // enemy waits a sec before attacking (so player can see whats happening)
+        if (combatHandler->playerTurn) recordWorldSnapshot(); // first player turn (otherwise after the enemy moved)
+        // autosave here and not when walking in: the fight starts after the fade, before that there is no enemy
+        // to save and a save with the encounter but no enemy would load as a 0 HP zombie (a skipped fight)
+        AutosaveProgress();
+
+        // Load and start playing combat music (the exploration music is unloaded)
+        UseBackgroundMusic("../assets/sfx/battleMusicLoop.mp3");
         break;
     }
 
@@ -1743,33 +2353,27 @@ void GameManager::enterGameState(GameState state) {
 void GameManager::exitGameState(GameState state) {
     switch (state) {
     case GameState::EXPLORATION:
-        // Clean up exploration textures when leaving (but not if just pausing)
-        if (nextGameState != GameState::PAUSE_MENU) {
-            CleanupScreenTextures();
-            CleanupScreenRects();
-        }
+        // Nothing to clean up, the next state declares its textures and whatever it does not need gets unloaded then
         break;
 
     case GameState::COMBAT:
         if (nextGameState != GameState::PAUSE_MENU) {
 
-            UnloadMusicStream(backgroundMusic); // stop combat music
-            backgroundMusic = Music{LoadMusicStream("../assets/sfx/gamePlayMusic.mp3")}; // load exploration music
-            PlayMusicStream(backgroundMusic);
-            backgroundMusic.looping = true;
+            UseBackgroundMusic("../assets/sfx/gamePlayMusic.mp3"); // combat music goes, exploration music again
+
+            enemyPlanner.cancel(); // stop thinking about a fight thats over
+            worldHistory.dropCombat(); // turns of this fight cant be undone anymore
 
-            // Clean up combat handler
+            // Clean up combat handler (write its journal out first)
             if (combatHandler) {
+                if (!combatHandler->journal.flush())
+                    TraceLog(LOG_WARNING, "Could not write combat journal");
                 delete combatHandler;
                 combatHandler = nullptr;
             }
-            // Delete the enemy (player survives between fights)
-            if (entities[1]) {
-                delete entities[1];
-                entities[1] = nullptr;
-            }
-            CleanupScreenTextures();
-            CleanupScreenRects();
+            // Despawn the enemy (player survives between fights), its slot is reused by the next one
+            entityPool.despawn(entities[1]);
+            entities[1] = nullptr;
         }
         break;
 
@@ -1779,6 +2383,142 @@ void GameManager::exitGameState(GameState state) {
     }
 }
 
+/**
+ * @brief Takes a snapshot of the world (a memcpy sized WorldState, no JSON) and pushes it onto the rewind history.
+ *        Called at every decision point: arriving in a room, and the start of every player turn in a fight.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void GameManager::recordWorldSnapshot() {
+    if (!entities[0]) return;
+    WorldState state;
+    captureWorldState(entities, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems,
+                      currentGameState == GameState::COMBAT ? combatHandler : nullptr, state);
+    worldHistory.push(state);
+}
+
+/**
+ * @brief Puts a world snapshot back. A combat snapshot rewinds the running fight in place (HP, status effects, journal
+ *        and dice), an exploration snapshot taken before the fight leaves the fight first. The save follows along.
+ * @param state The snapshot to go back to.
+ * @return bool True if the snapshot was applied.
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+bool GameManager::restoreWorldSnapshot(const WorldState& state) {
+    if (state.inCombat && currentGameState != GameState::COMBAT) return false; // fights are only rewound from inside
+    if (!state.inCombat && currentGameState == GameState::COMBAT) {
+        activeEncounterID = -1; // the fight is abandoned, the snapshot says where the player was before it
+        changeGameState(GameState::EXPLORATION);
+    }
+    if (!applyWorldState(state, entities, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems,
+                         currentGameState == GameState::COMBAT ? combatHandler : nullptr))
+        return false;
+
+    if (state.inCombat) {
+        enemyPlanner.cancel(); // it was planning against the turn that just got undone
+    } else {
+        sceneTransitionTimer = 0.25f; // same delay as walking through a door
+        thumbnailStale = true;
+        if (currentBuilding && SCENE_BUILDING(currentSceneIndex) != currentBuilding->index)
+            InitGameScenes(entities[0]); // went back into another building, its textures are needed now
+        else
+            RefreshRoute(); // other room, maybe other keys
+    }
+    AutosaveProgress();
+    return true;
+}
+
+/**
+ * @brief Moves the player into a room (arrow click or fast travel). Another building gets loaded first, a room with a fight the
+ *        player has not won starts it, anything else is a new rewind point. Either way the progress is autosaved.
+ * @param sceneId Scene ID (SCENE_ID) of the room.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void GameManager::moveToScene(int sceneId) {
+    const int fromSceneIndex = currentSceneIndex;
+    currentSceneIndex = sceneId;
+    if (SCENE_BUILDING(currentSceneIndex) != currentBuilding->index) {
+        // into another building: it gets loaded now (first time only) and its textures replace ours
+        InitGameScenes(entities[0]);
+        if (!currentBuilding) {
+            currentSceneIndex = fromSceneIndex; // broken building file, stay where we are
+            InitGameScenes(entities[0]);
+            return;
+        }
+    }
+    thumbnailStale = true; // save slot thumbnail shows the room the player is in
+    sceneTransitionTimer = 0.25f; // short delay before can click again
+    RefreshRoute();
+
+    // if new room has an undefeated enemy, start combat
+    const GameScene* next = CurrentScene();
+    if (roomStartsFight(*next, battleWon)) {
+        savedPlayerSceneIndex = currentSceneIndex; // remember where we are for saves
+        activeEncounterID = next->encounterID;
+        requestGameState(GameState::COMBAT); // fight (once the room faded out), autosaved once the enemy exists
+    } else {
+        recordWorldSnapshot(); // rewinding comes back to this room
+        AutosaveProgress();
+    }
+}
+
+/**
+ * @brief Snapshot hotkeys. F5 quicksaves (exploration only, a fight cant be rebuilt from outside), F9 quickloads,
+ *        backspace undoes the last turn in a fight (or the turn that killed you) and walks back one room in exploration.
+ * @return void
+ * @version 1.0
+ * @author Edwin Baiden
+ */
+void GameManager::handleSnapshotKeys() {
+    if (!entities[0] || !CurrentScene() || CurrentScene()->isEnding) return; // nothing to snapshot yet, or the game is over
+
+    if (IsKeyPressed(KEY_QUICKSAVE)) {
+        if (currentGameState == GameState::EXPLORATION) {
+            captureWorldState(entities, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems, nullptr, quickSave);
+            hasQuickSave = true;
+            TraceLog(LOG_INFO, "Quicksaved");
+        } else if (combatHandler) {
+            AddNewLogEntry(combatHandler->log, "Cant quicksave during a fight.");
+            combatHandler->logScrollOffset = 1000.0f;
+        }
+    }
+
+    if (IsKeyPressed(KEY_QUICKLOAD) && hasQuickSave) {
+        const WorldState loaded = quickSave; // restore can push snapshots, keep our own copy
+        if (restoreWorldSnapshot(loaded)) {
+            worldHistory.clear(); // the history after the quicksave didnt happen
+            worldHistory.push(loaded);
+            TraceLog(LOG_INFO, "Quickloaded");
+        }
+    }
+
+    if (IsKeyPressed(KEY_REWIND)) {
+        if (currentGameState == GameState::COMBAT) {
+            // only on the player's turn, or right after dying (the fight is over once its won)
+            if (!combatHandler || combatHandler->victoryState || (!combatHandler->playerTurn && !combatHandler->gameOverState)) return;
+            WorldState previous;
+            bool undone;
+            if (combatHandler->gameOverState) {
+                // the newest snapshot is the start of the turn that killed the player, try that one again
+                undone = !worldHistory.empty() && worldHistory.back().inCombat && restoreWorldSnapshot(previous = worldHistory.back());
+            } else {
+                undone = worldHistory.rewind(true, previous) && restoreWorldSnapshot(previous);
+            }
+            if (undone) {
+                AddNewLogEntry(combatHandler->log, "Last turn undone.");
+                combatHandler->logScrollOffset = 1000.0f;
+            }
+        } else {
+            WorldState previous;
+            if (worldHistory.rewind(false, previous)) restoreWorldSnapshot(previous);
+        }
+    }
+}
+
 /**
  * @brief Renders the current game state. This is a big function cause it draws everything for exploration, combat, and pause menu. Theres alot of DrawRectangle and DrawText calls in here.
  * @return void
@@ -1789,15 +2529,16 @@ void GameManager::render() {
     switch (currentGameState) {
     case GameState::EXPLORATION: {
         // make sure we have stuff to render
-        if (gameScenes.empty() || !ScreenTextures) break;
+        const GameScene* scene = CurrentScene();
+        if (!scene || !currentBuilding || ScreenTextures.empty()) break;
 
         // Draw the current room background stretched to fill screen
-        DrawTexturePro(ScreenTextures[gameScenes[currentSceneIndex].textureIndex],
-                      {0.0f, 0.0f, (float)ScreenTextures[gameScenes[currentSceneIndex].textureIndex].width,
-                       (float)ScreenTextures[gameScenes[currentSceneIndex].textureIndex].height},
+        DrawTexturePro(ScreenTextures[scene->textureIndex],
+                      {0.0f, 0.0f, (float)ScreenTextures[scene->textureIndex].width,
+                       (float)ScreenTextures[scene->textureIndex].height},
                       {0.0f, 0.0f, (float)GAME_SCREEN_WIDTH, (float)GAME_SCREEN_HEIGHT}, {0.0f, 0.0f}, 0.0f, WHITE);
 
-        if (currentSceneIndex == TEX_OUTSIDE)
+        if (scene->isEnding)
         {
             if (endScreenPhase >= 1)
             {
@@ -1836,10 +2577,9 @@ void GameManager::render() {
                    FONT_SIZE_BTN + 20, 1.0f, GetColor(GuiGetStyle(BUTTON, TEXT_COLOR_NORMAL)));
 
         // Draw any items in this room that havent been picked up yet
-        for (const auto &item : gameScenes[currentSceneIndex].sceneItems) {
+        for (const auto &item : scene->sceneItems) {
             // only draw if: not collected yet AND (doesnt require victory OR victory achieved)
-            if (!isItemCollected(item.itemName) &&
-                (!item.requiresVictory || (gameScenes[currentSceneIndex].hasEncounter && battleWon[gameScenes[currentSceneIndex].encounterID]))) {
+            if (isItemVisible(*scene, item)) {
                 DrawTexturePro(ScreenTextures[item.textureIndex],
                               {0, 0, (float)ScreenTextures[item.textureIndex].width, (float)ScreenTextures[item.textureIndex].height},
                               item.clickArea, {0, 0}, 0.0f, WHITE);
@@ -1847,58 +2587,76 @@ void GameManager::render() {
         }
 
         // Draw the navigation arrows with a cool pulsing animation
-        for (const auto &arrow : gameScenes[currentSceneIndex].sceneArrows) {
+        for (const auto &arrow : scene->sceneArrows) {
             // skip arrows that are disabled or need a key the player doesnt have
-            if (!arrow.isEnabled || (!arrow.requiredKeyName.empty() && !isItemCollected(arrow.requiredKeyName)))
+            if (!isArrowOpen(arrow))
                 continue;
+            const bool onRoute = &arrow - scene->sceneArrows.begin() == objectiveArrow; // first step toward the objective
             // calculate pulsing size (makes them bob up and down kinda)
             float scaledWidth = arrow.clickArea.width+ arrow.clickArea.width * animation::sinPulse(0.2f, PI, animation::easeInOutCubic(fmodf(GetTime(), 1.0f)));
             float scaledHeight = arrow.clickArea.height + arrow.clickArea.height * animation::sinPulse(0.2f, PI, animation::easeInOutCubic(fmodf(GetTime(), 1.0f)));
             // draw the arrow rotated based on which direction it points
-            DrawTexturePro(ScreenTextures[TEX_ARROW],
-                          {0.0f, 0.0f, (float)ScreenTextures[TEX_ARROW].width, (float)ScreenTextures[TEX_ARROW].height},
+            DrawTexturePro(ScreenTextures[TEX_ARROW(currentBuilding)],
+                          {0.0f, 0.0f, (float)ScreenTextures[TEX_ARROW(currentBuilding)].width, (float)ScreenTextures[TEX_ARROW(currentBuilding)].height},
                           {arrow.clickArea.x + arrow.clickArea.width / 2.0f, arrow.clickArea.y + arrow.clickArea.height / 2.0f,
                            scaledWidth, scaledHeight},
                           {scaledWidth/2.0f, scaledHeight/2.0f}, // rotate around center
-                          ARROW_ROTATION(arrow.dir), WHITE);
+                          ARROW_ROTATION(arrow.dir), onRoute ? COL_ROUTE : WHITE);
         }
 
         // Draw the minimap in the corner so players dont get lost
         DrawRectangleLinesEx({MINIMAP_X, MINIMAP_Y, MINIMAP_SIZE, MINIMAP_SIZE}, MINIMAP_BORDER, BLACK);
-        DrawTexturePro(ScreenTextures[TEX_MINIMAP],
-                      {0, 0, (float)ScreenTextures[TEX_MINIMAP].width, (float)ScreenTextures[TEX_MINIMAP].height},
+        DrawTexturePro(ScreenTextures[currentBuilding->minimapTexture],
+                      {0, 0, (float)ScreenTextures[currentBuilding->minimapTexture].width, (float)ScreenTextures[currentBuilding->minimapTexture].height},
                       {MINIMAP_X, MINIMAP_Y, MINIMAP_SIZE, MINIMAP_SIZE}, {0, 0}, 0.0f, WHITE);
 
+        // Draw the way to the next objective (room to room) and a dot on the objective
+        for (std::size_t i = 1; i < objectiveRoute.size(); ++i)
+            DrawLineEx(MINIMAP_ROOM_POS(currentBuilding->scenes[objectiveRoute[i - 1]]), MINIMAP_ROOM_POS(currentBuilding->scenes[objectiveRoute[i]]),
+                       MINIMAP_ROUTE_THICKNESS, COL_ROUTE);
+        if (objectiveRoute.size() > 1)
+            DrawCircleV(MINIMAP_ROOM_POS(currentBuilding->scenes[objectiveRoute.back()]), MINIMAP_ROOM_RADIUS, COL_ROUTE);
+
+        // Fast travel: a dot on every room the player can go back to (the hovered one is bigger)
+        const int fastTravelHover = fastTravelOpen ? FastTravelRoomAt(GetMousePosition()) : -1;
+        if (fastTravelOpen)
+            for (int room = 0; room < (int)currentBuilding->scenes.size(); ++room)
+                if (CanFastTravel(room))
+                    DrawCircleV(MINIMAP_ROOM_POS(currentBuilding->scenes[room]), MINIMAP_ROOM_RADIUS * (room == fastTravelHover ? 1.5f : 1.0f), COL_FAST_TRAVEL);
+
         // Draw the player position on the minimap (its a turtle icon)
-        DrawTexturePro(ScreenTextures[TEX_TURTLE],
-                      {0, 0, (float)ScreenTextures[TEX_TURTLE].width, (float)ScreenTextures[TEX_TURTLE].height},
-                      {MINIMAP_X + gameScenes[currentSceneIndex].minimapCoords.x * MINIMAP_SIZE - 16,
-                       MINIMAP_Y + gameScenes[currentSceneIndex].minimapCoords.y * MINIMAP_SIZE - 16, 32, 32},
-                      {16, 16}, gameScenes[currentSceneIndex].minimapRotation, WHITE);
+        DrawTexturePro(ScreenTextures[TEX_TURTLE(currentBuilding)],
+                      {0, 0, (float)ScreenTextures[TEX_TURTLE(currentBuilding)].width, (float)ScreenTextures[TEX_TURTLE(currentBuilding)].height},
+                      {MINIMAP_X + scene->minimapCoords.x * MINIMAP_SIZE - 16,
+                       MINIMAP_Y + scene->minimapCoords.y * MINIMAP_SIZE - 16, 32, 32},
+                      {16, 16}, scene->minimapRotation, WHITE);
 
         // Draw the room name above the minimap
-        DrawText(gameScenes[currentSceneIndex].sceneName.c_str(), MINIMAP_X, MINIMAP_Y - 30, 30, WHITE);
+        DrawText(scene->sceneName, MINIMAP_X, MINIMAP_Y - 30, 30, WHITE);
         DrawRectangleLinesEx({MINIMAP_X, MINIMAP_Y, MINIMAP_SIZE, MINIMAP_SIZE}, MINIMAP_BORDER, BLACK);
         
         // Black bar at top for info text
         DrawRectangle(0, 0, (float)GAME_SCREEN_WIDTH, 40, BLACK);
 
         // Figure out what info text to show based on what the mouse is over
-        std::string infoText;
+        // (points at the room data or at the frame arena, nothing gets copied every frame)
+        const char* infoText = nullptr;
+        if (fastTravelOpen)
+            infoText = fastTravelHover >= 0 ? frameArena().format("Fast travel to %s", currentBuilding->scenes[fastTravelHover].sceneName)
+                                            : "Fast travel: select a room you have been to on the map.";
         // check if hovering over an item
-        for (const auto &item : gameScenes[currentSceneIndex].sceneItems) {
-            if (!isItemCollected(item.itemName) &&
-                (!item.requiresVictory || (gameScenes[currentSceneIndex].hasEncounter && battleWon[gameScenes[currentSceneIndex].encounterID])) &&
-                CheckCollisionPointRec(GetMousePosition(), item.clickArea)) {
+        if (!infoText)
+        for (const auto &item : scene->sceneItems) {
+            if (isItemVisible(*scene, item) && CheckCollisionPointRec(GetMousePosition(), item.clickArea)) {
                 infoText = item.hoverText;
                 break;
             }
         }
 
         // if not hovering an item, check arrows
-        if (infoText.empty()) {
-            for (const auto &arrow : gameScenes[currentSceneIndex].sceneArrows) {
-                if (arrow.isEnabled && (arrow.requiredKeyName.empty() || isItemCollected(arrow.requiredKeyName)) &&
+        if (!infoText) {
+            for (const auto &arrow : scene->sceneArrows) {
+                if (isArrowOpen(arrow) &&
                     CheckCollisionPointRec(GetMousePosition(), arrow.clickArea)) {
                     infoText = arrow.hoverText;
                     break;
@@ -1908,10 +2666,10 @@ void GameManager::render() {
 
         // figure out whats visible in the room for default text
         bool hasVisibleItems = false;
-        if (infoText.empty())
-            for (const auto &item : gameScenes[currentSceneIndex].sceneItems) 
+        if (!infoText)
+            for (const auto &item : scene->sceneItems) 
             {
-                if (!isItemCollected(item.itemName) && (!item.requiresVictory || (gameScenes[currentSceneIndex].hasEncounter && battleWon[gameScenes[currentSceneIndex].encounterID]))) 
+                if (isItemVisible(*scene, item)) 
                 {
                     hasVisibleItems = true;
                     break;
@@ -1919,15 +2677,15 @@ void GameManager::render() {
             }
         
         bool hasArrowsVisible = false;
-        for (const auto &arrow : gameScenes[currentSceneIndex].sceneArrows) {
-            if (arrow.isEnabled && (arrow.requiredKeyName.empty() || isItemCollected(arrow.requiredKeyName))) {
+        for (const auto &arrow : scene->sceneArrows) {
+            if (isArrowOpen(arrow)) {
                 hasArrowsVisible = true;
                 break;
             }
         }
 
         // set default text if not hovering anything specific
-        if (infoText.empty()) 
+        if (!infoText) 
         {
             if (hasVisibleItems) {
                 infoText = "Please select the item(s) to add it to your inventory.";
@@ -1940,28 +2698,35 @@ void GameManager::render() {
         }
 
         // actually draw the info text
-        DrawText(infoText.c_str(), 20, 25, 30, WHITE);
+        DrawText(infoText, 20, 25, 30, WHITE);
         break;
     }
 
     case GameState::COMBAT: {
         // safety checks cause we need alot of stuff for combat
-        if (!combatHandler || !entities[0] || !entities[1] || !ScreenTextures || !ScreenRects ||!nerdFont) break;
+        const GameScene* scene = CurrentScene();
+        if (!scene || !combatHandler || !entities[0] || !entities[1] || ScreenTextures.empty() || numScreenRects == 0 || !nerdFont) break;
+
+        // Where everything goes: the room data has offsets from the screen center, half the background size away
+        const float halfBgW = ScreenTextures[0].width / 2.0f, halfBgH = ScreenTextures[0].height / 2.0f;
+        const Vector2 combatBg = {SCREEN_CENTER_X - halfBgW + scene->combatBgOffset.x, SCREEN_CENTER_Y - halfBgH + scene->combatBgOffset.y};
+        const Vector2 playerChar = {SCREEN_CENTER_X + halfBgW + scene->playerCharOffset.x, SCREEN_CENTER_Y + halfBgH + scene->playerCharOffset.y};
+        const Vector2 enemyChar = {SCREEN_CENTER_X + halfBgW + scene->enemyCharOffset.x, SCREEN_CENTER_Y + halfBgH + scene->enemyCharOffset.y};
 
         // Draw the room as combat background
-        DrawTexture(ScreenTextures[0], gameScenes[currentSceneIndex].combatBgX, gameScenes[currentSceneIndex].combatBgY, WHITE);
+        DrawTexture(ScreenTextures[0], combatBg.x, combatBg.y, WHITE);
 
         // Draw the player sprite (flashes red when taking damage)
         DrawTexturePro(ScreenTextures[1],
                       {0.0f, 0.0f, (float)ScreenTextures[1].width, (float)ScreenTextures[1].height},
-                      {gameScenes[currentSceneIndex].playerCharX, gameScenes[currentSceneIndex].playerCharY, gameScenes[currentSceneIndex].playerScale.x, gameScenes[currentSceneIndex].playerScale.y}, {0.0f, 0.0f}, 0.0f,
+                      {playerChar.x, playerChar.y, scene->playerScale.x, scene->playerScale.y}, {0.0f, 0.0f}, 0.0f,
                       combatHandler->playerHitFlashTimer > 0.0f ? RED : WHITE); // red tint when hit
         
         // Draw the enemy sprite (also flashes red when hurt)
         DrawTexturePro(ScreenTextures[2],
                      
                       {0.0f, 0.0f, (float)ScreenTextures[2].width, (float)ScreenTextures[2].height},
-                      {gameScenes[currentSceneIndex].enemyCharX, gameScenes[currentSceneIndex].enemyCharY, gameScenes[currentSceneIndex].enemyScale.x, gameScenes[currentSceneIndex].enemyScale.y}, {0.0f, 0.0f}, 0.0f,
+                      {enemyChar.x, enemyChar.y, scene->enemyScale.x, scene->enemyScale.y}, {0.0f, 0.0f}, 0.0f,
                       combatHandler->enemyHitFlashTimer > 0.0f ? RED : WHITE);
 
         // Draw all the UI panels
@@ -2004,9 +2769,9 @@ void GameManager::render() {
                 DrawRectangleLinesEx(ScreenRects[i], 3.0f, BLACK);
 
         // Draw character names
-        DrawText(("Player: " + entities[0]->getName()).c_str(),
+        DrawText(frameArena().format("Player: %s", entities[0]->getName().c_str()),
                 (int)(ScreenRects[R_PLAYER_NAME].x + 20), (int)(ScreenRects[R_PLAYER_NAME].y + 10), FONT_SIZE_NAME, WHITE);
-        DrawText(("Enemy: " + entities[1]->getName()).c_str(),
+        DrawText(frameArena().format("Enemy: %s", entities[1]->getName().c_str()),
                 (int)(ScreenRects[R_ENEMY_NAME].x + 20), (int)(ScreenRects[R_ENEMY_NAME].y + 10), FONT_SIZE_NAME, WHITE);
         
         // Draw health values (current / max)
@@ -2045,12 +2810,10 @@ void GameManager::render() {
                 // MELEE attack option
                 if (GuiButton(ScreenRects[R_MELEE_BTN], "")) {
                     combatHandler->showAttackMenu = false;
-                    combatHandler->playerIsDefending = false;
-                    // do the attack and check if it hit
-                    combatHandler->enemyHitFlashTimer = resolve_melee(*entities[0], *entities[1], combatHandler->enemyIsDefending, combatHandler->log) ? 0.2f : 0.0f;
-                    if (combatHandler->enemyHitFlashTimer > 0.0f) PlaySound(gameSounds[SND_HIT]); // hit sound
+                    // do the attack (ends the player turn) and check if it hit
+                    combatHandler->enemyHitFlashTimer = playerAttack(*combatHandler, entities, false) ? 0.2f : 0.0f;
+                    if (combatHandler->enemyHitFlashTimer > 0.0f) PlaySound(*gameSounds[SND_HIT]); // hit sound
                     combatHandler->logScrollOffset = 1000.0f;
-                    combatHandler->playerTurn = false; // end player turn
                     combatHandler->enemyActionDelay = 0.6f; // enemy will act after short delay
                 }
 
@@ -2064,10 +2827,8 @@ void GameManager::render() {
                 // RANGED attack option
                 if (GuiButton(ScreenRects[R_RANGED_BTN], "")) {
                     combatHandler->showAttackMenu = false;
-                    combatHandler->playerIsDefending = false;
-                    combatHandler->enemyHitFlashTimer = resolve_ranged(*entities[0], *entities[1], combatHandler->enemyIsDefending, combatHandler->log) ? 0.2f : 0.0f;
+                    combatHandler->enemyHitFlashTimer = playerAttack(*combatHandler, entities, true) ? 0.2f : 0.0f;
                     combatHandler->logScrollOffset = 1000.0f;
-                    combatHandler->playerTurn = false;
                     combatHandler->enemyActionDelay = 0.6f;
                 }
 
@@ -2079,8 +2840,7 @@ void GameManager::render() {
                           FONT_SIZE_BTN + 20, 1.0f, GetColor(GuiGetStyle(BUTTON, TEXT_COLOR_NORMAL)));
 
                 // check if enemy died from the attack
-                if (!entities[1]->isAlive()) {
-                    AddNewLogEntry(combatHandler->log, "You have defeated " + entities[1]->getName() + "!");
+                if (fightOutcome(combatHandler->log, entities) == FightOutcome::EnemyDefeated) {
                     combatHandler->gameOverTimer = 2.0f; // wait 2 secs before leaving combat
                     combatHandler->victoryState = true; // we won
                     return;
@@ -2095,12 +2855,9 @@ void GameManager::render() {
             // DEFEND button
             if (GuiButton(ScreenRects[R_BTN_DEFEND], "DEFEND")) {
                 combatHandler->showAttackMenu = false;
-                combatHandler->playerIsDefending = true;
-                entities[0]->startDefense(); // activate defense buff
+                playerDefend(*combatHandler, entities); // activate defense buff
                 combatHandler->showItemMenu = false;
-                AddNewLogEntry(combatHandler->log, entities[0]->getName() + " is defending!");
                 combatHandler->logScrollOffset = 1000.0f;
-                combatHandler->playerTurn = false;
                 combatHandler->enemyActionDelay = 0.6f;
             }
 
@@ -2111,7 +2868,7 @@ void GameManager::render() {
                 combatHandler->showItemMenu = !combatHandler->showItemMenu; // toggle item menu
                 combatHandler->showAttackMenu = false;
                 // check if player has any items
-                if (dynamic_cast<PlayerCharacter*>(entities[0])->inv.getItems().empty()) {
+                if (asPlayer(entities[0])->inv.getItems().empty()) {
                     AddNewLogEntry(combatHandler->log, "No items in inventory.");
                     combatHandler->showItemMenu = false;
                 } else if (combatHandler->showItemMenu) {
@@ -2122,7 +2879,7 @@ void GameManager::render() {
 
             // item menu popup
             if (combatHandler->showItemMenu) {
-                auto &items = dynamic_cast<PlayerCharacter*>(entities[0])->inv.getItems();
+                auto &items = asPlayer(entities[0])->inv.getItems();
                 // size the menu based on how many items we have
                 ScreenRects[R_ITEM_MENU] = {ScreenRects[R_BTN_USE_ITEM].x + ScreenRects[R_BTN_USE_ITEM].width + 10,
                                            ScreenRects[R_BTN_USE_ITEM].y - (55.0f * items.size()) - 20.0f,
@@ -2144,25 +2901,18 @@ void GameManager::render() {
                                 combatHandler->showItemMenu = false;
                                 continue; // skip to next item
                             }
-                            // do the healing
-                            int beforeHeal = entities[0]->vit.health;
-                            dynamic_cast<PlayerCharacter*>(entities[0])->heal(items[i].healAmount);
-                            AddNewLogEntry(combatHandler->log, entities[0]->getName() + " used " + items[i].name + " and healed " +
-                                          std::to_string(entities[0]->vit.health - beforeHeal) + " HP!");
-                            PlaySound(gameSounds[SND_HEAL]); // healing sound
-                            dynamic_cast<PlayerCharacter*>(entities[0])->inv.removeitem(items[i].name, 1); // use up the item
+                            // do the healing (uses up the item)
+                            playerUseItem(*combatHandler, entities, items[i]);
+                            PlaySound(*gameSounds[SND_HEAL]); // healing sound
                             combatHandler->logScrollOffset = 1000.0f;
-                            combatHandler->playerTurn = false;
                             combatHandler->enemyActionDelay = 0.6f;
                             combatHandler->showItemMenu = false;
                         }
                     }
 
-                    // format the item label (NAME (xQUANTITY))
-                    std::string itemLabel = items[i].name;
-                    for (char &c : itemLabel) c = toupper(c); // make it uppercase
-                    itemLabel += " (x" + std::to_string(items[i].quantity) + ")";
-                    DrawText(itemLabel.c_str(), (int)(ScreenRects[R_ITEM_MENU].x + 20 + (i * 0)),
+                    // format the item label (NAME (xQUANTITY)), in the frame arena
+                    const char* itemLabel = frameArena().format("%s (x%d)", frameArena().upper(items[i].name()), (int)items[i].quantity);
+                    DrawText(itemLabel, (int)(ScreenRects[R_ITEM_MENU].x + 20 + (i * 0)),
                             (int)(ScreenRects[R_ITEM_MENU].y + 20 + (i * 55.0f)), FONT_SIZE_BTN,
                             GetColor(GuiGetStyle(BUTTON, TEXT_COLOR_NORMAL)));
                 }
@@ -2230,7 +2980,13 @@ void GameManager::render() {
         // Save & Exit button - saves and goes to main menu
         DrawRectangleRec(ScreenRects[R_BTN_SAVE_EXIT], COL_BUTTON);
         if (GuiButton(ScreenRects[R_BTN_SAVE_EXIT], "Save & Exit")) {
-            savedSucessfully = saveProgress(entities, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems);
+            // only the snapshot happens here, the worker thread writes it (the button never waits on the disk)
+            SaveData snapshot;
+            packSaveData(entities, currentSceneIndex, activeEncounterID, savedPlayerSceneIndex, battleWon, collectedItems, snapshot);
+            saveService.submit(snapshot, FillSlotInfo(snapshot), [](bool ok) {
+                savedSucessfully = ok;
+                if (!ok) TraceLog(LOG_WARNING, "Saving slot %d failed, the previous save was kept", saveService.activeSlot() + 1);
+            });
             backToMainMenu = true;
         }
 
@@ -2259,11 +3015,14 @@ void GameManager::update(float dt) {
         ((GetMousePosition().y - (((float)GetScreenHeight() - ((float)GAME_SCREEN_HEIGHT * scale)) * 0.5f)) / scale)
     };
 
+    if (currentGameState != GameState::PAUSE_MENU) handleSnapshotKeys(); // F5 / F9 / backspace
+
     switch (currentGameState) {
     case GameState::EXPLORATION: {
-        if (gameScenes.empty()) break;
+        const GameScene* scene = CurrentScene();
+        if (!scene || !currentBuilding) break;
 
-        if (currentSceneIndex == TEX_OUTSIDE)
+        if (scene->isEnding)
         {
             if (endScreenPhase == 0)
             {
@@ -2275,8 +3034,7 @@ void GameManager::update(float dt) {
 
             if (endScreenPhase == 1 && endScreenTimer <= 0.0f)
             {
-                UnloadTexture(ScreenTextures[TEX_OUTSIDE]);
-                ScreenTextures[TEX_OUTSIDE] = LoadTexture("../assets/images/environments/Building1/finalScene[2].png");
+                ScreenTextures.replace(scene->textureIndex, scene->endingTexture); // the first picture is unloaded
                 endScreenPhase = 2;
             }
 
@@ -2289,76 +3047,38 @@ void GameManager::update(float dt) {
             if (sceneTransitionTimer < 0.0f) sceneTransitionTimer = 0.0f;
         }
 
+        if (IsKeyPressed(KEY_FAST_TRAVEL)) fastTravelOpen = !fastTravelOpen;
+
         // handle mouse clicks for navigation and item pickup
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            // first check if player clicked on an item
-            for (auto &item : gameScenes[currentSceneIndex].sceneItems) {
-                if (!isItemCollected(item.itemName) &&
-                    (!item.requiresVictory || (gameScenes[currentSceneIndex].hasEncounter && battleWon[gameScenes[currentSceneIndex].encounterID])) &&
-                    CheckCollisionPointRec(virtualMouse, item.clickArea)) {
-                    // picked up the item, add to collected list
-                    collectedItems.push_back(item.itemName);
-
-                    // handle different items differently
-                    if (item.itemName == "Health Potion") 
-                    {
-                            // add potion to inventory
-                            HealthPotion hpotion;
-                            dynamic_cast<PlayerCharacter*>(entities[0])->inv.additem(hpotion);
-                    }
-
-                    if (item.itemName == "Baseball Bat") 
-                    {
-                        // baseball bat boosts your weapon stats
-                        // gotta check which character type cause they have different weapon structs
-                        if (dynamic_cast<Student*>(entities[0]))
-                        {
-                            dynamic_cast<Student*>(entities[0])->wep.meleeWeapon += 2;
-                            dynamic_cast<Student*>(entities[0])->wep.rangeWeapon += 1;
-                        } else if (dynamic_cast<Rat*>(entities[0]))
-                        {
-                            dynamic_cast<Rat*>(entities[0])->wep.meleeWeapon += 2;
-                            dynamic_cast<Rat*>(entities[0])->wep.rangeWeapon += 1;
-                        } else if (dynamic_cast<Professor*>(entities[0]))
-                        {
-                            dynamic_cast<Professor*>(entities[0])->wep.meleeWeapon += 2;
-                            dynamic_cast<Professor*>(entities[0])->wep.rangeWeapon += 1;
-                        } else if (dynamic_cast<Atilla*>(entities[0]))
-                        {
-                            dynamic_cast<Atilla*>(entities[0])->wep.meleeWeapon += 2;
-                            dynamic_cast<Atilla*>(entities[0])->wep.rangeWeapon += 1;
-                        }
-                    }
-
-                    // keys just set flags on the player
-                    if (item.itemName == "Key 1")
-                    {
-                        dynamic_cast<PlayerCharacter*>(entities[0])->key1 = true;
-                    }
+            // fast travel: a visited room clicked on the minimap
+            if (fastTravelOpen) {
+                const int room = FastTravelRoomAt(virtualMouse);
+                if (room >= 0) {
+                    fastTravelOpen = false;
+                    moveToScene(SCENE_ID(currentBuilding->index, room));
+                    break;
+                }
+            }
 
-                    if (item.itemName == "Key 2")
-                    {
-                        dynamic_cast<PlayerCharacter*>(entities[0])->key2 = true;
-                    }
+            // first check if player clicked on an item
+            for (const auto &item : scene->sceneItems) {
+                if (isItemVisible(*scene, item) && CheckCollisionPointRec(virtualMouse, item.clickArea)) {
+                    // picked up the item (collected bit, potion in the bag, bat upgrade)
+                    pickUpItem(*entities[0], item.item, collectedItems);
+                    AutosaveProgress();
+                    RefreshRoute(); // a key opens doors, and this room might be done now
                 }
             }
 
             // then check if player clicked on a navigation arrow
-            for (const auto &arrow : gameScenes[currentSceneIndex].sceneArrows) {
+            for (const auto &arrow : scene->sceneArrows) {
                 // skip disabled arrows and locked arrows
-                if (!arrow.isEnabled || (!arrow.requiredKeyName.empty() && !isItemCollected(arrow.requiredKeyName)))
+                if (!isArrowOpen(arrow))
                     continue;
 
                 if (CheckCollisionPointRec(virtualMouse, arrow.clickArea)) {
-                    currentSceneIndex = arrow.targetSceneIndex; // go to new room
-                    sceneTransitionTimer = 0.25f; // short delay before can click again
-
-                    // if new room has an undefeated enemy, start combat
-                    if (gameScenes[currentSceneIndex].hasEncounter && !battleWon[gameScenes[currentSceneIndex].encounterID]) {
-                        savedPlayerSceneIndex = currentSceneIndex; // remember where we are for saves
-                        activeEncounterID = gameScenes[currentSceneIndex].encounterID;
-                        changeGameState(GameState::COMBAT); // fight
-                    }
+                    moveToScene(arrow.targetSceneIndex); // go to new room
                     break; // only process one arrow click
                 }
             }
@@ -2393,70 +3113,47 @@ void GameManager::update(float dt) {
         if (combatHandler->gameOverState || combatHandler->victoryState) {
             combatHandler->gameOverTimer -= dt;
             if (combatHandler->gameOverTimer <= 0.0f) {
-                PlaySound(gameSounds[SND_ZOM_DEATH]); // death sound
+                PlaySound(*gameSounds[SND_ZOM_DEATH]); // death sound
                 // if we won, mark the encounter as defeated
                 if (combatHandler->victoryState && activeEncounterID >= 0) {
-                    battleWon[activeEncounterID] = true;
-                    // set the defeat flag on player based on which zombie we beat
-                    switch (activeEncounterID) 
-                    {
-                        case 0:
-                        {
-                            dynamic_cast<PlayerCharacter*>(entities[0])->zombie1Defeated = true;
-                            break;
-                        }
-                        case 1:
-                        {
-                            dynamic_cast<PlayerCharacter*>(entities[0])->zombie2Defeated = true;
-                            break;
-                        }
-                        case 2:
-                        {
-                            dynamic_cast<PlayerCharacter*>(entities[0])->zombie3Defeated = true;
-                            break;
-                        }
-                    }
+                    recordVictory(activeEncounterID, *entities[0], battleWon); // and the player's defeat flag for that zombie
                     activeEncounterID = -1; // no more active encounter
                 }
-                changeGameState(GameState::EXPLORATION); // back to exploring
+                // HP, inventory and the battle result after the fight (not after dying, that would overwrite a good save)
+                if (!combatHandler->gameOverState) AutosaveProgress();
+                requestGameState(GameState::EXPLORATION); // back to exploring
             }
             break; // dont do other combat stuff while waiting
         }
 
         // Enemy's turn logic
         if (!combatHandler->playerTurn) {
+            // first frame of the enemy turn: start the planner so it thinks while the delay counts down
+            // (budget never goes past the delay so the answer is always ready when we need it)
+            if (!enemyPlanner.isThinking()) {
+                enemyPlanner.begin(snapshotCombat(*entities[1], *entities[0]),
+                                   std::min(AI_THINK_BUDGET_MS, (int)(combatHandler->enemyActionDelay * 1000.0f)));
+            }
             combatHandler->enemyActionDelay -= dt; // count down delay
             if (combatHandler->enemyActionDelay <= 0.0f) {
                 // its enemys turn to do something
                 
-                // end enemy defense if they were defending last turn
-                if (combatHandler->enemyIsDefending)
-                    entities[1]->endDefense();
-                combatHandler->enemyIsDefending = false;
-
-                // AI decides what to do
-                Action enemyAction = ai_choose(*(dynamic_cast<NonPlayerCharacter*>(entities[1])), *(dynamic_cast<PlayerCharacter*>(entities[0])));
-
-                if (enemyAction.type == ActionType::Attack) {
-                    // enemy attacks
-                    combatHandler->playerHitFlashTimer = resolve_melee(*entities[1], *entities[0], combatHandler->playerIsDefending, combatHandler->log) ? 0.2f : 0.0f;
-                    if (combatHandler->playerHitFlashTimer > 0.0f) PlaySound(gameSounds[SND_HIT]);
-                    combatHandler->logScrollOffset = 1000.0f;
-                    // check if player died
-                    if (!entities[0]->isAlive()) {
-                        AddNewLogEntry(combatHandler->log, "You died.");
-                        combatHandler->gameOverTimer = 2.0f;
-                        combatHandler->gameOverState = true;
-                        return;
-                    }
-                } else if (enemyAction.type == ActionType::Defend) {
-                    // enemy defends
-                    combatHandler->enemyIsDefending = true;
-                    entities[1]->startDefense();
-                    AddNewLogEntry(combatHandler->log, entities[1]->getName() + " is defending!");
-                    combatHandler->logScrollOffset = 1000.0f;
+                // AI decides what to do (best move the planner found so far, it stops thinking here)
+                Action enemyAction = enemyPlanner.collect();
+
+                // the move plays out, then the end of the round ticks poison/burn/regen for both sides
+                bool hit = false;
+                const FightOutcome outcome = enemyTurn(*combatHandler, entities, enemyAction, &hit);
+                combatHandler->playerHitFlashTimer = hit ? 0.2f : 0.0f;
+                if (hit) PlaySound(*gameSounds[SND_HIT]);
+                combatHandler->logScrollOffset = 1000.0f;
+                if (outcome != FightOutcome::Going) {
+                    combatHandler->gameOverTimer = 2.0f;
+                    combatHandler->gameOverState = outcome == FightOutcome::PlayerDied;
+                    combatHandler->victoryState = outcome == FightOutcome::EnemyDefeated;
+                    return;
                 }
-                combatHandler->playerTurn = true; // back to player turn
+                recordWorldSnapshot(); // undo goes back to here
             }
         }
         break;
@@ -42,6 +42,9 @@
 
                     - void ScreenManager::changeScreen(ScreenState newScreen): Request a screen change to a new screen state.
 
+                    - void ScreenManager::requestScreen(ScreenState newScreen): Same behind a fade, the new screen's textures
+                      are prepared in the background while the old one fades out (updateTransition does the swap).
+
                     - ScreenState ScreenManager::getCurrentScreen() const: Get the current screen state.
 
                     - void ScreenManager::update(float dt): Update the current screen with delta time.
@@ -63,6 +66,8 @@
 
                     - void GameManager::changeGameState(GameState newState): Request a game state change.
 
+                    - void GameManager::requestGameState(GameState newState): Same behind a fade (into a fight and back out).
+
                     - GameState GameManager::getCurrentGameState() const: Get the current game state
 
                     - void GameManager::update(float dt): Update the current game state with delta time.
@@ -101,14 +106,31 @@
 */
 
 //======================= STANDARD LIBRARY INCLUDES =======================
+#include <array>       // for the sound handles and character cards
 #include <cmath>       // for std::exp, fmodf
+#include <memory>      // for std::unique_ptr (intro crawl text)
 #include <map>         // for battleWon map
 #include <algorithm>   // for std::clamp, std::max, std::min
+#include <cstdio>      // for std::sscanf (hot reloaded building file names)
+#include <cstring>     // for std::memcpy, std::strncpy (save slot info)
+#include <ctime>       // for std::time, std::strftime (save slot timestamps)
+#include <filesystem>  // for std::filesystem::exists (old save migration)
 
 //======================= PROJECT INCLUDES =======================
 #include "raylib.h"    // used for screen rendering 
+#include "resources.h" // RAII texture/sound/font handles, per state texture sets
+#include "memoryLedger.h" // memory/VRAM accounting per screen, budgets, overlay
+#include "uiLayout.h"  // compile time rect tables of the screens
 #include "characters.h"// for Character class and related definitions
+#include "entityPool.h"// session entity pool (owns the player and enemies)
+#include "fileWatcher.h"// hot reload of dat/ files
+#include "saveSlots.h" // save slot count and the slot index the load menu shows
+#include "worldState.h"// in-memory snapshots for quicksave, quickload and rewind
+#include "sceneGraph.h"// rooms of every building (loaded from dat/scenes)
+#include "sceneRoute.h"// shortest ways between rooms (minimap route, fast travel)
+#include "sceneGen.h"  // seeded fight/item placement (SCENE_LAYOUT_SEED)
 #include "combat.h"    // to manage combat state and perform actions
+#include "combatAI.h"  // background enemy planner
 #include "raygui.h"    // for GUI elements
 
 
@@ -153,6 +175,11 @@
 #define SND_ZOM_GROAN 4    //Sound when player walks in on a zombie encounter
 #define TOTAL_SOUNDS 5
 
+//====================== SCREEN RESOURCES ======================
+#define MAX_SCREEN_RECTS 25 // ScreenRects slots (exploration and combat use all of them, the menus fewer)
+#define TRANSITION_FADE_TIME 0.35f      // Seconds a screen/game state change takes to fade out (and again to fade in)
+#define TRANSITION_UPLOADS_PER_FRAME 2  // Prefetched textures uploaded to the GPU per frame while fading out
+
 //================= NERD FONT ICON CODEPOINTS ===================
 // Got these values from nerdfonts.com/cheat-sheet
 #define ICON_SWORD 0xF04E5
@@ -173,6 +200,19 @@
 #define MAIN_BUTTON_OFFSET_Y 100.0f // Offset form vertical center
 #define MAIN_BUTTON_SPACING 100.0f  // Spacing between buttons
 
+// Load menu (one row per save slot, drawn from the slot index only)
+#define SLOT_ROW_WIDTH 1000.0f
+#define SLOT_ROW_HEIGHT 150.0f
+#define SLOT_ROW_SPACING 20.0f
+#define SLOT_ROW_Y 330.0f           // Top of the first row
+#define SLOT_THUMB_SCALE 2.5f       // Thumbnails are drawn at 200x112
+#define R_MENU_SLOT_FIRST 3         // ScreenRects index of the first slot row (after start, load, exit)
+#define R_MENU_SLOT_BACK (R_MENU_SLOT_FIRST + SAVE_SLOT_COUNT) // Back button of the load menu
+#define R_MENU_OVERWRITE (R_MENU_SLOT_BACK + 1) // "Start over this save?" box when every slot is used
+#define MENU_RECT_COUNT (R_MENU_OVERWRITE + 1)
+#define OVERWRITE_BOX_WIDTH 900.0f
+#define OVERWRITE_BOX_HEIGHT 260.0f
+
 
 //========================= CHARACTER SELECTION SCREEN CONSTANTS & MACROS =========================
 #define MAX_CHAR_CARDS 4 // Number of character cards available (Student, Rat, Professor, Atilla)
@@ -219,38 +259,21 @@
 
 // ================== Exploration constants and macros ==================
 
-// Background texture indices in the exploration screen
-#define TEX_ENTRANCE 0
-#define TEX_EXIT 1
-#define TEX_FRONT_OFFICE 2
-#define TEX_EAST_HALLWAY_TOWARD 3
-#define TEX_EAST_HALLWAY_AWAY 4
-#define TEX_WEST_HALLWAY_TOWARD 5
-#define TEX_WEST_HALLWAY_AWAY 6
-#define TEX_CLASSROOM_1 7
-#define TEX_CLASSROOM_2 8
-#define TEX_CLASSROOM_3 9
-#define TEX_IN_OFFICE 10
-#define TEX_BATH_MEN 11
-#define TEX_BATH_WOM 12
-#define TEX_OUTSIDE 13
-
-//Item texture indices in the exploration screen
-#define TEX_KEY_1 14
-#define TEX_KEY_2 15
-#define TEX_HEALTH_POTION 16
-#define TEX_BAT 17
-
-//Other texture indices in the exploration screen
-#define TEX_ARROW 18
-#define TEX_MINIMAP 19
-#define TEX_TURTLE 20
-#define TOTAL_EXP_TEX 21
+// Exploration textures: the current building's textures (sceneGraph.h, rooms/items/minimap use
+// their index in Building::textures) come first, the UI textures every building shares go after them
+#define TEX_ARROW(building) ((int)(building)->textures.size())
+#define TEX_TURTLE(building) ((int)(building)->textures.size() + 1)
+#define EXP_UI_TEXTURES 2
 
 //Minimap specific macros
 #define MINIMAP_SIZE 300.0f
 #define MINIMAP_MARGIN 20.0f
 #define MINIMAP_BORDER 4.0f
+#define MINIMAP_ROUTE_THICKNESS 5.0f // Line drawn from the player to the next objective
+#define MINIMAP_ROOM_RADIUS 10.0f    // Room dots (objective, fast travel targets)
+#define MINIMAP_ROOM_POS(scene) Vector2{MINIMAP_X + (scene).minimapCoords.x * MINIMAP_SIZE, MINIMAP_Y + (scene).minimapCoords.y * MINIMAP_SIZE}
+#define COL_ROUTE         Color{255, 203, 64, 220}  // route line, objective dot and the arrow to take
+#define COL_FAST_TRAVEL   Color{102, 191, 255, 230} // rooms fast travel can go to
 #define MINIMAP_X ((float)GAME_SCREEN_WIDTH - MINIMAP_SIZE - MINIMAP_MARGIN)   // X position of the minimap
 #define MINIMAP_Y ((float)GAME_SCREEN_HEIGHT - MINIMAP_SIZE - MINIMAP_MARGIN)  // Y position of the minimap
 
@@ -325,10 +348,32 @@
 #define PAUSE_PANEL_Y (((float)GAME_SCREEN_HEIGHT - PAUSE_PANEL_HEIGHT) / 2.0f)
 #define PAUSE_BTN_X (PAUSE_PANEL_X + (PAUSE_PANEL_WIDTH - PAUSE_BTN_WIDTH) / 2.0f)
 
+// ========================= Snapshot Hotkeys =========================
+#define KEY_QUICKSAVE KEY_F5        // Snapshot the world in memory (exploration only)
+#define KEY_QUICKLOAD KEY_F9        // Go back to the quicksave (leaves a fight if there is one)
+#define KEY_REWIND KEY_BACKSPACE    // Combat: undo the last turn, exploration: back to the previous room
+#define KEY_FAST_TRAVEL KEY_T       // Exploration: show the visited rooms on the minimap, click one to go there
+
+// ========================= Memory Accounting =========================
+#define KEY_MEMORY_OVERLAY KEY_F3   // Show/hide the memory counters per screen (memoryLedger.h)
+#define KEY_MEMORY_DUMP KEY_F4      // Write the memory counters to MEM_DUMP_PATH
+#define MEM_DUMP_PATH "../memoryDump.txt" // Relative to the executable
+
 
 
 // ======================== GAME AND SCREEN STATE ENUMS ========================
 
+//@author: Edwin Baiden
+//@brief: One of the character select cards (its spot in the row, where it is and where it is sliding to, its portrait)
+//@version: 1.0
+struct charCard 
+{
+    Rectangle defaultRow;
+    Rectangle currentAnimationPos;
+    Rectangle targetAnimationPos;
+    Texture2D texture;
+};
+
 //@author: Edwin Baiden
 //@brief: Enum representing different screen states (main menu, character select, gameplay, save & quit).
 //@version: 1.0
@@ -339,6 +384,19 @@ enum class ScreenState { MAIN_MENU, CHARACTER_SELECT, INTRO_CRAWL, GAMEPLAY };
 //@version: 1.0
 enum class GameState { EXPLORATION, COMBAT, PAUSE_MENU };
 
+//@author: Edwin Baiden
+//@brief: A screen or game state change in progress. The old state fades to black while the textures of the new one are decoded
+//        on worker threads (TextureSet::prefetch), the swap happens once the screen is black and they are all on the GPU
+//@version: 1.0
+struct ScreenTransition {
+    enum class Phase { None, FadeOut, FadeIn };
+    Phase phase = Phase::None;
+    bool toGameState = false; // target is gameState (inside GAMEPLAY) instead of screen
+    ScreenState screen = ScreenState::MAIN_MENU;
+    GameState gameState = GameState::EXPLORATION;
+    float fade = 0.0f; // 0 = clear, 1 = black
+};
+
 //@author: Edwin Baiden
 //@brief: Class to manage screen states and transitions
 //@version: 1.0
@@ -356,12 +414,14 @@ private:
 
     void enterScreen(ScreenState screen); // Handle entering a new screen loading resources
     void exitScreen(ScreenState screen);  // Handle exiting a screen unloading resources
+    void updateTransition(float deltaTime); // Fade, upload prefetched textures and swap screens/game states when ready
 
 public:
     explicit ScreenManager(ScreenState initial = ScreenState::MAIN_MENU); // Constructor with default initial screen
     ~ScreenManager(); // Destructor
     void init(); // Initialize the screen manager
     void changeScreen(ScreenState newScreen); // Request a screen change
+    void requestScreen(ScreenState newScreen); // Change screens behind a fade (the new screen is prepared while the old one fades out)
     /*
         - [[nodiscard]]: Makes sure that the returned is actually used by the caller(helps catch bugs where return value is ignored)
         - const: Ensures that the function is a read-only operation
@@ -369,6 +429,7 @@ public:
     [[nodiscard]] ScreenState getCurrentScreen() const; // Get the current screen state used 
     void update(float deltaTime); // Update the current screen with delta time
     void render(); // Render the current screen
+    int runAllocationCheck(int frames); // Scripted room + player turn, exit code 1 if a steady frame allocated (make alloc-check)
 
     // Helper to convert real mouse coordinates to virtual game coordinates
     Vector2 GetVirtualMousePosition();
@@ -384,86 +445,33 @@ private:
     GameState nextGameState = GameState::EXPLORATION; // Next game state to transition to
     GameState prevGameState = GameState::EXPLORATION; // Previous game state before transition
     CombatHandler* combatHandler = nullptr; // Combat handler to manage combat state
+    EnemyPlanner enemyPlanner; // Searches the enemy's next move on a worker thread during enemyActionDelay
     float sceneTransitionTimer = 0.0f; // Timer for scene transitions
+    bool fastTravelOpen = false; // Minimap shows the rooms fast travel can go to
+
+    void moveToScene(int sceneId); // Walk (or fast travel) into a room: encounter check, snapshot, autosave
+
+    void recordWorldSnapshot(); // Push a snapshot of right now onto the rewind history (new room, start of a player turn)
+    bool restoreWorldSnapshot(const WorldState& state); // Put a snapshot back (leaves the fight first for an exploration snapshot)
+    void handleSnapshotKeys(); // Quicksave, quickload and rewind hotkeys
 
 public:
     explicit GameManager(GameState initial = GameState::EXPLORATION);
     ~GameManager(); // Destructor
     void changeGameState(GameState newState); // Request a game state change
+    void requestGameState(GameState newState); // Change game states behind a fade (combat and back)
     [[nodiscard]] GameState getCurrentGameState() const; // Get the current game state (used [[nodiscard]] to ensure return value is used by caller; used const to make it read-only)
     void update(float deltaTime); // Update the current game state with delta time
     void render(); // Render the current game state
     void enterGameState(GameState state); // Handle entering a new game state loading resources
     void exitGameState(GameState state); // Handle exiting a game state unloading resources
+    [[nodiscard]] std::size_t heapBytes() const; // Heap the fight holds (combat handler, log) for the memory ledger
+    [[nodiscard]] bool isSteadyState() const; // Exploring, or the player's turn of a fight that is still on (frames that must not allocate)
+    [[nodiscard]] std::uint64_t stateStamp() const; // Changes with the game state, room, turn, combat log and fast travel (allocation checks)
     bool backToMainMenu = false; // Flag to indicate returning to main menu
 };
 
-//@author: Edwin Baiden
-//@brief: Simple enum for direction. mostly used for arrows in exploration
-//@version: 1.0
-enum ArrowDirection { NONE = -1, UP, DOWN, LEFT, RIGHT };
-
-// Items on in the area (Keys, Potions)
-//@author: Edwin Baiden
-//@brief: Struct defining an item that sits on the floor in exploration mode. basicly stuff u can pick up
-//@version: 1.0
-struct SceneItem {
-    std::string itemName; // Name to match inventory string (e.g. "Key 1")
-    std::string hoverText; // Text to display on mouseover (tells player what it is)
-    Rectangle clickArea; // Click zone on screen (hitbox)
-    int textureIndex; // Index in Global ScreenTextures array (dont mess this up)
-    bool requiresVictory; // True if item only appears after room battle is won (loot drop)
-};
-
-// Navigation points (Doors, Hallway Arrows)
-//@author: Edwin Baiden
-//@brief: Struct for navigation arrows. Tells the game where to go next.
-//@version: 1.0
-struct SceneArrow {
-    Rectangle clickArea; // clickable area on screen
-    ArrowDirection dir; // which way is it pointing
-    int targetSceneIndex; // where does this arrow take u
-    bool isEnabled; // is the arrow clickable?
-    std::string hoverText; // text when mouse hovers
-    std::string requiredKeyName;// If not empty, checks player inventory for this string (locked doors)
-};
-
-// The Room Container
-//@author: Edwin Baiden
-//@brief: Class that holds all data for a specific room or "scene" in the game. basicly a container for all the stuff in a room
-//@version: 1.0
-class GameScene 
-{
-public:
-    std::string sceneName;               // Name displayed on minimap
-    int textureIndex;                    // Background texture index for the room
-    std::string environmentTexture = ""; // Environment texture file path (for combat background loading)
-    
-    Vector2 minimapCoords;  // 0.0-1.0 Position on map image (normalized coords)
-    float minimapRotation;  // Rotation of the turtle icon on minimap
-    
-    std::vector<SceneArrow> sceneArrows; // List of nav arrows
-    std::vector<SceneItem> sceneItems;   // List of items in room
-        
-    // Combat Trigger stuff
-    bool hasEncounter = false; // Does this room have a fight?
-    int encounterID = -1;      // Which enemy is it?
-        
-    // Coordinates for drawing combat elements (took a while to calibrate these)
-    float combatBgX = 0.0f;
-    float combatBgY = 0.0f;
-
-    float playerCharX = 0.0f;
-    float playerCharY = 0.0f;
-    
-    float enemyCharX = 0.0f;
-    float enemyCharY = 0.0f;
-
-    Vector2 playerScale = {0.0f, 0.0f}; // size of player in this room
-    Vector2 enemyScale = {0.0f, 0.0f};  // size of enemy in this room
-};
-
-void InitGameScenes(Character* playerCharacter); // Initialize all game scenes
+void InitGameScenes(Character* playerCharacter); // Load the textures of the building the player is in
 
 // ========================= ANIMATION NAMESPACE DEFINITION =========================
 
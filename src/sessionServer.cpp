@@ -0,0 +1,423 @@
+/*===================================== sessionServer.cpp ====================================
+  Project: TTRPG Game ?
+  Subsystem: Headless Sessions (Server)
+  Primary Author: Edwin Baiden
+  Description: Headless game server: many runs of the game (GameSession, gameSession.h) in one
+               process, played over a local Unix domain socket. For tournaments and automated
+               tests, no window, nothing drawn.
+
+               One thread does all the socket work (poll). A request names a session, the
+               command goes into that session's queue, and a session with commands waiting has
+               exactly one task in the work stealing pool (workStealingPool.h) that runs them in
+               order. So a session is only ever on one worker at a time and needs no locks of its
+               own, while thousands of sessions spread over every core. Replies go back to the
+               socket thread through an outbox and a wake pipe.
+
+               Protocol, one line per request and one line per reply:
+                    open <characterID> [seed] [name]   new session (seed 0 or none = random)
+                    look <session>
+                    go <session> <exit>                 exits/items/bag indexes as look lists them
+                    take <session> <item>
+                    melee <session> | ranged <session> | defend <session>
+                    use <session> <bag item>
+                    save <session> [name]               name defaults to session<id> (letters, digits, - and _)
+                    load <session> [name]
+                    close <session>
+                    stats
+               Replies are "ok <session> <text>" or "err <session> <text>". A session's replies come
+               in the order of its requests, replies of different sessions can interleave, so a
+               client can keep requests for many sessions in flight (replies to open, stats and
+               bad requests come back in request order, "err 0" when no session was opened). Sessions belong to the
+               server, not to the connection: a client can reconnect and carry on.
+
+               Usage:
+                    ./SessionServer [--socket PATH] [--threads N] [--max-sessions N] [--saves DIR] [--journals DIR] [--verbose]
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "gameSession.h"
+#include "workStealingPool.h"
+
+#define SERVER_SOCKET_PATH "/tmp/thelastlift.sock"  // Default socket
+#define SERVER_SAVE_DIR "../dat/usrData/sessions"   // Default save directory (relative to the executable)
+#define SERVER_MAX_SESSIONS 65536                   // Default session limit
+#define SERVER_MAX_LINE 256                         // Longest request line, a client sending more is dropped
+#define SERVER_MAX_BACKLOG (4u << 20)               // Replies queued for a client before its requests stop being read
+#define SERVER_READ_CHUNK 4096
+
+//@brief: What the command line set
+struct ServerOptions
+{
+    std::string socketPath = SERVER_SOCKET_PATH;
+    std::string saveDir = SERVER_SAVE_DIR;
+    std::string journalDir;                 // empty = fight journals are not kept
+    unsigned threads = 0;                   // 0 = one per core
+    std::size_t maxSessions = SERVER_MAX_SESSIONS;
+    bool verbose = false;
+};
+
+//@brief: One request on its way to a session (client = who gets the reply)
+struct Command
+{
+    std::uint64_t client;
+    std::vector<std::string> words;         // verb, session, arguments
+};
+
+//@brief: A session and the requests it has not run yet
+struct SessionSlot
+{
+    SessionSlot(std::uint32_t slotId, const SessionWorld& world, std::uint32_t seed) : id(slotId), session(world, seed) {}
+
+    const std::uint32_t id;
+    GameSession session;                    // only touched by the task running the queue (and by open, before it is listed)
+    std::mutex lock;                        // guards inbox and scheduled
+    std::deque<Command> inbox;
+    bool scheduled = false;                 // a task for this slot is in the pool
+};
+
+//@brief: One connected client (socket thread only)
+struct Client
+{
+    int fd = -1;
+    std::string in;                         // bytes read, not a full line yet
+    std::string out;                        // replies not written yet
+};
+
+//@brief: Replies from the workers to the socket thread
+struct Outbox
+{
+    std::mutex lock;
+    std::vector<std::pair<std::uint64_t, std::string>> replies;
+    int wakeFd = -1;                        // write end of the wake pipe
+
+    void post(std::uint64_t client, std::string line)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            replies.emplace_back(client, std::move(line));
+        }
+        const char byte = 1;
+        (void)!write(wakeFd, &byte, 1); // a full pipe already wakes the socket thread
+    }
+};
+
+static volatile std::sig_atomic_t stopRequested = 0;
+static int signalWakeFd = -1;
+static std::atomic<std::uint64_t> commandsRun{0}; // session commands the workers ran (stats), a drain task runs one or more
+
+//@brief: SIGINT/SIGTERM, the socket thread finishes up
+static void OnStopSignal(int)
+{
+    stopRequested = 1;
+    const char byte = 1;
+    (void)!write(signalWakeFd, &byte, 1);
+}
+
+//@brief: Save names end up in file names, so only letters, digits, - and _
+static bool IsSaveName(const std::string& name)
+{
+    return !name.empty() && name.size() < 64 &&
+           std::all_of(name.begin(), name.end(), [](char c) { return std::isalnum((unsigned char)c) || c == '-' || c == '_'; });
+}
+
+//@brief: Integer argument i of a request (fallback if it is missing or not a number)
+static long IntArg(const Command& command, std::size_t i, long fallback)
+{
+    if (i >= command.words.size()) return fallback;
+    char* end = nullptr;
+    const long value = std::strtol(command.words[i].c_str(), &end, 10);
+    return *end == '\0' ? value : fallback;
+}
+
+//@brief: Runs one request on its session (worker thread, the session is ours while this runs)
+static SessionResult RunCommand(SessionSlot& slot, const Command& command, const ServerOptions& options)
+{
+    GameSession& session = slot.session;
+    const std::string& verb = command.words[0];
+    if (verb == "look") return session.look();
+    if (verb == "go") return session.go((int)IntArg(command, 2, -1));
+    if (verb == "take") return session.take((int)IntArg(command, 2, -1));
+    if (verb == "melee") return session.melee();
+    if (verb == "ranged") return session.ranged();
+    if (verb == "defend") return session.defend();
+    if (verb == "use") return session.useItem((int)IntArg(command, 2, -1));
+    if (verb == "save" || verb == "load")
+    {
+        const std::string name = command.words.size() > 2 ? command.words[2] : "session" + std::to_string(slot.id);
+        if (!IsSaveName(name)) return {false, "save names are letters, digits, - and _"};
+        const std::string path = options.saveDir + "/" + name + ".tls";
+        return verb == "save" ? session.save(path) : session.load(path);
+    }
+    if (verb == "close") return {true, "closed after " + std::to_string(session.fights()) + " fights"};
+    return {false, "unknown command " + verb};
+}
+
+//@brief: Task of a slot: runs its requests until the queue is empty (one task per slot at a time, see SessionSlot::scheduled)
+static void DrainSession(const std::shared_ptr<SessionSlot>& slot, const ServerOptions& options, Outbox& outbox)
+{
+    for (;;)
+    {
+        Command command;
+        {
+            std::lock_guard<std::mutex> guard(slot->lock);
+            if (slot->inbox.empty())
+            {
+                slot->scheduled = false;
+                return;
+            }
+            command = std::move(slot->inbox.front());
+            slot->inbox.pop_front();
+        }
+        const SessionResult result = RunCommand(*slot, command, options);
+        commandsRun.fetch_add(1, std::memory_order_relaxed);
+        outbox.post(command.client, (result.ok ? "ok " : "err ") + std::to_string(slot->id) + " " + result.text);
+    }
+}
+
+//@brief: Queues a request for a slot, and a task to run it if the slot has none in the pool
+static void Dispatch(const std::shared_ptr<SessionSlot>& slot, Command command, WorkStealingPool& pool, const ServerOptions& options, Outbox& outbox)
+{
+    {
+        std::lock_guard<std::mutex> guard(slot->lock);
+        slot->inbox.push_back(std::move(command));
+        if (slot->scheduled) return;
+        slot->scheduled = true;
+    }
+    pool.submit([slot, &options, &outbox] { DrainSession(slot, options, outbox); });
+}
+
+//@brief: Listening socket at path (a stale socket file from an earlier run is replaced)
+//@return - The socket, -1 if it could not be set up
+static int OpenListenSocket(const std::string& path)
+{
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << path << ": socket path too long\n";
+        return -1;
+    }
+    struct stat info{};
+    if (lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) unlink(path.c_str());
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    if (bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+    {
+        std::cerr << path << ": " << std::strerror(errno) << "\n";
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int main(int argc, char** argv)
+{
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string flag = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (flag == "--verbose") options.verbose = true;
+        else if (flag == "--socket" && hasValue) options.socketPath = argv[++i];
+        else if (flag == "--saves" && hasValue) options.saveDir = argv[++i];
+        else if (flag == "--journals" && hasValue) options.journalDir = argv[++i];
+        else if (flag == "--threads" && hasValue) options.threads = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (flag == "--max-sessions" && hasValue) options.maxSessions = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--socket PATH] [--threads N] [--max-sessions N] [--saves DIR] [--journals DIR] [--verbose]\n";
+            return 2;
+        }
+    }
+
+    platformSetLogLevel(options.verbose ? PLATFORM_LOG_INFO : PLATFORM_LOG_WARNING); // every session creates characters, that is a lot of log lines
+    platformEnterAppDirectory(); // the building files are relative to the executable, like in the game
+    std::error_code ec;
+    std::filesystem::create_directories(options.saveDir, ec);
+    if (!options.journalDir.empty()) std::filesystem::create_directories(options.journalDir, ec);
+
+    SessionWorld world(SCENE_DIR);
+    std::string error;
+    if (!world.load(error))
+    {
+        std::cerr << "no buildings: " << error << "\n";
+        return 1;
+    }
+
+    int wakePipe[2];
+    if (pipe(wakePipe) != 0) return 1;
+    for (int fd : wakePipe) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    signalWakeFd = wakePipe[1];
+    std::signal(SIGINT, OnStopSignal);
+    std::signal(SIGTERM, OnStopSignal);
+    std::signal(SIGPIPE, SIG_IGN); // a client that went away is noticed by send() instead
+
+    const int listenFd = OpenListenSocket(options.socketPath);
+    if (listenFd < 0) return 1;
+
+    // sessions before the pool: the pool joins its workers first, the tasks they ran let go of their slots
+    Outbox outbox;
+    outbox.wakeFd = wakePipe[1];
+    std::unordered_map<std::uint32_t, std::shared_ptr<SessionSlot>> sessions;
+    std::unordered_map<std::uint64_t, Client> clients;
+    std::uint32_t nextSession = 1;
+    std::uint64_t nextClient = 1, requests = 0;
+    WorkStealingPool pool(options.threads);
+    std::cout << "Serving " << world.buildingCount() << " building(s) on " << options.socketPath << " with " << pool.size() << " workers\n";
+
+    // handles one request line of a client (socket thread)
+    auto handleLine = [&](std::uint64_t clientId, Client& client, const std::string& line) {
+        Command command{clientId, {}};
+        std::istringstream words(line);
+        for (std::string word; words >> word;) command.words.push_back(word);
+        if (command.words.empty()) return;
+        ++requests;
+        auto reply = [&](bool ok, const std::string& id, const std::string& text) { client.out += (ok ? "ok " : "err ") + id + " " + text + "\n"; };
+
+        const std::string& verb = command.words[0];
+        if (verb == "stats")
+        {
+            reply(true, "0", "sessions " + std::to_string(sessions.size()) + " clients " + std::to_string(clients.size()) + " requests " +
+                  std::to_string(requests) + " commands " + std::to_string(commandsRun.load(std::memory_order_relaxed)) +
+                  " tasks " + std::to_string(pool.completed()) + " steals " + std::to_string(pool.steals()) +
+                  " workers " + std::to_string(pool.size()));
+            return;
+        }
+        if (verb == "open")
+        {
+            if (command.words.size() < 2) return reply(false, "0", "open <characterID> [seed] [name]");
+            if (sessions.size() >= options.maxSessions) return reply(false, "0", "session limit reached");
+            // started right here (no AI runs before the first move): the client only learns the session ID from this
+            // reply, so replies to pipelined opens have to come back in the order of the opens
+            const std::string& characterID = command.words[1];
+            auto slot = std::make_shared<SessionSlot>(nextSession, world, (std::uint32_t)IntArg(command, 2, 0));
+            const SessionResult started = slot->session.start(characterID, command.words.size() > 3 ? command.words[3] : characterID);
+            if (!started.ok) return reply(false, "0", started.text);
+            const std::uint32_t id = nextSession++;
+            if (!options.journalDir.empty()) slot->session.keepJournals(options.journalDir + "/session" + std::to_string(id) + "_fight");
+            sessions.emplace(id, slot);
+            return reply(true, std::to_string(id), started.text);
+        }
+
+        if (command.words.size() < 2) return reply(false, "0", verb + " needs a session");
+        auto found = sessions.find((std::uint32_t)IntArg(command, 1, 0));
+        if (found == sessions.end()) return reply(false, command.words[1], "no such session");
+        std::shared_ptr<SessionSlot> slot = found->second;
+        if (verb == "close") sessions.erase(found); // no more requests for it, the ones queued still run and answer
+        Dispatch(slot, std::move(command), pool, options, outbox);
+    };
+
+    std::vector<pollfd> polled;
+    std::vector<std::uint64_t> polledClients; // client of polled[i + 2]
+    while (!stopRequested)
+    {
+        polled.assign({{wakePipe[0], POLLIN, 0}, {listenFd, POLLIN, 0}});
+        polledClients.clear();
+        for (auto& [id, client] : clients)
+        {
+            short events = client.out.size() < SERVER_MAX_BACKLOG ? POLLIN : 0; // a client not reading its replies waits
+            if (!client.out.empty()) events |= POLLOUT;
+            polled.push_back({client.fd, events, 0});
+            polledClients.push_back(id);
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0 && errno != EINTR) break;
+
+        // replies the workers finished
+        if (polled[0].revents & POLLIN)
+        {
+            char drain[256];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+            std::vector<std::pair<std::uint64_t, std::string>> replies;
+            {
+                std::lock_guard<std::mutex> guard(outbox.lock);
+                replies.swap(outbox.replies);
+            }
+            for (auto& [clientId, line] : replies)
+            {
+                auto client = clients.find(clientId);
+                if (client != clients.end()) client->second.out += line + "\n"; // a client that left does not get it
+            }
+        }
+
+        // new clients
+        if (polled[1].revents & POLLIN)
+        {
+            for (int fd; (fd = accept(listenFd, nullptr, nullptr)) >= 0;)
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                clients[nextClient++].fd = fd;
+            }
+        }
+
+        // requests in, replies out
+        for (std::size_t i = 2; i < polled.size(); ++i)
+        {
+            auto found = clients.find(polledClients[i - 2]);
+            if (found == clients.end()) continue;
+            Client& client = found->second;
+            bool drop = (polled[i].revents & (POLLERR | POLLNVAL)) != 0;
+
+            if (!drop && (polled[i].revents & (POLLIN | POLLHUP)))
+            {
+                char buffer[SERVER_READ_CHUNK];
+                const ssize_t got = recv(client.fd, buffer, sizeof(buffer), 0);
+                if (got <= 0 && !(got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))) drop = true;
+                if (got > 0) client.in.append(buffer, (std::size_t)got);
+                for (std::size_t end; !drop && (end = client.in.find('\n')) != std::string::npos;)
+                {
+                    std::string line = client.in.substr(0, end);
+                    client.in.erase(0, end + 1);
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    handleLine(found->first, client, line);
+                }
+                if (client.in.size() > SERVER_MAX_LINE) drop = true;
+            }
+            if (!drop && !client.out.empty())
+            {
+                const ssize_t sent = send(client.fd, client.out.data(), client.out.size(), MSG_NOSIGNAL);
+                if (sent > 0) client.out.erase(0, (std::size_t)sent);
+                else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) drop = true;
+            }
+            if (drop)
+            {
+                close(client.fd);
+                clients.erase(found);
+            }
+        }
+    }
+
+    std::cout << "Stopping (" << sessions.size() << " sessions, " << requests << " requests)\n";
+    pool.waitIdle();
+    for (auto& [id, client] : clients) close(client.fd);
+    close(listenFd);
+    unlink(options.socketPath.c_str());
+    return 0;
+}
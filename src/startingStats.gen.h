@@ -0,0 +1,25 @@
+/*==================================== startingStats.gen.h ==================================
+  GENERATED FILE - do not edit. Made by genStatTable.cpp from dat/Character_Starting_Stats.csv,
+  edit the CSV and run make instead.
+*/
+#include "statSchema.h"
+
+#ifndef STARTINGSTATS_GEN_H
+#define STARTINGSTATS_GEN_H
+
+#define STATS_SCHEMA_HASH 0xc77fb9ecu // statSchemaHash() of the CSV header
+#define STATS_ROW_COUNT 8
+
+// Sorted by ID, columns: ID,STR,DEX,CON,WIS,CHA,INT,MAX_HEALTH,ARMOR,INITIATIVE
+inline constexpr StatRow GENERATED_STAT_ROWS[STATS_ROW_COUNT] = {
+    {"Atilla", {4, 1, 3, 0, -3, 0, 60, 16, 1}},
+    {"Pigeon", {0, 3, 1, 1, -3, 0, 10, 15, 2}},
+    {"Professor", {0, -1, 1, 5, 1, 5, 80, 11, -1}},
+    {"Raccoon", {1, 3, 3, 0, -3, 1, 5, 14, 2}},
+    {"Rat", {1, 3, 4, -1, -2, -1, 100, 14, 5}},
+    {"Student", {2, 2, 2, 1, 3, 2, 100, 15, 2}},
+    {"Zombie_Prof", {2, 1, 2, 1, -4, 2, 15, 12, 1}},
+    {"Zombie_Standard", {4, 1, 2, 0, -4, 0, 15, 12, 1}},
+};
+
+#endif // STARTINGSTATS_GEN_H
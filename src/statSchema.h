@@ -0,0 +1,51 @@
+/*======================================== statSchema.h ======================================
+  Project: TTRPG Game ?
+  Subsystem: Characters (Starting Stats Schema)
+  Primary Author: Andrew
+  Description: Layout of one row of dat/Character_Starting_Stats.csv. Shared by the game
+               (characters.h) and the build time generator (genStatTable.cpp), which is why it
+               does not include anything from the game itself.
+
+               The schema hash is an FNV-1a hash of the CSV header line. The generator stores
+               the hash of the CSV it compiled in, and stat override files are only accepted
+               when their header hashes to the same value (same columns in the same order).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <cstdint>
+#include <string_view>
+
+//=============== HEADER GUARD ===============
+#ifndef STATSCHEMA_H
+#define STATSCHEMA_H
+
+enum CSVStats {STR=1, DEX, CON, WIS, CHA, INT, MAX_HEALTH, ARMOR, INITIATIVE};
+
+#define STATS_CSV_HEADER "ID,STR,DEX,CON,WIS,CHA,INT,MAX_HEALTH,ARMOR,INITIATIVE" // Columns CSVStats expects
+#define STAT_COLUMNS 9      // stat columns after the ID (STR..INITIATIVE)
+#define STAT_ID_MAX 24      // longest character ID we store (including the terminator)
+#define STAT_MISSING -128   // value returned for stats of an unknown ID (same as the old CSV scan)
+
+// One row of Character_Starting_Stats.csv
+struct StatRow
+{
+    char id[STAT_ID_MAX] = {};
+    std::int8_t values[STAT_COLUMNS] = {STAT_MISSING, STAT_MISSING, STAT_MISSING, STAT_MISSING, STAT_MISSING,
+                                        STAT_MISSING, STAT_MISSING, STAT_MISSING, STAT_MISSING};
+
+    constexpr std::int8_t get(CSVStats stat) const { return values[(int)stat - 1]; }
+};
+
+// FNV-1a hash of a CSV header line (a trailing '\r' from Windows line endings is ignored)
+constexpr std::uint32_t statSchemaHash(std::string_view header)
+{
+    if (!header.empty() && header.back() == '\r') header.remove_suffix(1);
+    std::uint32_t hash = 2166136261u;
+    for (char c : header)
+    {
+        hash ^= (std::uint8_t)c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#endif // STATSCHEMA_H
@@ -232,28 +232,28 @@ void runCombat(Student& player, NonPlayerCharacter& enemy)
 
 // Temporary main function for debugging
 int main() {
-    std::istringstream* allStatLines = storeAllStatLines(openStartingStatsCSV());
+    StatTable statTable;
 
     Attributes studentAttrs = {
-        getStatForCharacterID(allStatLines, "Student", CSVStats::STR),
-        getStatForCharacterID(allStatLines, "Student", CSVStats::DEX),
-        getStatForCharacterID(allStatLines, "Student", CSVStats::CON),
-        getStatForCharacterID(allStatLines, "Student", CSVStats::WIS),
-        getStatForCharacterID(allStatLines, "Student", CSVStats::CHA),
-        getStatForCharacterID(allStatLines, "Student", CSVStats::INT)
+        statTable.row("Student").get(CSVStats::STR),
+        statTable.row("Student").get(CSVStats::DEX),
+        statTable.row("Student").get(CSVStats::CON),
+        statTable.row("Student").get(CSVStats::WIS),
+        statTable.row("Student").get(CSVStats::CHA),
+        statTable.row("Student").get(CSVStats::INT)
     };
     DefenseStats studentDef = {
-        getStatForCharacterID(allStatLines, "Student", CSVStats::ARMOR),
+        statTable.row("Student").get(CSVStats::ARMOR),
         0
     };
     CombatStats studentCombat = {
         5, // meleeDamage (base)
         3, // rangeDamage (base)
-        getStatForCharacterID(allStatLines, "Student", CSVStats::INITIATIVE)
+        statTable.row("Student").get(CSVStats::INITIATIVE)
     };
     VitalStats studentVital = {
-        getStatForCharacterID(allStatLines, "Student", CSVStats::MAX_HEALTH),
-        getStatForCharacterID(allStatLines, "Student", CSVStats::MAX_HEALTH)
+        statTable.row("Student").get(CSVStats::MAX_HEALTH),
+        statTable.row("Student").get(CSVStats::MAX_HEALTH)
     };
     StatusEffects studentStatus = {};
 
@@ -263,26 +263,26 @@ int main() {
     auto safe = [](int v, int def){ return (v < 0 ? def : v); };
 
     Attributes zombieAttrs = {
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::STR), 3),
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::DEX), 1),
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::CON), 2),
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::WIS), 0),
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::CHA), -4),
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::INT), 0)
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::STR), 3),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::DEX), 1),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::CON), 2),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::WIS), 0),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::CHA), -4),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::INT), 0)
     };
     DefenseStats zombieDef = {
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::ARMOR), 12),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::ARMOR), 12),
     0
     };
     CombatStats zombieCombat = 
     {
     4, 
     0, 
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::INITIATIVE), 1)
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::INITIATIVE), 1)
     };
     VitalStats zombieVital = {
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::MAX_HEALTH), 15),
-    safe(getStatForCharacterID(allStatLines, ZOMBIE_ID, CSVStats::MAX_HEALTH), 15)
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::MAX_HEALTH), 15),
+    safe(statTable.row(ZOMBIE_ID).get(CSVStats::MAX_HEALTH), 15)
     };
     StatusEffects zombieStatus = {};
 
@@ -299,6 +299,5 @@ int main() {
     std::cout << "\nStudent " << Steve.name << " Health: " << Steve.vit.health;
     std::cout << "\nZombie Health: " << Zombie.vit.health << std::endl;
 
-    delete allStatLines;
     return 0;
 }
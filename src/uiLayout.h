@@ -0,0 +1,88 @@
+/*======================================== uiLayout.h ========================================
+  Project: TTRPG Game ?
+  Subsystem: Screen Management (Layout)
+  Primary Author: Edwin Baiden
+  Description: Compile time layouts for the screens. A screen's rects are written down as a short
+               list of LayoutItems (which corner/edge of the screen or of another rect a rect hangs
+               off, how far in, how big) and resolveLayout() turns that list into the finished
+               std::array<Rectangle, N> while compiling. The tables are static constexpr, so they
+               sit in read only memory and entering a screen is just a copy into ScreenRects,
+               nothing is worked out or allocated at runtime.
+
+               Everything is in game coordinates (GAME_SCREEN_WIDTH x GAME_SCREEN_HEIGHT). The
+               window never sees these numbers, the frame is drawn at 1920x1080 and scaled onto
+               whatever the window is (the mouse is scaled back the same way), so one table per
+               screen is all any window size needs.
+
+               Rects a list does not mention stay {0, 0, 0, 0} (popups the screen places itself).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//======================= PROJECT INCLUDES =======================
+#include "raylib.h"
+
+//=============== HEADER GUARD ===============
+#ifndef UILAYOUT_H
+#define UILAYOUT_H
+
+#define LAYOUT_SCREEN -1 // LayoutItem::parent of a rect placed on the screen itself
+
+//@author: Edwin Baiden
+//@brief: Which point of the parent a rect hangs off (the matching point of the rect goes there)
+//@version: 1.0
+enum class Anchor : std::uint8_t { TopLeft, Top, TopRight, Left, Center, Right, BottomLeft, Bottom, BottomRight };
+
+//@author: Edwin Baiden
+//@brief: One line of a layout description, places one rect (or a column of repeat rects, stepY apart)
+//@version: 1.0
+struct LayoutItem
+{
+    int index;                      // index in the screen's rects (the first one if repeated)
+    Anchor anchor;
+    float marginX;                  // inwards from the anchored edge (right anchors count from the right), offset on a centered axis
+    float marginY;                  // same for the top/bottom edge
+    float width;
+    float height;
+    int parent = LAYOUT_SCREEN;     // rect (placed earlier in the list) the anchor refers to
+    int repeat = 1;                 // rects placed at index, index + 1, ...
+    float stepY = 0.0f;             // how much lower every repeated rect goes
+};
+
+//@brief: Where on one axis a rect of size goes inside [start, start + span) (0 = near edge, 1 = centered, 2 = far edge)
+constexpr float anchorAxis(int side, float start, float span, float size, float margin)
+{
+    return side == 0 ? start + margin : side == 1 ? start + (span - size) / 2.0f + margin : start + span - size - margin;
+}
+
+//@brief: Resolves a layout description into the rects of a screen (evaluated at compile time for constexpr tables)
+//@return - N rects, the ones no item places are zero
+template <std::size_t N, std::size_t M>
+constexpr std::array<Rectangle, N> resolveLayout(const LayoutItem (&items)[M], float screenWidth, float screenHeight)
+{
+    std::array<Rectangle, N> rects{};
+    for (std::size_t i = 0; i < M; ++i)
+    {
+        const LayoutItem& item = items[i];
+        const Rectangle parent = item.parent == LAYOUT_SCREEN ? Rectangle{0.0f, 0.0f, screenWidth, screenHeight} : rects[item.parent];
+        const int column = (int)item.anchor % 3;
+        const int row = (int)item.anchor / 3;
+        for (int r = 0; r < item.repeat; ++r)
+        {
+            rects[item.index + r] = Rectangle{anchorAxis(column, parent.x, parent.width, item.width, item.marginX),
+                                              anchorAxis(row, parent.y, parent.height, item.height, item.marginY) + r * item.stepY,
+                                              item.width, item.height};
+        }
+    }
+    return rects;
+}
+
+//@brief: Rect compare for static_asserts on layout tables
+constexpr bool sameRect(const Rectangle& a, const Rectangle& b)
+{
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+#endif // UILAYOUT_H
@@ -0,0 +1,154 @@
+/*===================================== validateSeeds.cpp ====================================
+  Project: TTRPG Game ?
+  Subsystem: Exploration (Build Tool)
+  Primary Author: Edwin Baiden
+  Description: Offline check of generated layouts (see sceneGen.h). Generates and checks a range
+               of seeds for one building on every core, counts why seeds were turned down and
+               lists the first seeds that passed, one of those goes into SCENE_LAYOUT_SEED.
+               The authored layout is checked too, so a JSON edit that breaks it shows up here.
+
+               Seeds are handed out in chunks from one atomic counter, each thread keeps its own
+               counts and template copy, so the threads share nothing while they run.
+
+               Usage:
+                    ./ValidateSeeds <building<N>.json|.tlb> [--seeds N] [--first S] [--threads T] [--show K]
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sceneGen.h"
+#include "startingStats.gen.h"
+
+#define SEED_CHUNK 4096 // seeds a thread takes from the counter at a time
+
+//@brief: What one thread found
+struct SeedReport
+{
+    std::uint64_t verdicts[(int)LayoutVerdict::Count] = {};
+    std::vector<std::uint32_t> passed; // the first --show passing seeds of this thread's chunks
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <building<N>.json|.tlb> [--seeds N] [--first S] [--threads T] [--show K]\n";
+        return 2;
+    }
+    const std::string path = argv[1];
+    std::uint64_t seeds = 1000000, firstSeed = 1;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t show = 10;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        const std::string flag = argv[i];
+        const unsigned long long value = std::strtoull(argv[i + 1], nullptr, 10);
+        if (flag == "--seeds") seeds = value;
+        else if (flag == "--first") firstSeed = value;
+        else if (flag == "--threads") threads = (unsigned)std::max(1ull, value);
+        else if (flag == "--show") show = (std::size_t)value;
+        else
+        {
+            std::cerr << "unknown option " << flag << "\n";
+            return 2;
+        }
+    }
+
+    // the building as the game loads it (a .json is compiled first, like the game does when the blob is stale)
+    std::vector<char> blob;
+    std::string error;
+    const std::string file = path.substr(path.find_last_of("/\\") + 1);
+    int number = 0;
+    if (path.size() > 5 && path.compare(path.size() - 5, 5, ".json") == 0)
+    {
+        if (std::sscanf(file.c_str(), "building%d.json", &number) != 1 || number < 1 || !compileSceneJson(path, number - 1, blob, error))
+        {
+            std::cerr << (error.empty() ? path + ": building files are named building<N>.json" : error) << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        std::ifstream in(path, std::ios::binary);
+        blob.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (std::sscanf(file.c_str(), "building%d.tlb", &number) != 1) number = 0; // another name: whichever building it holds
+    }
+    Building building;
+    LayoutTemplate tmpl;
+    if (!loadSceneBlob(blob, number - 1, building))
+    {
+        std::cerr << path << ": not a valid building\n";
+        return 1;
+    }
+    if (!buildLayoutTemplate(building, GENERATED_STAT_ROWS, STATS_ROW_COUNT, tmpl, error))
+    {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    SceneLayout authored;
+    authoredLayout(tmpl, building, authored);
+    std::cout << building.name << ": " << tmpl.rooms << " rooms, " << tmpl.encounters.size() << " fights, " << tmpl.items.size()
+              << " items, " << tmpl.keys.size() << " keys, " << tmpl.enemyThreats.size() << " enemies\n"
+              << "authored layout: " << layoutVerdictName(checkLayout(tmpl, authored)) << "\n";
+
+    std::atomic<std::uint64_t> nextChunk{0};
+    std::vector<SeedReport> reports(threads);
+    auto worker = [&](SeedReport& report)
+    {
+        const LayoutTemplate local = tmpl; // own copy, no cache lines shared with the other threads
+        SceneLayout layout;
+        for (;;)
+        {
+            const std::uint64_t begin = nextChunk.fetch_add(SEED_CHUNK);
+            if (begin >= seeds) break;
+            const std::uint64_t end = std::min<std::uint64_t>(seeds, begin + SEED_CHUNK);
+            for (std::uint64_t s = begin; s < end; ++s)
+            {
+                const std::uint32_t seed = (std::uint32_t)(firstSeed + s);
+                if (seed == 0) continue; // 0 means "authored layout" to the game
+                generateLayout(local, seed, layout);
+                const LayoutVerdict verdict = checkLayout(local, layout);
+                ++report.verdicts[(int)verdict];
+                if (verdict == LayoutVerdict::Ok && report.passed.size() < show) report.passed.push_back(seed);
+            }
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, std::ref(reports[t]));
+    worker(reports[0]);
+    for (std::thread& t : pool) t.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SeedReport total;
+    for (const SeedReport& report : reports)
+    {
+        for (int v = 0; v < (int)LayoutVerdict::Count; ++v) total.verdicts[v] += report.verdicts[v];
+        total.passed.insert(total.passed.end(), report.passed.begin(), report.passed.end());
+    }
+    std::sort(total.passed.begin(), total.passed.end());
+    if (total.passed.size() > show) total.passed.resize(show);
+
+    std::uint64_t checked = 0;
+    for (std::uint64_t count : total.verdicts) checked += count;
+    std::cout << checked << " seeds on " << threads << " threads in " << seconds << " s ("
+              << (std::uint64_t)(checked / std::max(seconds, 1e-9)) << " seeds/s)\n";
+    for (int v = 0; v < (int)LayoutVerdict::Count; ++v)
+        std::cout << "  " << layoutVerdictName((LayoutVerdict)v) << ": " << total.verdicts[v] << "\n";
+    std::cout << "first passing seeds:";
+    for (std::uint32_t seed : total.passed) std::cout << " " << seed;
+    std::cout << "\n";
+    return total.verdicts[(int)LayoutVerdict::Ok] ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/*==================================== workStealingPool.cpp ==================================
+  Project: TTRPG Game ?
+  Subsystem: Headless Sessions (Thread Pool)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the work stealing pool (see workStealingPool.h).
+*/
+#include "workStealingPool.h"
+
+#include <algorithm>
+
+namespace {
+    // Pool and queue index of the worker running on this thread (nullptr on any other thread)
+    thread_local const WorkStealingPool* currentPool = nullptr;
+    thread_local unsigned currentWorker = 0;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+{
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back([this, i] { run(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    const unsigned target = currentPool == this ? currentWorker : nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+    pending.fetch_add(1);
+    queued.fetch_add(1); // before the push, a worker can take the task the moment it is in
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> guard(sleepLock); // a worker between its check and its wait would miss the notify otherwise
+    }
+    wake.notify_one();
+}
+
+void WorkStealingPool::waitIdle()
+{
+    std::unique_lock<std::mutex> guard(sleepLock);
+    idle.wait(guard, [this] { return pending.load() == 0; });
+}
+
+bool WorkStealingPool::take(unsigned self, Task& out)
+{
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty())
+        {
+            out = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (unsigned step = 1; step < size(); ++step)
+    {
+        Queue& victim = *queues[(self + step) % size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            out = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            stealCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(unsigned self)
+{
+    currentPool = this;
+    currentWorker = self;
+    for (;;)
+    {
+        Task task;
+        if (take(self, task))
+        {
+            queued.fetch_sub(1);
+            task();
+            doneCount.fetch_add(1, std::memory_order_relaxed);
+            if (pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -0,0 +1,90 @@
+/*===================================== workStealingPool.h ===================================
+  Project: TTRPG Game ?
+  Subsystem: Headless Sessions (Thread Pool)
+  Primary Author: Edwin Baiden
+  Description: Fixed set of worker threads with one task queue each. A worker runs its own
+               queue newest first (the task it just pushed is still hot in its cache) and, when
+               that is empty, steals the oldest task of another worker's queue, so a worker that
+               got a burst of long fights does not hold everyone else up while the rest sit idle.
+               Tasks submitted from outside the pool (the server's socket thread) are dealt out
+               round robin, tasks a worker submits go onto its own queue.
+
+               Idle workers sleep on a condition variable and are woken per submitted task,
+               nothing spins. Every queue has its own lock, held only for a push or a pop, so
+               workers only meet when one of them steals.
+
+               The pool does not order tasks: two tasks that must not overlap (two commands of
+               one session) have to be chained by the caller (sessionServer.cpp queues them per
+               session and keeps one task per session in the pool at a time).
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//=============== HEADER GUARD ===============
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+/**
+ * @author: Edwin Baiden
+ * @brief: Worker threads with a task queue each, idle workers steal from busy ones
+ * @version: 1.0
+ */
+class WorkStealingPool
+{
+    public:
+        using Task = std::function<void()>;
+
+        //@brief: Starts the workers (0 = one per core)
+        explicit WorkStealingPool(unsigned threadCount = 0);
+        //@brief: Runs whatever is still queued, then stops and joins the workers
+        ~WorkStealingPool();
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        //@brief: Queues a task (any thread, a worker queues onto its own queue)
+        void submit(Task task);
+
+        //@brief: Blocks until every submitted task has finished (tasks submitted meanwhile included)
+        void waitIdle();
+
+        unsigned size() const { return (unsigned)queues.size(); }
+        std::uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }  // tasks run by a worker that did not get them
+        std::uint64_t completed() const { return doneCount.load(std::memory_order_relaxed); } // tasks finished so far
+
+    private:
+        struct Queue
+        {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues; // one per worker, same index
+        std::vector<std::thread> workers;
+        std::mutex sleepLock;                       // guards stopping, sleeping workers and waitIdle wait on it
+        std::condition_variable wake;               // a task was queued (or the pool is stopping)
+        std::condition_variable idle;               // pending dropped to 0
+        std::atomic<std::size_t> queued{0};         // tasks sitting in a queue
+        std::atomic<std::size_t> pending{0};        // tasks submitted and not finished (queued + running)
+        std::atomic<unsigned> nextQueue{0};         // round robin for tasks from outside the pool
+        std::atomic<std::uint64_t> stealCount{0};
+        std::atomic<std::uint64_t> doneCount{0};
+        bool stopping = false;
+
+        //@brief: Own queue newest first, then the other queues oldest first
+        //@return - False if every queue was empty
+        bool take(unsigned self, Task& out);
+
+        //@brief: Worker loop
+        void run(unsigned self);
+};
+
+#endif // WORKSTEALINGPOOL_H
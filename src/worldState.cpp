@@ -0,0 +1,148 @@
+/*====================================== worldState.cpp ======================================
+  Project: TTRPG Game ?
+  Subsystem: World Snapshots (Quicksave, Quickload and Rewind)
+  Primary Author: Edwin Baiden
+  Description: Implementation of the world snapshots (see worldState.h).
+*/
+#include "worldState.h"
+
+namespace {
+    void captureCombatant(const Character& c, CombatantState& out)
+    {
+        out.archetype = c.archetype;
+        out.att = c.att;
+        out.def = c.def;
+        out.cbt = c.cbt;
+        out.vit = c.vit;
+        out.statEff = c.statEff;
+        out.wep = c.wep;
+    }
+
+    void applyCombatant(const CombatantState& s, Character& c)
+    {
+        c.att = s.att;
+        c.def = s.def;
+        c.cbt = s.cbt;
+        c.vit = s.vit;
+        c.statEff = s.statEff;
+        c.wep = s.wep;
+    }
+}
+
+void captureWorldState(Character** ent, int currentSceneIndex, int activeEncounterID, int savedPlayerSceneIndex,
+    const std::map<int,bool>& battleWon, const ItemSet& collectedItems, const CombatHandler* combat, WorldState& out)
+{
+    out = WorldState{};
+    out.currentSceneIndex = (std::int16_t)currentSceneIndex;
+    out.activeEncounterID = (std::int16_t)activeEncounterID;
+    out.savedPlayerSceneIndex = (std::int16_t)savedPlayerSceneIndex;
+    out.collectedItems = (std::uint32_t)collectedItems.to_ulong();
+    for (const auto& [encounterID, won] : battleWon)
+    {
+        if (encounterID < 0 || encounterID >= SAVE_MAX_ENCOUNTERS) continue;
+        out.battlesFought |= 1u << encounterID;
+        if (won) out.battlesWon |= 1u << encounterID;
+    }
+
+    const PlayerCharacter* player = asPlayer(ent[0]);
+    if (player)
+    {
+        captureCombatant(*player, out.player);
+        out.zombiesDefeated = (std::uint8_t)(player->zombie1Defeated | player->zombie2Defeated << 1 | player->zombie3Defeated << 2);
+        for (const Item& item : player->getInventory().getItems())
+        {
+            if (out.itemCount == SAVE_MAX_ITEMS) break;
+            out.items[out.itemCount++] = {(std::uint8_t)item.id, item.quantity, item.healAmount};
+        }
+    }
+
+    if (combat && ent[1])
+    {
+        out.inCombat = true;
+        captureCombatant(*ent[1], out.enemy);
+        out.fightSeed = combat->journal.header().seed;
+        out.journalEvents = combat->journal.size();
+        out.rng = rng_state();
+        out.playerTurn = combat->playerTurn;
+        out.playerIsDefending = combat->playerIsDefending;
+        out.enemyIsDefending = combat->enemyIsDefending;
+        out.enemyActionDelay = combat->enemyActionDelay;
+    }
+}
+
+bool applyWorldState(const WorldState& state, Character** ent, int& currentSceneIndex, int& activeEncounterID,
+    int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems, CombatHandler* combat)
+{
+    PlayerCharacter* player = asPlayer(ent[0]);
+    if (!player || player->archetype != state.player.archetype) return false;
+    if (state.inCombat && (!combat || !ent[1] || combat->journal.header().seed != state.fightSeed)) return false; // another fight
+
+    applyCombatant(state.player, *player);
+    player->zombie1Defeated = (state.zombiesDefeated & 1) != 0;
+    player->zombie2Defeated = (state.zombiesDefeated & 2) != 0;
+    player->zombie3Defeated = (state.zombiesDefeated & 4) != 0;
+    player->getInventory().clearItems();
+    for (int i = 0; i < state.itemCount; ++i)
+    {
+        Item item;
+        item.id = (ItemID)state.items[i].id;
+        item.quantity = state.items[i].quantity;
+        item.healAmount = state.items[i].healAmount;
+        player->getInventory().additem(item);
+    }
+
+    currentSceneIndex = state.currentSceneIndex;
+    activeEncounterID = state.activeEncounterID;
+    savedPlayerSceneIndex = state.savedPlayerSceneIndex;
+    collectedItems = ItemSet(state.collectedItems);
+    battleWon.clear();
+    for (int id = 0; id < SAVE_MAX_ENCOUNTERS; ++id)
+    {
+        if ((state.battlesFought >> id) & 1) battleWon[id] = ((state.battlesWon >> id) & 1) != 0;
+    }
+
+    if (state.inCombat)
+    {
+        applyCombatant(state.enemy, *ent[1]);
+        combat->journal.truncate(state.journalEvents);
+        restore_rng(state.rng);
+        combat->playerTurn = state.playerTurn;
+        combat->playerIsDefending = state.playerIsDefending;
+        combat->enemyIsDefending = state.enemyIsDefending;
+        combat->enemyActionDelay = state.enemyActionDelay;
+        // whatever the undone turn ended in is gone too
+        combat->gameOverState = false;
+        combat->victoryState = false;
+        combat->gameOverTimer = 0.0f;
+        combat->showAttackMenu = false;
+        combat->showItemMenu = false;
+    }
+    return true;
+}
+
+void WorldHistory::push(const WorldState& state)
+{
+    ring[head] = state;
+    head = (head + 1) % WORLD_HISTORY_CAPACITY;
+    if (count < WORLD_HISTORY_CAPACITY) ++count;
+}
+
+void WorldHistory::dropCombat()
+{
+    while (count > 0 && back().inCombat)
+    {
+        head = (head + WORLD_HISTORY_CAPACITY - 1) % WORLD_HISTORY_CAPACITY;
+        --count;
+    }
+}
+
+bool WorldHistory::rewind(bool combat, WorldState& out)
+{
+    if (count < 2 || back().inCombat != combat) return false;
+    const WorldState& previous = ring[(head + WORLD_HISTORY_CAPACITY - 2) % WORLD_HISTORY_CAPACITY];
+    if (previous.inCombat != combat) return false; // first turn of the fight, or first room
+    head = (head + WORLD_HISTORY_CAPACITY - 1) % WORLD_HISTORY_CAPACITY;
+    --count;
+    out = back();
+    return true;
+}
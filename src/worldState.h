@@ -0,0 +1,121 @@
+/*======================================= worldState.h =======================================
+  Project: TTRPG Game ?
+  Subsystem: World Snapshots (Quicksave, Quickload and Rewind)
+  Primary Author: Edwin Baiden
+  Description: The game state lives in file static globals in screenManager.cpp (entities, battleWon,
+               collectedItems, the scene indexes, the CombatHandler...). WorldState copies all of it
+               into one trivially copyable struct of a few hundred bytes, so taking a snapshot is a
+               handful of plain stores and keeping one is a memcpy (no JSON, no allocation).
+
+               What is not in a snapshot: the player's name and class (a snapshot never changes who
+               the player is), the combat log text (an undo adds a line instead of removing some) and
+               anything the screens load themselves (textures, rects).
+
+               WorldHistory is a fixed ring buffer of the last WORLD_HISTORY_CAPACITY snapshots. The
+               screen manager pushes one at every decision point (a new room in exploration, the start
+               of every player turn in combat), so rewinding is "drop the newest, go back to the one
+               before it". Combat snapshots only make sense inside their own fight (the enemy and the
+               dice belong to it), they are dropped when the fight ends.
+*/
+//======================= STANDARD LIBRARY INCLUDES =======================
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <type_traits>
+
+//======================= PROJECT INCLUDES =======================
+#include "characters.h"
+#include "combat.h"
+#include "itemRegistry.h"
+#include "rng.h"
+#include "saveData.h"
+
+//=============== HEADER GUARD ===============
+#ifndef WORLDSTATE_H
+#define WORLDSTATE_H
+
+#define WORLD_HISTORY_CAPACITY 64 // Snapshots kept for rewinding (oldest is overwritten)
+
+//@brief: Everything about one character that can change while playing
+//@version: 1.0
+//@author: Edwin Baiden
+struct CombatantState
+{
+    Archetype archetype;
+    Attributes att;
+    DefenseStats def;
+    CombatStats cbt;
+    VitalStats vit;
+    StatusEffects statEff;
+    Weapons wep;
+};
+
+//@brief: One snapshot of the whole game (exploration or the middle of a fight)
+//@version: 1.0
+//@author: Edwin Baiden
+struct WorldState
+{
+    // world
+    std::int16_t currentSceneIndex;
+    std::int16_t activeEncounterID;
+    std::int16_t savedPlayerSceneIndex;
+    std::uint32_t collectedItems;    // ItemSet bits
+    std::uint32_t battlesFought;     // bit per encounter ID that has a battleWon entry
+    std::uint32_t battlesWon;        // bit per encounter ID the player won
+
+    // player
+    CombatantState player;
+    std::uint8_t zombiesDefeated;    // bit 0..2 = zombie1..3
+    std::uint8_t itemCount;
+    SaveItem items[SAVE_MAX_ITEMS];
+
+    // combat (only filled in when inCombat)
+    bool inCombat;
+    CombatantState enemy;
+    std::uint32_t fightSeed;         // journal seed, tells the fights apart
+    std::uint16_t journalEvents;     // events recorded so far (an undo drops the ones after)
+    RngState rng;                    // where the dice were
+    bool playerTurn;
+    bool playerIsDefending;
+    bool enemyIsDefending;
+    float enemyActionDelay;
+};
+
+static_assert(std::is_trivially_copyable_v<WorldState>, "WorldState is copied with memcpy, keep it plain data");
+
+//@brief: Takes a snapshot of the game state (combat is the running fight, nullptr in exploration)
+void captureWorldState(Character** ent, int currentSceneIndex, int activeEncounterID, int savedPlayerSceneIndex,
+    const std::map<int,bool>& battleWon, const ItemSet& collectedItems, const CombatHandler* combat, WorldState& out);
+
+//@brief: Puts a snapshot back into the game state. Combat snapshots need the same fight to still be running
+//        (same enemy, same journal), the combat handler flags, journal and dice are rewound with it.
+//@return - False if the snapshot does not fit (no player, or a combat snapshot of another fight), nothing is changed then
+bool applyWorldState(const WorldState& state, Character** ent, int& currentSceneIndex, int& activeEncounterID,
+    int& savedPlayerSceneIndex, std::map<int,bool>& battleWon, ItemSet& collectedItems, CombatHandler* combat);
+
+//@brief: Ring buffer of the last WORLD_HISTORY_CAPACITY snapshots (fixed size, never allocates)
+//@version: 1.0
+//@author: Edwin Baiden
+class WorldHistory
+{
+    public:
+        void push(const WorldState& state);      // Newest snapshot, overwrites the oldest when full
+        void clear() { count = 0; }
+        void dropCombat();                       // Removes the snapshots of the fight that just ended
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const WorldState& back() const { return ring[(head + WORLD_HISTORY_CAPACITY - 1) % WORLD_HISTORY_CAPACITY]; }
+
+        //@brief: Goes back one decision point: drops the newest snapshot and copies the one before it into out.
+        //        Both have to be combat snapshots (combat = true) or both exploration ones.
+        //@return - False if there is nothing to go back to
+        bool rewind(bool combat, WorldState& out);
+
+    private:
+        std::array<WorldState, WORLD_HISTORY_CAPACITY> ring{};
+        std::size_t head = 0;   // where the next push goes
+        std::size_t count = 0;
+};
+
+#endif // WORLDSTATE_H